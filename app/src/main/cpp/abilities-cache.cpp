@@ -0,0 +1,268 @@
+// app/src/main/cpp/abilities-cache.cpp
+
+#include "abilities-cache.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <gphoto2/gphoto2-result.h>
+#include <gphoto2/gphoto2-version.h>
+
+#include "camera-session.h"
+#include "native-log.h"
+
+static const unsigned int kAbilitiesMagic = 0x47504142; // "GPAB"
+static const unsigned int kAbilitiesFormat = 1;
+
+static std::string lowerModel(const char *model) {
+    std::string s(model ? model : "");
+    for (char &c: s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+static unsigned long long fnv1a64(const std::string &s) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (unsigned char c: s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+AbilitiesCache &AbilitiesCache::instance() {
+    static AbilitiesCache cache;
+    return cache;
+}
+
+void AbilitiesCache::setDiskDirectory(const std::string &dir) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    diskDir_ = dir;
+}
+
+// 키: libgphoto2 버전 + CAMLIBS (라이브러리 절대경로가 abilities 에 들어가므로)
+std::string AbilitiesCache::diskPath() const {
+    if (diskDir_.empty()) return "";
+    const char **v = gp_library_version(GP_VERSION_SHORT);
+    const char *camlibs = getenv("CAMLIBS");
+    std::string key = std::string((v && v[0]) ? v[0] : "?") + "|" + (camlibs ? camlibs : "");
+
+    char name[64];
+    snprintf(name, sizeof(name), "/abilities_%016llx.bin", fnv1a64(key));
+    return diskDir_ + name;
+}
+
+void AbilitiesCache::preloadAsync() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (state_ != EMPTY) return;
+        state_ = LOADING;
+    }
+    std::thread([this]() {
+        // 락 순서: openMutex -> mutex_
+        std::lock_guard<std::mutex> open(SessionRegistry::instance().openMutex());
+        std::unique_lock<std::mutex> lk(mutex_);
+        loadLocked();
+    }).detach();
+}
+
+// 직접 로드하지 않고 로더 스레드에 맡긴다 (mutex_ 를 잡은 채 openMutex 를 기다리지 않도록)
+void AbilitiesCache::ensureLoaded(std::unique_lock<std::mutex> &lk) {
+    if (state_ == EMPTY) {
+        lk.unlock();
+        preloadAsync();
+        lk.lock();
+    }
+    cv_.wait(lk, [this] { return state_ == READY; });
+}
+
+// mutex_ 를 잡은 상태로 호출, state_ == LOADING
+void AbilitiesCache::loadLocked() {
+    auto t0 = std::chrono::steady_clock::now();
+
+    CameraAbilitiesList *list = nullptr;
+    gp_abilities_list_new(&list);
+
+    const std::string path = diskPath();
+    bool fromDisk = !path.empty() && loadFromDisk(list, path);
+    if (!fromDisk) {
+        gp_abilities_list_reset(list);
+        int ret = gp_abilities_list_load(list, nullptr);
+        if (ret < GP_OK) {
+            LOGE("AbilitiesCache: gp_abilities_list_load 실패 -> %s", gp_result_as_string(ret));
+        } else if (!path.empty()) {
+            saveToDisk(list, path);
+        }
+    }
+
+    if (list_) gp_abilities_list_free(list_);
+    list_ = list;
+    rebuildIndex();
+    state_ = READY;
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    LOGD("AbilitiesCache: %d개 모델 로드 (%s, %lld ms)", gp_abilities_list_count(list_),
+         fromDisk ? "disk" : "camlibs", (long long) ms);
+    cv_.notify_all();
+}
+
+void AbilitiesCache::rebuildIndex() {
+    byModel_.clear();
+    byUsb_.clear();
+    int n = gp_abilities_list_count(list_);
+    byModel_.reserve(n);
+    for (int i = 0; i < n; i++) {
+        CameraAbilities a;
+        if (gp_abilities_list_get_abilities(list_, i, &a) < GP_OK) continue;
+        // gp_abilities_list_lookup_model 과 같이 먼저 나온 항목 우선
+        byModel_.emplace(lowerModel(a.model), i);
+        if (a.usb_vendor > 0 && a.usb_product > 0) {
+            byUsb_.emplace((static_cast<unsigned int>(a.usb_vendor) << 16) |
+                           (static_cast<unsigned int>(a.usb_product) & 0xffff), i);
+        }
+    }
+}
+
+bool AbilitiesCache::lookupModel(const char *model, CameraAbilities &out) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    ensureLoaded(lk);
+    auto it = byModel_.find(lowerModel(model));
+    if (it == byModel_.end()) return false;
+    return gp_abilities_list_get_abilities(list_, it->second, &out) >= GP_OK;
+}
+
+bool AbilitiesCache::findUsbLocked(int vendor, int product, CameraAbilities &out) {
+    auto it = byUsb_.find((static_cast<unsigned int>(vendor) << 16) |
+                          (static_cast<unsigned int>(product) & 0xffff));
+    if (it == byUsb_.end()) return false;
+    return gp_abilities_list_get_abilities(list_, it->second, &out) >= GP_OK;
+}
+
+bool AbilitiesCache::lookupUsb(int vendor, int product, CameraAbilities &out) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    ensureLoaded(lk);
+    return findUsbLocked(vendor, product, out);
+}
+
+bool AbilitiesCache::lookupUsbCached(int vendor, int product, CameraAbilities &out) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (state_ == LOADING) return false;
+    if (state_ == EMPTY) {
+        const std::string path = diskPath();
+        if (path.empty()) return false;
+
+        CameraAbilitiesList *list = nullptr;
+        gp_abilities_list_new(&list);
+        if (!loadFromDisk(list, path)) {
+            gp_abilities_list_free(list);
+            return false;
+        }
+        list_ = list;
+        rebuildIndex();
+        state_ = READY;
+        cv_.notify_all();
+    }
+    return findUsbLocked(vendor, product, out);
+}
+
+int AbilitiesCache::count() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    ensureLoaded(lk);
+    return gp_abilities_list_count(list_);
+}
+
+// ----------------------------------------------------------------------------
+// 디스크 직렬화 (문자열은 길이+내용, 나머지는 int 그대로)
+// ----------------------------------------------------------------------------
+static bool writeString(FILE *fp, const char *s) {
+    unsigned short len = static_cast<unsigned short>(strnlen(s, 1023));
+    return fwrite(&len, sizeof(len), 1, fp) == 1 && fwrite(s, 1, len, fp) == len;
+}
+
+static bool readString(FILE *fp, char *dst, size_t cap) {
+    unsigned short len = 0;
+    if (fread(&len, sizeof(len), 1, fp) != 1 || len >= cap) return false;
+    if (fread(dst, 1, len, fp) != len) return false;
+    dst[len] = '\0';
+    return true;
+}
+
+static bool writeInts(FILE *fp, const CameraAbilities &a) {
+    int v[] = {a.status, a.port, a.operations, a.file_operations, a.folder_operations,
+               a.usb_vendor, a.usb_product, a.usb_class, a.usb_subclass, a.usb_protocol,
+               a.device_type};
+    int speeds = 0;
+    while (speeds < 64 && a.speed[speeds]) speeds++;
+    return fwrite(v, sizeof(v), 1, fp) == 1 &&
+           fwrite(&speeds, sizeof(speeds), 1, fp) == 1 &&
+           fwrite(a.speed, sizeof(int), speeds, fp) == static_cast<size_t>(speeds);
+}
+
+static bool readInts(FILE *fp, CameraAbilities &a) {
+    int v[11];
+    int speeds = 0;
+    if (fread(v, sizeof(v), 1, fp) != 1) return false;
+    if (fread(&speeds, sizeof(speeds), 1, fp) != 1 || speeds < 0 || speeds > 63) return false;
+    if (fread(a.speed, sizeof(int), speeds, fp) != static_cast<size_t>(speeds)) return false;
+    a.status = static_cast<CameraDriverStatus>(v[0]);
+    a.port = static_cast<GPPortType>(v[1]);
+    a.operations = static_cast<CameraOperation>(v[2]);
+    a.file_operations = static_cast<CameraFileOperation>(v[3]);
+    a.folder_operations = static_cast<CameraFolderOperation>(v[4]);
+    a.usb_vendor = v[5];
+    a.usb_product = v[6];
+    a.usb_class = v[7];
+    a.usb_subclass = v[8];
+    a.usb_protocol = v[9];
+    a.device_type = static_cast<GphotoDeviceType>(v[10]);
+    return true;
+}
+
+bool AbilitiesCache::saveToDisk(CameraAbilitiesList *list, const std::string &path) {
+    const std::string tmp = path + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return false;
+
+    int n = gp_abilities_list_count(list);
+    unsigned int header[3] = {kAbilitiesMagic, kAbilitiesFormat, static_cast<unsigned int>(n)};
+    bool ok = fwrite(header, sizeof(header), 1, fp) == 1;
+    for (int i = 0; ok && i < n; i++) {
+        CameraAbilities a;
+        ok = gp_abilities_list_get_abilities(list, i, &a) >= GP_OK &&
+             writeString(fp, a.model) && writeString(fp, a.library) && writeString(fp, a.id) &&
+             writeInts(fp, a);
+    }
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        LOGE("AbilitiesCache: %s 저장 실패", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AbilitiesCache::loadFromDisk(CameraAbilitiesList *list, const std::string &path) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+
+    unsigned int header[3];
+    bool ok = fread(header, sizeof(header), 1, fp) == 1 &&
+              header[0] == kAbilitiesMagic && header[1] == kAbilitiesFormat;
+    for (unsigned int i = 0; ok && i < header[2]; i++) {
+        CameraAbilities a;
+        memset(&a, 0, sizeof(a));
+        ok = readString(fp, a.model, sizeof(a.model)) &&
+             readString(fp, a.library, sizeof(a.library)) &&
+             readString(fp, a.id, sizeof(a.id)) &&
+             readInts(fp, a) &&
+             gp_abilities_list_append(list, a) >= GP_OK;
+    }
+    fclose(fp);
+
+    if (!ok) LOGE("AbilitiesCache: %s 손상 -> camlib 에서 다시 로드", path.c_str());
+    return ok && header[2] > 0;
+}
@@ -0,0 +1,65 @@
+// app/src/main/cpp/abilities-cache.h
+
+#ifndef ABILITIES_CACHE_H
+#define ABILITIES_CACHE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <gphoto2/gphoto2-abilities-list.h>
+#include <gphoto2/gphoto2-context.h>
+
+// ----------------------------------------------------------------------------
+// 프로세스 전역 CameraAbilities 캐시
+//  - gp_abilities_list_load 는 camlib 디렉터리의 모든 드라이버를 dlopen 하므로
+//    한 번만(백그라운드에서) 읽고, 이후 조회는 해시 탐색으로 처리한다.
+//  - 로드는 SessionRegistry::openMutex 를 잡고 해서 autodetect/gp_camera_init 의
+//    드라이버 로딩과 겹치지 않는다.
+//  - libgphoto2 버전 + camlib 경로를 키로 디스크에 직렬화해 다음 실행에서는
+//    드라이버를 하나도 열지 않고 목록을 복원한다.
+// ----------------------------------------------------------------------------
+class AbilitiesCache {
+public:
+    static AbilitiesCache &instance();
+
+    // 직렬화 파일 위치 (앱 filesDir)
+    void setDiskDirectory(const std::string &dir);
+
+    // 백그라운드 스레드에서 로드 시작 (이미 로드됐거나 진행 중이면 무시)
+    void preloadAsync();
+
+    // 로드가 끝날 때까지 기다린 뒤 조회 (모델명은 대소문자 무시).
+    // 로더가 openMutex 를 기다릴 수 있으므로 카메라/세션 락을 잡은 채 부르지 않는다.
+    bool lookupModel(const char *model, CameraAbilities &out);
+    bool lookupUsb(int vendor, int product, CameraAbilities &out);
+    int count();
+
+    // camlib 을 전혀 열지 않는 조회: 이미 로드됐거나 디스크 캐시가 있을 때만 성공
+    // (로드 중이면 기다리지 않고 false)
+    bool lookupUsbCached(int vendor, int product, CameraAbilities &out);
+
+private:
+    AbilitiesCache() = default;
+
+    enum State { EMPTY, LOADING, READY };
+
+    void ensureLoaded(std::unique_lock<std::mutex> &lk);
+    void loadLocked();
+    bool findUsbLocked(int vendor, int product, CameraAbilities &out);
+    bool loadFromDisk(CameraAbilitiesList *list, const std::string &path);
+    bool saveToDisk(CameraAbilitiesList *list, const std::string &path);
+    void rebuildIndex();
+    std::string diskPath() const;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    State state_ = EMPTY;
+    std::string diskDir_;
+    CameraAbilitiesList *list_ = nullptr;
+    std::unordered_map<std::string, int> byModel_;
+    std::unordered_map<unsigned int, int> byUsb_;   // (vendor << 16) | product
+};
+
+#endif // ABILITIES_CACHE_H
@@ -0,0 +1,197 @@
+// app/src/main/cpp/bulk-import.cpp
+
+#include "bulk-import.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "cpu-pool.h"
+#include "native-log.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static long long usBetween(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+}
+
+// ----------------------------------------------------------------------------
+// BulkImportStats
+// ----------------------------------------------------------------------------
+double BulkImportStats::usbMBps() const {
+    return usbUs > 0 ? (double) bytes / (double) usbUs : 0.0;
+}
+
+double BulkImportStats::endToEndMBps() const {
+    return wallUs > 0 ? (double) bytes / (double) wallUs : 0.0;
+}
+
+std::string BulkImportStats::toJson() const {
+    std::ostringstream oss;
+    oss.precision(2);
+    oss << std::fixed << "{\"files\":" << files << ",\"failed\":" << failed
+        << ",\"duplicates\":" << duplicates
+        << ",\"bytes\":" << bytes << ",\"wallUs\":" << wallUs << ",\"usbUs\":" << usbUs
+        << ",\"writeUs\":" << writeUs << ",\"stallUs\":" << stallUs
+        << ",\"peakBufferedBytes\":" << peakBufferedBytes
+        << ",\"usbMBps\":" << usbMBps() << ",\"endToEndMBps\":" << endToEndMBps() << "}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// runBulkImport
+// ----------------------------------------------------------------------------
+namespace {
+
+struct WriteJob {
+    size_t index;
+    CameraFile *file;
+    uint64_t bytes;
+};
+
+struct WriteDone {
+    size_t index;
+    BulkImportResult r;
+    uint64_t bytes;
+};
+
+// 호출 스레드와 CPU 풀 작업이 공유하는 상태
+struct Pipeline {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<WriteDone> done;
+    uint64_t buffered = 0;
+    int inflight = 0;
+    long long writeUs = 0;
+};
+
+// CPU 풀(JOB_HASH)에서 파일 하나를 해시 + 저장
+int writeOne(Pipeline &p, const std::vector<BulkImportItem> &items, WriteJob job) {
+    Clock::time_point t0 = Clock::now();
+    const char *data = nullptr;
+    unsigned long size = 0;
+    BulkImportResult r;
+    r.result = gp_file_get_data_and_size(job.file, &data, &size);
+    if (r.result >= GP_OK) {
+        const BulkImportItem &item = items[job.index];
+        r.bytes = size;
+        r.result = saveContentAddressed(data, size, item.localDir, contentExtension(item.name),
+                                        r.localPath, r.digest, r.duplicate);
+    }
+    gp_file_unref(job.file);
+    long long us = usBetween(t0, Clock::now());
+
+    std::lock_guard<std::mutex> lk(p.mutex);
+    p.buffered -= job.bytes;
+    p.writeUs += us;
+    p.inflight--;
+    p.done.push_back(WriteDone{job.index, r, job.bytes});
+    p.cv.notify_all();
+    return r.result;
+}
+
+} // namespace
+
+int runBulkImport(const std::vector<BulkImportItem> &items, uint64_t budgetBytes,
+                  const BulkFetchFn &fetch, const BulkDoneFn &onDone,
+                  const BulkAbortFn &shouldAbort, const std::atomic_bool &cancel,
+                  BulkImportStats &stats) {
+    stats = BulkImportStats();
+    Clock::time_point start = Clock::now();
+
+    Pipeline p;
+    CpuPool &pool = CpuPool::instance();
+
+    // 쓰기 완료분을 호출 스레드에서 보고
+    auto drain = [&]() {
+        std::deque<WriteDone> done;
+        {
+            std::lock_guard<std::mutex> lk(p.mutex);
+            done.swap(p.done);
+        }
+        for (const WriteDone &d: done) {
+            if (d.r.result >= GP_OK) {
+                stats.files++;
+                stats.bytes += d.bytes;
+                if (d.r.duplicate) stats.duplicates++;
+            } else {
+                stats.failed++;
+                LOGE("bulkImport: %s/%s 쓰기 실패", items[d.index].folder.c_str(),
+                     items[d.index].name.c_str());
+            }
+            if (onDone) onDone(items[d.index], d.r);
+        }
+    };
+
+    int result = GP_OK;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (cancel.load()) {
+            result = GP_ERROR_CANCEL;
+            break;
+        }
+        drain();
+
+        // back-pressure: 쓰기가 밀려 예산을 넘으면 비워질 때까지 대기
+        Clock::time_point waitStart = Clock::now();
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(p.mutex);
+                if (p.buffered == 0 || p.buffered + items[i].sizeHint <= budgetBytes) break;
+                p.cv.wait(lk, [&p] { return !p.done.empty(); });
+            }
+            drain();
+        }
+        stats.stallUs += usBetween(waitStart, Clock::now());
+
+        CameraFile *file;
+        gp_file_new(&file);
+        Clock::time_point t0 = Clock::now();
+        int ret = fetch(items[i], file);
+        stats.usbUs += usBetween(t0, Clock::now());
+
+        const char *data = nullptr;
+        unsigned long size = 0;
+        if (ret >= GP_OK) ret = gp_file_get_data_and_size(file, &data, &size);
+        if (ret < GP_OK) {
+            gp_file_unref(file);
+            stats.failed++;
+            BulkImportResult r;
+            r.result = ret;
+            if (onDone) onDone(items[i], r);
+            if (shouldAbort && shouldAbort(ret)) {
+                result = ret;
+                break;
+            }
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(p.mutex);
+            p.buffered += size;
+            p.inflight++;
+            if (p.buffered > stats.peakBufferedBytes) stats.peakBufferedBytes = p.buffered;
+        }
+        WriteJob job{i, file, size};
+        pool.post(CpuPool::JOB_HASH, [&p, &items, job]() { return writeOne(p, items, job); });
+    }
+
+    // 남은 저장이 끝날 때까지 (완료분은 계속 보고)
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(p.mutex);
+            if (p.inflight == 0 && p.done.empty()) break;
+            p.cv.wait(lk, [&p] { return p.inflight == 0 || !p.done.empty(); });
+        }
+        drain();
+    }
+
+    stats.writeUs = p.writeUs;
+    stats.wallUs = usBetween(start, Clock::now());
+    LOGD("bulkImport: %s", stats.toJson().c_str());
+    return result;
+}
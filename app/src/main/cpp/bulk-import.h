@@ -0,0 +1,74 @@
+// app/src/main/cpp/bulk-import.h
+
+#ifndef BULK_IMPORT_H
+#define BULK_IMPORT_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <gphoto2/gphoto2-file.h>
+
+#include "content-hash.h"
+
+// ----------------------------------------------------------------------------
+// 대량 가져오기 파이프라인
+//  - 호출 스레드: fetch 로 파일 N+1 을 USB 에서 메모리(CameraFile)로 받는다.
+//  - CPU 풀(JOB_HASH): 받은 파일마다 작업 하나로 해시해 localDir/photo_<해시>.<확장자>
+//    로 저장 (tmp + rename). 여러 파일이 big 코어에 나뉘어 동시에 해시된다.
+//    같은 내용이 이미 있으면 쓰지 않고 duplicate 로 보고.
+//  - 메모리에 잡힌(받았지만 아직 못 쓴) 바이트가 budgetBytes 를 넘으면 fetch 를
+//    멈추고 기다린다 (back-pressure). 예산보다 큰 파일 하나는 단독으로 통과.
+//  - 완료 콜백 onDone 은 호출 스레드에서 불린다 (JNI 콜백을 그대로 써도 됨).
+//  - fetch 는 카메라 접근 방식(명령 큐, 직접 호출 ...)을 호출자가 정한다. 그래서
+//    Linux 에서 directory camlib + disk iolib 카메라로도 그대로 돌릴 수 있다.
+// ----------------------------------------------------------------------------
+struct BulkImportItem {
+    std::string folder;
+    std::string name;
+    std::string localDir;
+    uint64_t sizeHint = 0;      // 색인에서 얻은 크기 (0 이면 모름)
+};
+
+// 파일 하나의 결과 (result < GP_OK 면 실패, 나머지는 성공일 때만 의미 있음)
+struct BulkImportResult {
+    int result = 0;
+    std::string localPath;
+    uint64_t bytes = 0;
+    ContentDigest digest;
+    bool duplicate = false;
+};
+
+struct BulkImportStats {
+    int files = 0;
+    int failed = 0;
+    int duplicates = 0;             // files 중 이미 같은 내용이 있어 쓰지 않은 수
+    uint64_t bytes = 0;
+    long long wallUs = 0;           // 시작 ~ 마지막 쓰기 완료
+    long long usbUs = 0;            // fetch 에 걸린 시간 합
+    long long writeUs = 0;          // 해시 + 쓰기 시간 합
+    long long stallUs = 0;          // 예산 초과로 fetch 를 멈춘 시간 합
+    uint64_t peakBufferedBytes = 0;
+
+    double usbMBps() const;         // USB 만의 처리율
+    double endToEndMBps() const;    // 실제 가져오기 처리율 (겹침이 잘 되면 usbMBps 에 근접)
+    std::string toJson() const;
+};
+
+// USB 단계: file 에 내용을 채우고 gPhoto2 결과 코드 반환
+typedef std::function<int(const BulkImportItem &item, CameraFile *file)> BulkFetchFn;
+typedef std::function<void(const BulkImportItem &item, const BulkImportResult &r)> BulkDoneFn;
+// fetch 실패 코드를 보고 남은 파일을 포기할지 (연결 끊김 등)
+typedef std::function<bool(int result)> BulkAbortFn;
+
+// 반환: 끝까지 돌았으면 GP_OK, 취소/중단이면 그 코드
+int runBulkImport(const std::vector<BulkImportItem> &items, uint64_t budgetBytes,
+                  const BulkFetchFn &fetch, const BulkDoneFn &onDone,
+                  const BulkAbortFn &shouldAbort, const std::atomic_bool &cancel,
+                  BulkImportStats &stats);
+
+#define BULK_IMPORT_DEFAULT_BUDGET_MB 64
+
+#endif // BULK_IMPORT_H
@@ -0,0 +1,326 @@
+// app/src/main/cpp/camera-index.cpp
+
+#include "camera-index.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <sstream>
+
+#include <gphoto2/gphoto2-list.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "camera-session.h"
+#include "json-util.h"
+#include "native-log.h"
+
+// ----------------------------------------------------------------------------
+// StringPool
+// ----------------------------------------------------------------------------
+size_t StringPool::Hash::operator()(const char *s) const {
+    size_t h = 2166136261u;
+    for (; *s; s++) {
+        h ^= (unsigned char) *s;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool StringPool::Equal::operator()(const char *a, const char *b) const {
+    return strcmp(a, b) == 0;
+}
+
+uint32_t StringPool::intern(const char *s) {
+    auto it = ids_.find(s);
+    if (it != ids_.end()) return it->second;
+
+    size_t len = strlen(s) + 1;
+    char *dst;
+    if (len > BLOCK_SIZE) {
+        // 블록보다 긴 문자열은 전용 블록에 (카메라 경로에선 사실상 없음), 다음은 새 블록
+        blocks_.emplace_back(new char[len]);
+        dst = blocks_.back().get();
+        used_ = BLOCK_SIZE;
+    } else {
+        if (used_ + len > BLOCK_SIZE) {
+            blocks_.emplace_back(new char[BLOCK_SIZE]);
+            used_ = 0;
+        }
+        dst = blocks_.back().get() + used_;
+        used_ += len;
+    }
+    memcpy(dst, s, len);
+
+    uint32_t id = (uint32_t) ptrs_.size();
+    ptrs_.push_back(dst);
+    ids_.emplace(dst, id);
+    return id;
+}
+
+bool StringPool::find(const char *s, uint32_t &id) const {
+    auto it = ids_.find(s);
+    if (it == ids_.end()) return false;
+    id = it->second;
+    return true;
+}
+
+void StringPool::clear() {
+    ids_.clear();
+    ptrs_.clear();
+    blocks_.clear();
+    used_ = BLOCK_SIZE;
+}
+
+// ----------------------------------------------------------------------------
+// CameraIndex
+// ----------------------------------------------------------------------------
+void CameraIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+    files_.shrink_to_fit();
+    rows_.clear();
+    strings_.clear();
+    complete_ = false;
+}
+
+void CameraIndex::add(const std::vector<Entry> &entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.reserve(files_.size() + entries.size());
+    for (const Entry &e: entries) {
+        File f;
+        f.folder = strings_.intern(e.folder.c_str());
+        f.name = strings_.intern(e.name.c_str());
+        f.type = strings_.intern(e.type.c_str());
+        f.size = e.size;
+        f.mtime = e.mtime;
+        rows_[((uint64_t) f.folder << 32) | f.name] = (uint32_t) files_.size();
+        files_.push_back(f);
+    }
+}
+
+void CameraIndex::setComplete(bool complete) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    complete_ = complete;
+}
+
+size_t CameraIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+bool CameraIndex::complete() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return complete_;
+}
+
+std::vector<CameraIndex::Entry> CameraIndex::snapshot(size_t from, size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry> out;
+    for (size_t i = from; i < files_.size() && i - from < count; i++) {
+        const File &f = files_[i];
+        out.push_back(Entry{strings_.str(f.folder), strings_.str(f.name), strings_.str(f.type),
+                            f.size, f.mtime});
+    }
+    return out;
+}
+
+bool CameraIndex::find(const std::string &folder, const std::string &name, Entry &out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t folderId, nameId;
+    if (!strings_.find(folder.c_str(), folderId) || !strings_.find(name.c_str(), nameId)) {
+        return false;
+    }
+    auto it = rows_.find(((uint64_t) folderId << 32) | nameId);
+    if (it == rows_.end()) return false;
+    const File &f = files_[it->second];
+    out = Entry{strings_.str(f.folder), strings_.str(f.name), strings_.str(f.type), f.size,
+                f.mtime};
+    return true;
+}
+
+std::string CameraIndex::toJson(size_t from, size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = from; i < files_.size() && i - from < count; i++) {
+        const File &f = files_[i];
+        if (i > from) oss << ",";
+        oss << "{\"folder\":\"" << escapeJsonString(strings_.str(f.folder))
+            << "\",\"name\":\"" << escapeJsonString(strings_.str(f.name))
+            << "\",\"size\":" << f.size << ",\"mtime\":" << f.mtime
+            << ",\"type\":\"" << escapeJsonString(strings_.str(f.type)) << "\"}";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+std::string CameraIndex::statsJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "{\"files\":" << files_.size() << ",\"complete\":" << (complete_ ? "true" : "false")
+        << ",\"strings\":" << strings_.count()
+        << ",\"bytes\":" << strings_.bytes() + files_.capacity() * sizeof(File) << "}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// walkCameraFiles
+// ----------------------------------------------------------------------------
+namespace {
+
+// 명령 큐에서 실행할 작업 하나: 폴더 목록 또는 파일 정보 묶음
+struct WalkStep {
+    bool list = true;
+    std::string folder;
+    std::vector<std::string> names;             // 정보 묶음 대상
+
+    std::vector<std::string> subfolders;        // list 결과
+    std::vector<std::string> files;             // list 결과
+    std::vector<CameraIndex::Entry> entries;    // 정보 묶음 결과
+};
+
+std::string joinPath(const std::string &folder, const char *name) {
+    return folder == "/" ? folder + name : folder + "/" + name;
+}
+
+void listInto(CameraList *list, std::vector<std::string> &out) {
+    int n = gp_list_count(list);
+    for (int i = 0; i < n; i++) {
+        const char *name = nullptr;
+        gp_list_get_name(list, i, &name);
+        if (name) out.push_back(name);
+    }
+}
+
+// 세션 mutex 를 작업 하나 동안만 잡는다
+int runStep(CameraSession &s, WalkStep &step) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.camera) return GP_ERROR_CANCEL;     // 세션이 닫힘
+
+    if (step.list) {
+        CameraList *list;
+        gp_list_new(&list);
+        int ret = gp_camera_folder_list_folders(s.camera, step.folder.c_str(), list, s.context);
+        s.connection.noteResult(ret);
+        if (ret >= GP_OK) {
+            std::vector<std::string> names;
+            listInto(list, names);
+            for (const std::string &n: names) {
+                step.subfolders.push_back(joinPath(step.folder, n.c_str()));
+            }
+
+            gp_list_reset(list);
+            ret = gp_camera_folder_list_files(s.camera, step.folder.c_str(), list, s.context);
+            s.connection.noteResult(ret);
+            if (ret >= GP_OK) listInto(list, step.files);
+        }
+        gp_list_free(list);
+        return ret;
+    }
+
+    step.entries.reserve(step.names.size());
+    for (const std::string &name: step.names) {
+        CameraFileInfo info;
+        memset(&info, 0, sizeof(info));
+        int ret = gp_camera_file_get_info(s.camera, step.folder.c_str(), name.c_str(), &info,
+                                          s.context);
+        s.connection.noteResult(ret);
+        if (ret < GP_OK && s.connection.state() == ConnectionState::LOST) return ret;
+
+        // 정보를 못 읽은 파일도 이름은 남긴다 (크기/시각 0)
+        CameraIndex::Entry e{step.folder, name, "", 0, 0};
+        if (ret >= GP_OK) {
+            if (info.file.fields & GP_FILE_INFO_TYPE) e.type = info.file.type;
+            if (info.file.fields & GP_FILE_INFO_SIZE) e.size = info.file.size;
+            if (info.file.fields & GP_FILE_INFO_MTIME) e.mtime = info.file.mtime;
+        }
+        step.entries.push_back(std::move(e));
+    }
+    return GP_OK;
+}
+
+} // namespace
+
+int walkCameraFiles(const std::shared_ptr<CameraSession> &s, CameraIndex &index,
+                    const std::atomic_bool &cancel, const IndexBatchFn &onBatch) {
+    auto start = std::chrono::steady_clock::now();
+
+    typedef std::shared_ptr<WalkStep> StepPtr;
+    std::deque<StepPtr> jobs;
+    std::deque<std::pair<std::future<int>, StepPtr>> inflight;
+
+    StepPtr root = std::make_shared<WalkStep>();
+    root->folder = "/";
+    jobs.push_back(root);
+
+    int result = GP_OK;
+    int folders = 0;
+    bool abort = false;
+    while (!jobs.empty() || !inflight.empty()) {
+        while (!abort && !cancel.load() && inflight.size() < INDEX_PIPELINE_DEPTH &&
+               !jobs.empty()) {
+            StepPtr step = jobs.front();
+            jobs.pop_front();
+            CameraSession *session = s.get();
+            std::future<int> f = s->commands.post(
+                    CommandQueue::PRIORITY_BACKGROUND, [session, step, &cancel]() {
+                        if (cancel.load()) return (int) GP_ERROR_CANCEL;
+                        return runStep(*session, *step);
+                    });
+            inflight.emplace_back(std::move(f), step);
+        }
+        if (inflight.empty()) break;
+
+        int ret = inflight.front().first.get();
+        StepPtr step = inflight.front().second;
+        inflight.pop_front();
+
+        if (abort || cancel.load()) {
+            if (result == GP_OK) result = GP_ERROR_CANCEL;
+            continue;
+        }
+        if (ret < GP_OK) {
+            if (ret == GP_ERROR_CANCEL || s->connection.state() == ConnectionState::LOST) {
+                // 연결이 끊기거나 세션이 닫히면 남은 작업은 버린다
+                result = ret;
+                abort = true;
+                continue;
+            }
+            LOGE("walkCameraFiles[%d]: %s 건너뜀 (%s)", s->handle, step->folder.c_str(),
+                 gp_result_as_string(ret));
+            continue;
+        }
+
+        if (step->list) {
+            folders++;
+            // 이 폴더의 파일 정보를 먼저 (UI 에 빨리 보이도록), 하위 폴더는 뒤로
+            std::vector<StepPtr> chunks;
+            for (size_t i = 0; i < step->files.size(); i += INDEX_INFO_CHUNK) {
+                StepPtr chunk = std::make_shared<WalkStep>();
+                chunk->list = false;
+                chunk->folder = step->folder;
+                size_t end = std::min(step->files.size(), i + INDEX_INFO_CHUNK);
+                chunk->names.assign(step->files.begin() + i, step->files.begin() + end);
+                chunks.push_back(chunk);
+            }
+            for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) jobs.push_front(*it);
+            for (const std::string &sub: step->subfolders) {
+                StepPtr next = std::make_shared<WalkStep>();
+                next->folder = sub;
+                jobs.push_back(next);
+            }
+        } else {
+            size_t from = index.size();
+            index.add(step->entries);
+            if (onBatch) onBatch(from, index.size());
+        }
+    }
+
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    if (result == GP_OK) index.setComplete(true);
+    LOGD("walkCameraFiles[%d]: 폴더 %d, 파일 %zu, %lldms (%s)", s->handle, folders, index.size(),
+         ms, gp_result_as_string(result));
+    return result;
+}
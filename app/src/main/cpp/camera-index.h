@@ -0,0 +1,111 @@
+// app/src/main/cpp/camera-index.h
+
+#ifndef CAMERA_INDEX_H
+#define CAMERA_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// 문자열 인터닝 풀
+//  - 같은 문자열은 한 번만 저장하고 32비트 id 로 가리킨다 (폴더 경로/MIME 은 거의
+//    모든 파일이 공유). 문자열은 64KB 블록에 이어 붙여 파일마다 힙 할당이 없다.
+//  - 블록은 옮기지 않으므로 str() 포인터는 clear() 전까지 유효.
+// ----------------------------------------------------------------------------
+class StringPool {
+public:
+    uint32_t intern(const char *s);
+    bool find(const char *s, uint32_t &id) const;
+    const char *str(uint32_t id) const { return ptrs_[id]; }
+    size_t count() const { return ptrs_.size(); }
+    size_t bytes() const { return blocks_.size() * BLOCK_SIZE; }
+    void clear();
+
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Hash {
+        size_t operator()(const char *s) const;
+    };
+    struct Equal {
+        bool operator()(const char *a, const char *b) const;
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t used_ = BLOCK_SIZE;
+    std::vector<const char *> ptrs_;
+    std::unordered_map<const char *, uint32_t, Hash, Equal> ids_;
+};
+
+// ----------------------------------------------------------------------------
+// 카메라 파일 인덱스 (세션마다 하나, 자체 락 보유)
+//  - 색인 중에도 읽을 수 있다. 파일은 발견 순서대로 뒤에만 붙는다.
+// ----------------------------------------------------------------------------
+class CameraIndex {
+public:
+    struct File {
+        uint32_t folder;
+        uint32_t name;
+        uint32_t type;      // MIME (모르면 "")
+        uint64_t size;
+        int64_t mtime;      // 카메라 시계 기준 epoch 초 (모르면 0)
+    };
+
+    // 풀어 쓴 파일 정보 (JNI/동기화 쪽에 넘길 때)
+    struct Entry {
+        std::string folder;
+        std::string name;
+        std::string type;
+        uint64_t size;
+        int64_t mtime;
+    };
+
+    void clear();
+    void add(const std::vector<Entry> &entries);
+    void setComplete(bool complete);
+
+    size_t size() const;
+    bool complete() const;
+    std::vector<Entry> snapshot(size_t from, size_t count) const;
+    // 폴더/이름으로 한 파일 찾기 (색인에 없으면 false)
+    bool find(const std::string &folder, const std::string &name, Entry &out) const;
+
+    // [from, from+count) 구간 JSON 배열
+    std::string toJson(size_t from, size_t count) const;
+    // 파일 수, 인터닝된 문자열 수, 메모리 사용량
+    std::string statsJson() const;
+
+private:
+    mutable std::mutex mutex_;
+    StringPool strings_;
+    std::vector<File> files_;
+    std::unordered_map<uint64_t, uint32_t> rows_;   // (폴더 id << 32) | 이름 id -> files_ 위치
+    bool complete_ = false;
+};
+
+// ----------------------------------------------------------------------------
+// 카메라 저장소 순회 (파이프라인)
+//  - 폴더 목록 / 파일 정보 묶음(INDEX_INFO_CHUNK 개) 단위 작업을 세션 명령 큐에
+//    PRIORITY_BACKGROUND 로 올린다. 촬영 같은 우선 명령은 작업 사이에 끼어든다.
+//  - 최대 INDEX_PIPELINE_DEPTH 개 작업을 미리 올려 두어, 명령 큐 스레드가 다음
+//    폴더를 USB 로 읽는 동안 호출 스레드가 앞 결과를 인덱스에 넣고 onBatch 로
+//    UI 에 흘려보낸다.
+//  - cancel 이 켜지면 남은 작업을 건너뛰고 GP_ERROR_CANCEL.
+// ----------------------------------------------------------------------------
+struct CameraSession;
+
+typedef std::function<void(size_t from, size_t to)> IndexBatchFn;
+
+int walkCameraFiles(const std::shared_ptr<CameraSession> &s, CameraIndex &index,
+                    const std::atomic_bool &cancel, const IndexBatchFn &onBatch);
+
+#define INDEX_INFO_CHUNK 256
+#define INDEX_PIPELINE_DEPTH 3
+
+#endif // CAMERA_INDEX_H
@@ -0,0 +1,135 @@
+// app/src/main/cpp/camera-presets.cpp
+
+#include "camera-presets.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "native-log.h"
+
+// ----------------------------------------------------------------------------
+// 파일 포맷 (줄 단위, 탭 구분)
+//   P<TAB>프리셋이름
+//   V<TAB>위젯이름<TAB>값
+// ----------------------------------------------------------------------------
+void PresetStore::setFile(const std::string &path) {
+    path_ = path;
+}
+
+bool PresetStore::load() {
+    presets_.clear();
+    FILE *fp = fopen(path_.c_str(), "r");
+    if (!fp) return false;
+
+    char line[1024];
+    PresetEntries *current = nullptr;
+    while (fgets(line, sizeof(line), fp)) {
+        std::string l(line);
+        while (!l.empty() && (l.back() == '\n' || l.back() == '\r')) l.pop_back();
+        if (l.size() < 2 || l[1] != '\t') continue;
+
+        if (l[0] == 'P') {
+            current = &presets_[l.substr(2)];
+            current->clear();
+        } else if (l[0] == 'V' && current) {
+            size_t tab = l.find('\t', 2);
+            if (tab == std::string::npos) continue;
+            current->emplace_back(l.substr(2, tab - 2), l.substr(tab + 1));
+        }
+    }
+    fclose(fp);
+    LOGD("PresetStore: %zu개 프리셋 로드", presets_.size());
+    return true;
+}
+
+bool PresetStore::save() const {
+    const std::string tmp = path_ + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "w");
+    if (!fp) {
+        LOGE("PresetStore: %s 열기 실패", tmp.c_str());
+        return false;
+    }
+    for (const auto &p: presets_) {
+        fprintf(fp, "P\t%s\n", p.first.c_str());
+        for (const auto &e: p.second) {
+            fprintf(fp, "V\t%s\t%s\n", e.first.c_str(), e.second.c_str());
+        }
+    }
+    if (fclose(fp) != 0 || rename(tmp.c_str(), path_.c_str()) != 0) {
+        ::remove(tmp.c_str());
+        LOGE("PresetStore: %s 저장 실패", path_.c_str());
+        return false;
+    }
+    return true;
+}
+
+void PresetStore::put(const std::string &name, const PresetEntries &entries) {
+    presets_[name] = entries;
+}
+
+bool PresetStore::remove(const std::string &name) {
+    return presets_.erase(name) > 0;
+}
+
+const PresetEntries *PresetStore::get(const std::string &name) const {
+    auto it = presets_.find(name);
+    return it == presets_.end() ? nullptr : &it->second;
+}
+
+// ----------------------------------------------------------------------------
+// 프리셋 적용 (최소 diff)
+// ----------------------------------------------------------------------------
+static bool sameValue(CameraWidgetType type, const std::string &current, const std::string &wanted) {
+    if (type == GP_WIDGET_RANGE) {
+        return std::fabs(strtof(current.c_str(), nullptr) - strtof(wanted.c_str(), nullptr)) < 1e-4f;
+    }
+    if (type == GP_WIDGET_TOGGLE || type == GP_WIDGET_DATE) {
+        return strtol(current.c_str(), nullptr, 10) == strtol(wanted.c_str(), nullptr, 10);
+    }
+    return current == wanted;
+}
+
+int applyPreset(const PresetEntries &entries, Camera *cam, GPContext *ctx,
+                ConfigSnapshot &snapshot, PresetApplyResult &result) {
+    result = PresetApplyResult();
+    if (!snapshot.fresh()) return GP_ERROR_BAD_PARAMETERS;
+
+    std::vector<CameraWidget *> changed;
+    for (const auto &e: entries) {
+        const WidgetNode *node = snapshot.index().findByName(e.first.c_str());
+        int readonly = 0;
+        if (!node || (gp_widget_get_readonly(node->widget, &readonly) == GP_OK && readonly)) {
+            result.skipped++;
+            continue;
+        }
+
+        // 메모리의 스냅샷과 비교 (USB 왕복 없음)
+        std::string current;
+        if (widgetValueToString(node->widget, current) &&
+            sameValue(node->type, current, e.second)) {
+            result.unchanged++;
+            continue;
+        }
+
+        if (widgetSetValueFromString(node->widget, e.second.c_str()) < GP_OK) {
+            LOGE("applyPreset: %s=%s 설정 실패", e.first.c_str(), e.second.c_str());
+            result.skipped++;
+            continue;
+        }
+        changed.push_back(node->widget);
+    }
+
+    result.changed = static_cast<int>(changed.size());
+    if (changed.empty()) return GP_OK;
+
+    // 변경된 위젯만 changed 플래그가 서 있으므로 드라이버는 그것만 쓴다
+    int ret = gp_camera_set_config(cam, snapshot.root(), ctx);
+    if (ret < GP_OK) {
+        LOGE("applyPreset: gp_camera_set_config 실패 -> %s", gp_result_as_string(ret));
+        snapshot.reset();
+        return ret;
+    }
+    for (CameraWidget *w: changed) gp_widget_set_changed(w, 0);
+    return GP_OK;
+}
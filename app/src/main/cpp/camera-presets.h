@@ -0,0 +1,52 @@
+// app/src/main/cpp/camera-presets.h
+
+#ifndef CAMERA_PRESETS_H
+#define CAMERA_PRESETS_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gphoto2/gphoto2-camera.h>
+#include <gphoto2/gphoto2-context.h>
+
+#include "widget-index.h"
+
+// ----------------------------------------------------------------------------
+// 카메라 설정 프리셋 (위젯 이름 → 값)
+//  - 적용 시 메모리의 config 스냅샷과 비교해 다른 위젯만 바꾸고
+//    gp_camera_set_config 한 번으로 묶어서 전송한다 (바뀐 게 없으면 USB 왕복 없음).
+//  - 스냅샷은 설정 변경 이벤트/촬영/재연결 때 낡음으로 표시되고, 호출자는 그때만
+//    gp_camera_get_config 한 번으로 다시 읽는다 (ConfigSnapshot::fresh).
+// ----------------------------------------------------------------------------
+typedef std::vector<std::pair<std::string, std::string>> PresetEntries;
+
+struct PresetApplyResult {
+    int changed = 0;    // 실제로 값을 바꾼 위젯 수
+    int unchanged = 0;  // 이미 같은 값
+    int skipped = 0;    // 없는 위젯 / 읽기 전용 / 값 설정 실패
+};
+
+class PresetStore {
+public:
+    void setFile(const std::string &path);
+    bool load();
+    bool save() const;
+
+    void put(const std::string &name, const PresetEntries &entries);
+    bool remove(const std::string &name);
+    const PresetEntries *get(const std::string &name) const;
+    const std::map<std::string, PresetEntries> &all() const { return presets_; }
+
+private:
+    std::string path_;
+    std::map<std::string, PresetEntries> presets_;
+};
+
+// snapshot 은 fresh() 여야 하며 적용 후에도 새 값을 반영한 채로 유지된다.
+// 카메라 쓰기에 실패하면 snapshot 을 비워 다음에 다시 읽게 한다.
+int applyPreset(const PresetEntries &entries, Camera *cam, GPContext *ctx,
+                ConfigSnapshot &snapshot, PresetApplyResult &result);
+
+#endif // CAMERA_PRESETS_H
@@ -0,0 +1,137 @@
+// app/src/main/cpp/camera-session.cpp
+
+#include "camera-session.h"
+
+#include <gphoto2/gphoto2-result.h>
+
+#include "download-journal.h"
+#include "native-log.h"
+
+// ----------------------------------------------------------------------------
+// CommandQueue
+// ----------------------------------------------------------------------------
+std::future<int> CommandQueue::post(Priority priority, Command cmd) {
+    Item item;
+    item.cmd = std::move(cmd);
+    std::future<int> f = item.result.get_future();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        if (thread_.joinable()) thread_.join();
+        running_ = true;
+        thread_ = std::thread(&CommandQueue::loop, this);
+    }
+    queues_[priority].push_back(std::move(item));
+    cv_.notify_one();
+    return f;
+}
+
+void CommandQueue::stop() {
+    std::deque<Item> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        for (auto &q: queues_) {
+            for (auto &item: q) cancelled.push_back(std::move(item));
+            q.clear();
+        }
+    }
+    cv_.notify_all();
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) thread_.join();
+
+    for (auto &item: cancelled) item.result.set_value(GP_ERROR_CANCEL);
+}
+
+size_t CommandQueue::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (const auto &q: queues_) n += q.size();
+    return n;
+}
+
+void CommandQueue::loop() {
+    for (;;) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return !running_ || !queues_[0].empty() || !queues_[1].empty() ||
+                       !queues_[2].empty();
+            });
+            if (!running_) return;
+
+            for (auto &q: queues_) {
+                if (q.empty()) continue;
+                item = std::move(q.front());
+                q.pop_front();
+                break;
+            }
+        }
+        item.result.set_value(item.cmd ? item.cmd() : GP_ERROR_BAD_PARAMETERS);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// 다운로드 대기열
+// ----------------------------------------------------------------------------
+void queueDownload(CameraSession &s, const CameraFilePath &cfp) {
+    // 먼저 저널에 남겨야 큐에 넣은 직후 죽어도 다음 실행에서 이어받는다
+    if (!s.serial.empty()) DownloadJournal::instance().appendPending(s.serial, cfp.folder, cfp.name);
+    std::lock_guard<std::mutex> lk(s.downloadMtx);
+    s.pendingDownloads.push_back(cfp);
+}
+
+// ----------------------------------------------------------------------------
+// SessionRegistry
+// ----------------------------------------------------------------------------
+SessionRegistry &SessionRegistry::instance() {
+    static SessionRegistry registry;
+    return registry;
+}
+
+SessionRegistry::SessionRegistry() : primary_(std::make_shared<CameraSession>()) {
+    primary_->handle = 0;
+    sessions_[0] = primary_;
+}
+
+std::shared_ptr<CameraSession> SessionRegistry::create(int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sessions_.size() - 1 >= MAX_CAMERA_SESSIONS) {
+        LOGE("SessionRegistry: 세션 한도(%d) 초과", MAX_CAMERA_SESSIONS);
+        return nullptr;
+    }
+
+    auto s = std::make_shared<CameraSession>();
+    s->handle = nextHandle_++;
+    s->fd = fd;
+    sessions_[s->handle] = s;
+    LOGD("SessionRegistry: 세션 %d 생성 (fd=%d)", s->handle, fd);
+    return s;
+}
+
+std::shared_ptr<CameraSession> SessionRegistry::get(int handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(handle);
+    return it != sessions_.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<CameraSession> SessionRegistry::remove(int handle) {
+    if (handle == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(handle);
+    if (it == sessions_.end()) return nullptr;
+
+    std::shared_ptr<CameraSession> s = it->second;
+    sessions_.erase(it);
+    LOGD("SessionRegistry: 세션 %d 제거", handle);
+    return s;
+}
+
+std::vector<std::shared_ptr<CameraSession>> SessionRegistry::all() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<CameraSession>> out;
+    out.reserve(sessions_.size());
+    for (const auto &kv: sessions_) out.push_back(kv.second);
+    return out;
+}
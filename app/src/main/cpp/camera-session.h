@@ -0,0 +1,166 @@
+// app/src/main/cpp/camera-session.h
+
+#ifndef CAMERA_SESSION_H
+#define CAMERA_SESSION_H
+
+#include <jni.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gphoto2/gphoto2-camera.h>
+#include <gphoto2/gphoto2-context.h>
+
+#include "camera-index.h"
+#include "connection-state.h"
+#include "thumbnail-cache.h"
+#include "widget-index.h"
+
+// ----------------------------------------------------------------------------
+// 세션 전용 명령 큐
+//  - 세션마다 작업 스레드 하나가 우선순위(HIGH > NORMAL > BACKGROUND) 순서로
+//    명령을 실행한다. 같은 우선순위 안에서는 FIFO.
+//  - 스레드는 첫 post 때 시작된다. stop() 은 대기 중인 명령을 GP_ERROR_CANCEL 로
+//    끝내고 실행 중인 명령이 끝날 때까지 기다린다.
+// ----------------------------------------------------------------------------
+class CommandQueue {
+public:
+    enum Priority {
+        PRIORITY_HIGH = 0,          // 촬영/트리거
+        PRIORITY_NORMAL = 1,        // 설정, 요약 조회 등
+        PRIORITY_BACKGROUND = 2,    // 썸네일/목록 같은 선읽기
+    };
+    typedef std::function<int()> Command;
+
+    ~CommandQueue() { stop(); }
+
+    std::future<int> post(Priority priority, Command cmd);
+    void stop();
+    size_t pending() const;
+
+private:
+    struct Item {
+        Command cmd;
+        std::promise<int> result;
+    };
+
+    void loop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Item> queues_[3];
+    bool running_ = false;
+    std::thread thread_;
+};
+
+// ----------------------------------------------------------------------------
+// 카메라 하나(USB fd 하나)에 대한 세션
+//  - camera/context 는 세션 mutex 로만 보호하므로 서로 다른 카메라의 프리뷰/촬영/
+//    다운로드는 병렬로 진행된다.
+//  - 이벤트 펌프, 라이브뷰 스레드, 명령 큐를 세션마다 따로 가진다.
+// ----------------------------------------------------------------------------
+struct CameraSession {
+    int handle = 0;
+    int fd = -1;
+    // 연결한 USB 장치 (재연결 때 같은 카메라인지 판단, 0 이면 모름)
+    int usbVendor = 0;
+    int usbProduct = 0;
+    // 카메라 시리얼 (다운로드 저널 키, 요약에 없으면 "모델@vid:pid")
+    std::string serial;
+
+    std::mutex mutex;
+    GPContext *context = nullptr;
+    Camera *camera = nullptr;
+    ConfigSnapshot config;
+    ConnectionState connection;
+    CommandQueue commands;
+
+    // 이벤트 펌프 (GP_EVENT_FILE_ADDED -> 다운로드 -> onPhotoCaptured)
+    //  - pendingDownloads 는 펌프가 내려받을 카메라 파일. 동기 트리거처럼 펌프 밖에서
+    //    FILE_ADDED 를 받은 경우도 여기에 넣어 펌프가 이어서 처리한다.
+    std::atomic_bool eventsRunning{false};
+    std::atomic<int> eventGeneration{0};    // 비동기 정지된 이전 펌프 스레드 구분용
+    std::thread eventThread;
+    jobject eventCallback = nullptr;
+    std::mutex eventCvMtx;
+    std::condition_variable eventCv;
+    std::mutex downloadMtx;
+    std::deque<CameraFilePath> pendingDownloads;
+
+    // 라이브뷰 (onLiveViewFrame / onLivePhotoCaptured)
+    std::atomic_bool liveViewRunning{false};
+    std::thread liveViewThread;
+    jobject liveViewCallback = nullptr;
+    std::atomic_bool captureRequested{false};
+
+    // 카메라 파일 인덱스 (startCameraIndex 가 명령 큐 BACKGROUND 작업으로 채운다)
+    CameraIndex fileIndex;
+    std::thread indexThread;
+    std::atomic_bool indexing{false};
+    std::atomic_bool indexCancel{false};
+    std::atomic<int> importBudgetMb{64};    // 가져오기 파이프라인 메모리 상한
+
+    // 썸네일 선읽기 (onThumbnail / onThumbnailFailed)
+    ThumbnailPrefetcher thumbs;
+    std::thread thumbThread;
+    std::atomic_bool thumbsRunning{false};
+
+    // 재연결 (연결이 끊기면 suspend: 스레드를 멈추고 카메라를 놓되 콜백, 대기 중인
+    // 다운로드, config 스냅샷은 남겨 두었다가 같은 장치가 다시 붙으면 복원)
+    //  - 펌프 시작/정지와 suspend/resume 은 lifecycle 로 직렬화 (순서: lifecycle -> mutex)
+    std::mutex lifecycle;
+    std::atomic_bool suspended{false};
+    bool restoreLiveView = false;
+    bool restoreEvents = false;
+    std::atomic<int> reconnects{0};
+};
+
+// pendingDownloads 뒤에 넣고 다운로드 저널에 PENDING 기록 (downloadMtx 를 잡지 않은 상태)
+void queueDownload(CameraSession &s, const CameraFilePath &cfp);
+
+// ----------------------------------------------------------------------------
+// 세션 레지스트리 (Java 에는 정수 핸들로만 노출)
+//  - 핸들 0 은 기존 단일 카메라 API(initCameraWithFd, startLiveView ...)가 쓰는
+//    기본 세션으로 항상 존재한다. 추가 세션은 1부터 발급.
+// ----------------------------------------------------------------------------
+class SessionRegistry {
+public:
+    static SessionRegistry &instance();
+
+    CameraSession &primary() { return *primary_; }
+
+    // 새 세션 등록 (열린 추가 세션이 MAX_CAMERA_SESSIONS 개면 nullptr)
+    std::shared_ptr<CameraSession> create(int fd);
+    std::shared_ptr<CameraSession> get(int handle) const;
+    // 레지스트리에서 떼어내 돌려준다 (스레드 정리/해제는 호출자 몫, 핸들 0 은 불가)
+    std::shared_ptr<CameraSession> remove(int handle);
+    std::vector<std::shared_ptr<CameraSession>> all() const;
+
+    // gp_port_usb_set_sys_device 는 프로세스 전역 값이라
+    // set_sys_device ~ gp_camera_init 구간은 세션 간에 이 락으로 직렬화한다.
+    // libltdl 로 드라이버를 여는 호출(autodetect, 포트/abilities 목록 로드)도 스레드 안전하지
+    // 않아 같은 락을 쓴다. (순서: openMutex -> 세션 mutex -> AbilitiesCache)
+    std::mutex &openMutex() { return openMutex_; }
+
+private:
+    SessionRegistry();
+
+    mutable std::mutex mutex_;
+    std::map<int, std::shared_ptr<CameraSession>> sessions_;
+    std::shared_ptr<CameraSession> primary_;
+    int nextHandle_ = 1;
+    std::mutex openMutex_;
+};
+
+// 기본 세션 외에 동시에 열 수 있는 카메라 수
+#define MAX_CAMERA_SESSIONS 4
+
+#endif // CAMERA_SESSION_H
@@ -0,0 +1,136 @@
+// app/src/main/cpp/camlib-select.cpp
+
+#include "camlib-select.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <gphoto2/gphoto2-result.h>
+
+#include "abilities-cache.h"
+#include "native-log.h"
+
+static const char *kCamlibPrefix = "libgphoto2_camlib_";
+
+// PTP 가 아닌 구형 바디용 제조사별 전용 드라이버
+static const char *vendorCamlib(int vendor) {
+    switch (vendor) {
+        case 0x04a9:
+            return "canon";     // Canon PowerShot (비 PTP 모드)
+        case 0x07b4:
+        case 0x0553:
+            return "sierra";    // Olympus 등
+        case 0x0a17:
+            return "pentax";
+        default:
+            return nullptr;
+    }
+}
+
+// workDir/camlib_<name>/ 에 해당 드라이버 심볼릭 링크 하나만 둔다
+static bool prepareSingleCamlibDir(const std::string &libDir, const std::string &workDir,
+                                   const char *name, std::string &dirOut) {
+    const std::string file = std::string(kCamlibPrefix) + name + ".so";
+    const std::string target = libDir + "/" + file;
+    if (access(target.c_str(), R_OK) != 0) return false;
+
+    dirOut = workDir + "/camlib_" + name;
+    mkdir(dirOut.c_str(), 0700);
+
+    const std::string link = dirOut + "/" + file;
+    char current[1024];
+    ssize_t n = readlink(link.c_str(), current, sizeof(current) - 1);
+    if (n >= 0) {
+        current[n] = '\0';
+        if (target == current) return true;
+        unlink(link.c_str());   // 앱 업데이트로 nativeLibraryDir 가 바뀐 경우
+    }
+    if (symlink(target.c_str(), link.c_str()) != 0) {
+        LOGE("camlib-select: symlink %s 실패 (%s)", link.c_str(), strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool lookupInCamlib(const std::string &libDir, const std::string &workDir,
+                           const char *name, int vendor, int product, int usbClass,
+                           CameraAbilities &out) {
+    std::string dir;
+    if (!prepareSingleCamlibDir(libDir, workDir, name, dir)) return false;
+
+    CameraAbilitiesList *list = nullptr;
+    gp_abilities_list_new(&list);
+    int ret = gp_abilities_list_load_dir(list, dir.c_str(), nullptr);
+    if (ret < GP_OK) {
+        LOGE("camlib-select: %s 로드 실패 -> %s", name, gp_result_as_string(ret));
+        gp_abilities_list_free(list);
+        return false;
+    }
+
+    // VID/PID 정확히 일치 > 같은 USB 클래스의 범용 항목(예: "USB PTP Class Camera")
+    bool found = false;
+    int n = gp_abilities_list_count(list);
+    for (int i = 0; i < n && !found; i++) {
+        CameraAbilities a;
+        if (gp_abilities_list_get_abilities(list, i, &a) < GP_OK) continue;
+        if (a.usb_vendor == vendor && a.usb_product == product) {
+            out = a;
+            found = true;
+        }
+    }
+    for (int i = 0; i < n && !found && usbClass > 0; i++) {
+        CameraAbilities a;
+        if (gp_abilities_list_get_abilities(list, i, &a) < GP_OK) continue;
+        if (a.usb_class == usbClass && a.usb_vendor == 0 && a.usb_product == 0) {
+            out = a;
+            found = true;
+        }
+    }
+    gp_abilities_list_free(list);
+    return found;
+}
+
+bool resolveUsbAbilities(const std::string &libDir, const std::string &workDir,
+                         int vendor, int product, int usbClass, CameraAbilities &out) {
+    if (AbilitiesCache::instance().lookupUsbCached(vendor, product, out)) {
+        LOGD("camlib-select: 캐시 적중 %04x:%04x -> %s", vendor, product, out.model);
+        return true;
+    }
+
+    std::vector<const char *> candidates;
+    if (usbClass == USB_CLASS_STILL_IMAGE) candidates.push_back("ptp2");
+    if (const char *v = vendorCamlib(vendor)) candidates.push_back(v);
+    if (usbClass != USB_CLASS_STILL_IMAGE) candidates.push_back("ptp2");
+
+    for (const char *name: candidates) {
+        if (lookupInCamlib(libDir, workDir, name, vendor, product, usbClass, out)) {
+            LOGD("camlib-select: %s 에서 %04x:%04x -> %s", name, vendor, product, out.model);
+            return true;
+        }
+    }
+    return false;
+}
+
+int findUsbPortInfo(GPPortInfoList *list, GPPortInfo *info) {
+    int count = gp_port_info_list_count(list);
+    for (int i = 0; i < count; i++) {
+        GPPortInfo pi;
+        GPPortType type;
+        char *name = nullptr;
+        if (gp_port_info_list_get_info(list, i, &pi) < GP_OK) continue;
+        if (gp_port_info_get_type(pi, &type) < GP_OK || type != GP_PORT_USB) continue;
+        gp_port_info_get_name(pi, &name);
+        // 이름이 비어있는 항목은 범용 "usb:" - 실제 장치 항목을 우선
+        if (name && name[0]) {
+            *info = pi;
+            return GP_OK;
+        }
+    }
+
+    int idx = gp_port_info_list_lookup_path(list, "usb:");
+    if (idx < GP_OK) return idx;
+    return gp_port_info_list_get_info(list, idx, info);
+}
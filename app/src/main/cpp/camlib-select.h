@@ -0,0 +1,27 @@
+// app/src/main/cpp/camlib-select.h
+
+#ifndef CAMLIB_SELECT_H
+#define CAMLIB_SELECT_H
+
+#include <string>
+
+#include <gphoto2/gphoto2-abilities-list.h>
+#include <gphoto2/gphoto2-port-info-list.h>
+
+// ----------------------------------------------------------------------------
+// Android UsbDevice 의 VID/PID/클래스로 camlib 하나만 골라 abilities 확정
+//  - autodetect(전체 camlib 스캔) 없이 gp_camera_set_abilities 에 넘길 값을 만든다.
+//  - 1) 전역 abilities 캐시(디스크 포함)에 VID/PID 가 있으면 그대로 사용
+//    2) 없으면 후보 드라이버(PTP 클래스면 ptp2)만 들어있는 디렉터리를 만들어
+//       gp_abilities_list_load_dir 로 그 드라이버만 로드
+// ----------------------------------------------------------------------------
+#define USB_CLASS_STILL_IMAGE 6
+
+bool resolveUsbAbilities(const std::string &libDir, const std::string &workDir,
+                         int vendor, int product, int usbClass, CameraAbilities &out);
+
+// sys device 로 잡힌 USB 포트 정보 (없으면 범용 "usb:" 항목)
+// 반환된 info 는 list 가 해제되기 전까지만 유효
+int findUsbPortInfo(GPPortInfoList *list, GPPortInfo *info);
+
+#endif // CAMLIB_SELECT_H
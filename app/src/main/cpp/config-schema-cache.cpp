@@ -0,0 +1,119 @@
+// app/src/main/cpp/config-schema-cache.cpp
+
+#include "config-schema-cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "native-log.h"
+
+// 캐시 포맷 버전 - 스키마 JSON 구조가 바뀌면 올린다
+static const char *kSchemaHeader = "#gphoto2-schema v1 ";
+
+static unsigned long long fnv1a64(const char *data, size_t len) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void ConfigSchemaCache::setDirectory(const std::string &baseDir) {
+    dir_ = baseDir + "/config_schema";
+    mkdir(dir_.c_str(), 0700);
+}
+
+std::string ConfigSchemaCache::parseFirmware(const char *summary) {
+    if (!summary) return "";
+
+    // ptp2: "Device Version: 1.10" / 그 외 드라이버는 "Firmware" 가 들어간 줄
+    static const char *keys[] = {"Device Version:", "Firmware Version:", "Firmware:"};
+    for (const char *k: keys) {
+        const char *p = strstr(summary, k);
+        if (!p) continue;
+        p += strlen(k);
+        while (*p == ' ' || *p == '\t') p++;
+        const char *end = p;
+        while (*end && *end != '\n' && *end != '\r') end++;
+        return std::string(p, end - p);
+    }
+    return "";
+}
+
+void ConfigSchemaCache::setKey(const CameraAbilities &abilities, const char *summary) {
+    char ids[32];
+    snprintf(ids, sizeof(ids), "%04x:%04x", abilities.usb_vendor, abilities.usb_product);
+
+    key_ = std::string(abilities.model) + "|" + ids + "|" + parseFirmware(summary);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", fnv1a64(key_.data(), key_.size()));
+    keyHash_ = name;
+    storedHash_ = 0;
+    LOGD("ConfigSchemaCache: key=%s -> %s", key_.c_str(), keyHash_.c_str());
+}
+
+void ConfigSchemaCache::clearKey() {
+    key_.clear();
+    keyHash_.clear();
+    storedHash_ = 0;
+}
+
+std::string ConfigSchemaCache::filePath() const {
+    return dir_ + "/schema_" + keyHash_ + ".json";
+}
+
+bool ConfigSchemaCache::load(std::string &json) {
+    if (dir_.empty() || key_.empty()) return false;
+
+    FILE *fp = fopen(filePath().c_str(), "rb");
+    if (!fp) return false;
+
+    std::string content;
+    char buf[16 * 1024];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) content.append(buf, n);
+    fclose(fp);
+
+    // 첫 줄: 헤더 + 원본 키 (해시 충돌/포맷 변경 방지)
+    size_t nl = content.find('\n');
+    if (nl == std::string::npos) return false;
+    if (content.compare(0, nl, std::string(kSchemaHeader) + key_) != 0) {
+        LOGD("ConfigSchemaCache: 키 불일치 -> 무시");
+        return false;
+    }
+
+    json = content.substr(nl + 1);
+    storedHash_ = fnv1a64(json.data(), json.size());
+    return !json.empty();
+}
+
+bool ConfigSchemaCache::store(const std::string &json) {
+    if (dir_.empty() || key_.empty() || json.empty()) return false;
+
+    unsigned long long h = fnv1a64(json.data(), json.size());
+    if (h == storedHash_) return true;
+
+    // 임시 파일에 쓰고 rename - 쓰다 죽어도 이전 캐시는 온전히 남는다
+    const std::string path = filePath();
+    const std::string tmp = path + ".tmp";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) {
+        LOGE("ConfigSchemaCache: %s 열기 실패", tmp.c_str());
+        return false;
+    }
+    bool ok = fprintf(fp, "%s%s\n", kSchemaHeader, key_.c_str()) > 0 &&
+              fwrite(json.data(), 1, json.size(), fp) == json.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        LOGE("ConfigSchemaCache: %s 저장 실패", path.c_str());
+        return false;
+    }
+
+    storedHash_ = h;
+    LOGD("ConfigSchemaCache: 스키마 저장 (%zu bytes)", json.size());
+    return true;
+}
@@ -0,0 +1,42 @@
+// app/src/main/cpp/config-schema-cache.h
+
+#ifndef CONFIG_SCHEMA_CACHE_H
+#define CONFIG_SCHEMA_CACHE_H
+
+#include <string>
+
+#include <gphoto2/gphoto2-abilities-list.h>
+
+// ----------------------------------------------------------------------------
+// 기종별 config 스키마(위젯 이름/타입/선택지, 현재값 제외) 디스크 캐시
+//  - 키: CameraAbilities.model + USB VID/PID + summary 의 펌웨어 문자열
+//  - 재연결 시 gp_camera_get_config 를 기다리지 않고 설정 UI 를 바로 그리기 위함
+// ----------------------------------------------------------------------------
+class ConfigSchemaCache {
+public:
+    // 캐시 파일을 둘 디렉터리 (앱 filesDir 아래 config_schema/)
+    void setDirectory(const std::string &baseDir);
+
+    // 연결된 카메라 기준으로 키 설정. summary 는 gp_camera_get_summary 결과 텍스트
+    void setKey(const CameraAbilities &abilities, const char *summary);
+    void clearKey();
+    bool hasKey() const { return !key_.empty(); }
+
+    // 캐시된 스키마 JSON 읽기/쓰기 (같은 내용이면 쓰기 생략)
+    bool load(std::string &json);
+    bool store(const std::string &json);
+    // 지금 키로 이미 읽었거나 썼는지 (키가 바뀌면 false)
+    bool hasStored() const { return storedHash_ != 0; }
+
+    static std::string parseFirmware(const char *summary);
+
+private:
+    std::string filePath() const;
+
+    std::string dir_;
+    std::string key_;       // 사람이 읽을 수 있는 원본 키 (헤더 줄에 기록)
+    std::string keyHash_;   // 파일명
+    unsigned long long storedHash_ = 0;
+};
+
+#endif // CONFIG_SCHEMA_CACHE_H
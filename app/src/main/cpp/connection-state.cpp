@@ -0,0 +1,109 @@
+// app/src/main/cpp/connection-state.cpp
+
+#include "connection-state.h"
+
+#include <sstream>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "native-log.h"
+
+static const char *stateName(int s) {
+    switch (s) {
+        case ConnectionState::CONNECTED:
+            return "CONNECTED";
+        case ConnectionState::DEGRADED:
+            return "DEGRADED";
+        case ConnectionState::LOST:
+            return "LOST";
+        default:
+            return "DISCONNECTED";
+    }
+}
+
+long long ConnectionState::nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now().time_since_epoch()).count();
+}
+
+bool ConnectionState::isDeviceGone(int result) {
+    return result == GP_ERROR_IO_USB_FIND || result == GP_ERROR_IO_INIT ||
+           result == GP_ERROR_MODEL_NOT_FOUND;
+}
+
+bool ConnectionState::isIoError(int result) {
+    switch (result) {
+        case GP_ERROR_IO:
+        case GP_ERROR_IO_READ:
+        case GP_ERROR_IO_WRITE:
+        case GP_ERROR_IO_UPDATE:
+        case GP_ERROR_IO_USB_CLEAR_HALT:
+        case GP_ERROR_IO_USB_CLAIM:
+        case GP_ERROR_TIMEOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ConnectionState::onOpened(const std::string &description) {
+    {
+        std::lock_guard<std::mutex> lk(descMutex_);
+        description_ = description;
+    }
+    consecutiveErrors_.store(0);
+    lastError_.store(0);
+    lastOkMs_.store(nowMs());
+    state_.store(CONNECTED);
+}
+
+void ConnectionState::onClosed() {
+    state_.store(DISCONNECTED);
+    consecutiveErrors_.store(0);
+}
+
+void ConnectionState::noteResult(int result) {
+    int s = state_.load();
+    if (s == DISCONNECTED || s == LOST) return;
+
+    if (result >= 0) {
+        lastOkMs_.store(nowMs());
+        consecutiveErrors_.store(0);
+        if (s != CONNECTED) {
+            state_.store(CONNECTED);
+            LOGD("ConnectionState: %s -> CONNECTED", stateName(s));
+        }
+        return;
+    }
+
+    // 카메라 측 거부(busy, 미지원 등)는 연결 상태와 무관
+    if (!isDeviceGone(result) && !isIoError(result)) return;
+
+    lastError_.store(result);
+    int errors = consecutiveErrors_.fetch_add(1) + 1;
+    int next = (isDeviceGone(result) || errors >= CONNECTION_LOST_AFTER_ERRORS) ? LOST : DEGRADED;
+    if (next != s) {
+        state_.store(next);
+        LOGE("ConnectionState: %s -> %s (err=%d, 연속 %d회)", stateName(s), stateName(next),
+             result, errors);
+    }
+}
+
+long long ConnectionState::idleMs() const {
+    return nowMs() - lastOkMs_.load();
+}
+
+std::string ConnectionState::description() const {
+    std::lock_guard<std::mutex> lk(descMutex_);
+    return description_;
+}
+
+std::string ConnectionState::toJson() const {
+    std::ostringstream oss;
+    oss << "{\"state\":\"" << stateName(state_.load()) << "\""
+        << ",\"idleMs\":" << (state_.load() == DISCONNECTED ? -1 : idleMs())
+        << ",\"consecutiveErrors\":" << consecutiveErrors_.load()
+        << ",\"lastError\":" << lastError_.load() << "}";
+    return oss.str();
+}
@@ -0,0 +1,62 @@
+// app/src/main/cpp/connection-state.h
+
+#ifndef CONNECTION_STATE_H
+#define CONNECTION_STATE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// 카메라 세션 연결 상태
+//  - autodetect 로 매번 포트를 재열거하지 않고, 실제 동작(프리뷰/이벤트/촬영 등)의
+//    결과 코드와 가벼운 주기 probe 결과로 상태를 갱신한다.
+//  - isConnected() 는 원자 변수만 읽으므로 UI 폴링에 써도 USB 를 건드리지 않는다.
+// ----------------------------------------------------------------------------
+class ConnectionState {
+public:
+    enum State {
+        DISCONNECTED = 0,   // 열린 세션 없음
+        CONNECTED = 1,      // 최근 동작 성공
+        DEGRADED = 2,       // IO 에러가 이어지는 중 (아직 끊김 판정 전)
+        LOST = 3,           // 장치가 사라졌거나 연속 실패 - 재연결 필요
+    };
+
+    void onOpened(const std::string &description);
+    void onClosed();
+
+    // gPhoto2 동작 결과 기록 (GP_OK 이상이면 성공)
+    void noteResult(int result);
+
+    State state() const { return static_cast<State>(state_.load()); }
+    bool isConnected() const {
+        int s = state_.load();
+        return s == CONNECTED || s == DEGRADED;
+    }
+
+    // 마지막 성공 이후 경과 시간 - probe 필요 여부 판단용
+    long long idleMs() const;
+    std::string description() const;
+    std::string toJson() const;
+
+    // 장치 분리/전원 꺼짐처럼 재시도해도 소용없는 에러
+    static bool isDeviceGone(int result);
+    // 일시적일 수 있는 IO 계열 에러
+    static bool isIoError(int result);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    static long long nowMs();
+
+    std::atomic<int> state_{DISCONNECTED};
+    std::atomic<long long> lastOkMs_{0};
+    std::atomic<int> consecutiveErrors_{0};
+    std::atomic<int> lastError_{0};
+    mutable std::mutex descMutex_;
+    std::string description_;
+};
+
+#define CONNECTION_LOST_AFTER_ERRORS 3
+
+#endif // CONNECTION_STATE_H
@@ -0,0 +1,412 @@
+// app/src/main/cpp/content-hash.cpp
+
+#include "content-hash.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "native-log.h"
+
+// 핸들러 쓰기를 모아서 write 하는 크기 (PTP 는 보통 이보다 큰 덩어리로 준다)
+#define CONTENT_WRITE_CHUNK (256 * 1024)
+
+static std::atomic_bool sha256Enabled{false};
+static std::atomic<unsigned> partCounter{0};
+
+void setContentSha256Enabled(bool enabled) { sha256Enabled.store(enabled); }
+
+bool contentSha256Enabled() { return sha256Enabled.load(); }
+
+// ----------------------------------------------------------------------------
+// ContentHasher
+// ----------------------------------------------------------------------------
+static const uint64_t P1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t P3 = 0x165667B19E3779F9ULL;
+static const uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static inline uint32_t rotr32(uint32_t x, int r) { return (x >> r) | (x << (32 - r)); }
+
+static inline uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);       // 리틀 엔디언 (arm64 / x86)
+    return v;
+}
+
+static inline uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * P2;
+    acc = rotl64(acc, 31);
+    return acc * P1;
+}
+
+static inline uint64_t xxhMerge(uint64_t acc, uint64_t v) {
+    acc ^= xxhRound(0, v);
+    return acc * P1 + P4;
+}
+
+static const uint32_t SHA_K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+        0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+        0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+        0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+        0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+        0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+        0xc67178f2,
+};
+
+ContentHasher::ContentHasher(bool withSha256) : sha_(withSha256) {
+    v_[0] = P1 + P2;
+    v_[1] = P2;
+    v_[2] = 0;
+    v_[3] = 0 - P1;
+
+    static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(h_, init, sizeof(h_));
+}
+
+void ContentHasher::xxhBlock(const uint8_t *p) {
+    v_[0] = xxhRound(v_[0], read64(p));
+    v_[1] = xxhRound(v_[1], read64(p + 8));
+    v_[2] = xxhRound(v_[2], read64(p + 16));
+    v_[3] = xxhRound(v_[3], read64(p + 24));
+}
+
+void ContentHasher::shaBlock(const uint8_t *p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t) p[i * 4] << 24 | (uint32_t) p[i * 4 + 1] << 16 |
+               (uint32_t) p[i * 4 + 2] << 8 | p[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = h_[0], b = h_[1], c = h_[2], d = h_[3];
+    uint32_t e = h_[4], f = h_[5], g = h_[6], h = h_[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) +
+                      SHA_K[i] + w[i];
+        uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h_[0] += a;
+    h_[1] += b;
+    h_[2] += c;
+    h_[3] += d;
+    h_[4] += e;
+    h_[5] += f;
+    h_[6] += g;
+    h_[7] += h;
+}
+
+void ContentHasher::update(const void *data, size_t len) {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    const uint8_t *end = p + len;
+    total_ += len;
+
+    // XXH64: 32바이트 블록, 남는 꼬리는 mem_ 에 모아 둔다
+    const uint8_t *q = p;
+    if (memSize_ > 0) {
+        size_t take = 32 - memSize_ < len ? 32 - memSize_ : len;
+        memcpy(mem_ + memSize_, q, take);
+        memSize_ += take;
+        q += take;
+        if (memSize_ == 32) {
+            xxhBlock(mem_);
+            memSize_ = 0;
+        }
+    }
+    for (; end - q >= 32; q += 32) xxhBlock(q);
+    if (q < end) {
+        memcpy(mem_ + memSize_, q, end - q);
+        memSize_ += end - q;
+    }
+
+    if (sha_) shaFeed(p, len);
+}
+
+void ContentHasher::shaFeed(const uint8_t *p, size_t len) {
+    const uint8_t *end = p + len;
+    if (shaSize_ > 0) {
+        size_t take = 64 - shaSize_ < len ? 64 - shaSize_ : len;
+        memcpy(shaBuf_ + shaSize_, p, take);
+        shaSize_ += take;
+        p += take;
+        if (shaSize_ == 64) {
+            shaBlock(shaBuf_);
+            shaSize_ = 0;
+        }
+    }
+    for (; end - p >= 64; p += 64) shaBlock(p);
+    if (p < end) {
+        memcpy(shaBuf_ + shaSize_, p, end - p);
+        shaSize_ += end - p;
+    }
+}
+
+ContentDigest ContentHasher::finish() {
+    ContentDigest d;
+
+    uint64_t h;
+    if (total_ >= 32) {
+        h = rotl64(v_[0], 1) + rotl64(v_[1], 7) + rotl64(v_[2], 12) + rotl64(v_[3], 18);
+        for (uint64_t v: v_) h = xxhMerge(h, v);
+    } else {
+        h = P5;
+    }
+    h += total_;
+    const uint8_t *p = mem_;
+    const uint8_t *end = mem_ + memSize_;
+    for (; end - p >= 8; p += 8) {
+        h ^= xxhRound(0, read64(p));
+        h = rotl64(h, 27) * P1 + P4;
+    }
+    if (end - p >= 4) {
+        h ^= (uint64_t) read32(p) * P1;
+        h = rotl64(h, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= *p * P5;
+        h = rotl64(h, 11) * P1;
+    }
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    d.fast = h;
+
+    if (sha_) {
+        uint64_t bits = total_ * 8;
+        uint8_t pad[128] = {0x80};
+        size_t padLen = (shaSize_ < 56 ? 56 : 120) - shaSize_;
+        for (int i = 0; i < 8; i++) pad[padLen + i] = (uint8_t) (bits >> (56 - i * 8));
+        shaFeed(pad, padLen + 8);
+        for (int i = 0; i < 8; i++) {
+            d.sha256[i * 4] = (uint8_t) (h_[i] >> 24);
+            d.sha256[i * 4 + 1] = (uint8_t) (h_[i] >> 16);
+            d.sha256[i * 4 + 2] = (uint8_t) (h_[i] >> 8);
+            d.sha256[i * 4 + 3] = (uint8_t) h_[i];
+        }
+        d.hasSha256 = true;
+    }
+    return d;
+}
+
+std::string ContentDigest::fastHex() const {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long) fast);
+    return buf;
+}
+
+std::string ContentDigest::sha256Hex() const {
+    if (!hasSha256) return std::string();
+    char buf[65];
+    for (int i = 0; i < 32; i++) snprintf(buf + i * 2, 3, "%02x", sha256[i]);
+    return buf;
+}
+
+// ----------------------------------------------------------------------------
+// 내용 주소 저장
+// ----------------------------------------------------------------------------
+std::string contentExtension(const std::string &cameraName) {
+    size_t dot = cameraName.find_last_of('.');
+    if (dot == std::string::npos || dot + 1 >= cameraName.size() || cameraName.size() - dot > 5) {
+        return "jpg";
+    }
+    std::string ext = cameraName.substr(dot + 1);
+    for (char &c: ext) c = (char) tolower((unsigned char) c);
+    return ext;
+}
+
+std::string contentPartPath(const std::string &dir) {
+    char name[48];
+    snprintf(name, sizeof(name), "/.dl_%d_%u.part", (int) getpid(), partCounter.fetch_add(1));
+    return dir + name;
+}
+
+// sha256sum -c 로 바로 검사할 수 있는 형식
+static void writeShaSidecar(const std::string &path, const ContentDigest &digest) {
+    if (!digest.hasSha256) return;
+    const std::string side = path + ".sha256";
+    if (access(side.c_str(), F_OK) == 0) return;
+    FILE *fp = fopen(side.c_str(), "w");
+    if (!fp) return;
+    fprintf(fp, "%s  %s\n", digest.sha256Hex().c_str(),
+            path.substr(path.find_last_of('/') + 1).c_str());
+    fclose(fp);
+}
+
+int commitContentFile(const std::string &partPath, const std::string &dir, const std::string &ext,
+                      const ContentDigest &digest, std::string &outPath, bool &duplicate) {
+    outPath = dir + "/photo_" + digest.fastHex() + "." + ext;
+    struct stat st;
+    duplicate = stat(outPath.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+    if (duplicate) {
+        remove(partPath.c_str());
+    } else if (rename(partPath.c_str(), outPath.c_str()) != 0) {
+        LOGE("contentHash: rename 실패 %s (%s)", outPath.c_str(), strerror(errno));
+        remove(partPath.c_str());
+        return GP_ERROR_IO_WRITE;
+    }
+    writeShaSidecar(outPath, digest);
+    return GP_OK;
+}
+
+static bool writeAll(int fd, const char *data, size_t size) {
+    size_t off = 0;
+    while (off < size) {
+        ssize_t n = write(fd, data + off, size - off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        off += n;
+    }
+    return true;
+}
+
+int saveContentAddressed(const char *data, size_t size, const std::string &dir,
+                         const std::string &ext, std::string &outPath, ContentDigest &digest,
+                         bool &duplicate) {
+    // 메모리 위 해시는 싸다: 먼저 해시해서 중복이면 플래시에 쓰지도 않는다
+    ContentHasher hasher(contentSha256Enabled());
+    hasher.update(data, size);
+    digest = hasher.finish();
+
+    outPath = dir + "/photo_" + digest.fastHex() + "." + ext;
+    struct stat st;
+    if (stat(outPath.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        duplicate = true;
+        writeShaSidecar(outPath, digest);
+        return GP_OK;
+    }
+
+    const std::string part = contentPartPath(dir);
+    int fd = open(part.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return GP_ERROR_IO_WRITE;
+    bool ok = writeAll(fd, data, size);
+    ok = close(fd) == 0 && ok;
+    if (!ok) {
+        remove(part.c_str());
+        return GP_ERROR_IO_WRITE;
+    }
+    return commitContentFile(part, dir, ext, digest, outPath, duplicate);
+}
+
+// ----------------------------------------------------------------------------
+// 스트리밍 다운로드 (CameraFileHandler)
+// ----------------------------------------------------------------------------
+namespace {
+
+struct StreamSink {
+    explicit StreamSink(bool withSha256) : hasher(withSha256) {}
+
+    int fd = -1;
+    ContentHasher hasher;
+    std::vector<char> buf;
+    uint64_t bytes = 0;
+    bool failed = false;
+
+    bool flushBuf() {
+        if (!buf.empty() && !writeAll(fd, buf.data(), buf.size())) failed = true;
+        buf.clear();
+        return !failed;
+    }
+};
+
+int sinkSize(void *, uint64_t *) { return GP_ERROR_NOT_SUPPORTED; }
+
+int sinkRead(void *, unsigned char *, uint64_t *) { return GP_ERROR_NOT_SUPPORTED; }
+
+int sinkWrite(void *priv, unsigned char *data, uint64_t *len) {
+    StreamSink *sink = static_cast<StreamSink *>(priv);
+    if (sink->failed) return GP_ERROR_IO_WRITE;
+
+    // 도착한 덩어리를 바로 해시 (캐시에 있을 때) 한 뒤 모아서 쓴다
+    sink->hasher.update(data, *len);
+    sink->bytes += *len;
+    if (*len >= CONTENT_WRITE_CHUNK) {
+        if (!sink->flushBuf() || !writeAll(sink->fd, (const char *) data, *len)) {
+            sink->failed = true;
+        }
+    } else {
+        sink->buf.insert(sink->buf.end(), data, data + *len);
+        if (sink->buf.size() >= CONTENT_WRITE_CHUNK) sink->flushBuf();
+    }
+    return sink->failed ? GP_ERROR_IO_WRITE : GP_OK;
+}
+
+} // namespace
+
+int downloadContentAddressed(Camera *camera, GPContext *context, const char *folder,
+                             const char *name, CameraFileType type, const std::string &dir,
+                             ContentDownload &out) {
+    out = ContentDownload();
+    const std::string part = contentPartPath(dir);
+
+    StreamSink sink(contentSha256Enabled());
+    sink.buf.reserve(CONTENT_WRITE_CHUNK);
+    sink.fd = open(part.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (sink.fd < 0) {
+        LOGE("contentHash: %s 열기 실패 (%s)", part.c_str(), strerror(errno));
+        out.writeFailed = true;
+        return GP_ERROR_IO_WRITE;
+    }
+
+    CameraFileHandler handler = {sinkSize, sinkRead, sinkWrite};
+    CameraFile *file = nullptr;
+    int ret = gp_file_new_from_handler(&file, &handler, &sink);
+    if (ret >= GP_OK) {
+        ret = gp_camera_file_get(camera, folder, name, type, file, context);
+        gp_file_unref(file);
+    }
+    sink.flushBuf();
+    bool closed = close(sink.fd) == 0;
+    if (sink.failed || !closed) {
+        out.writeFailed = true;
+        ret = GP_ERROR_IO_WRITE;
+    }
+    if (ret < GP_OK) {
+        remove(part.c_str());
+        return ret;
+    }
+
+    out.bytes = sink.bytes;
+    out.digest = sink.hasher.finish();
+    ret = commitContentFile(part, dir, contentExtension(name), out.digest, out.path, out.duplicate);
+    if (ret < GP_OK) out.writeFailed = true;
+    return ret;
+}
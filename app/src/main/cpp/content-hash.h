@@ -0,0 +1,91 @@
+// app/src/main/cpp/content-hash.h
+
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <gphoto2/gphoto2-camera.h>
+
+// ----------------------------------------------------------------------------
+// 내용 해시 / 내용 주소 저장
+//  - 빠른 해시는 XXH64 (시드 0), 보관용 SHA-256 은 설정으로 켠다.
+//  - 둘 다 스트리밍: 카메라에서 바이트가 나오는 대로 update() 하므로 저장한
+//    파일을 다시 읽는 두 번째 패스가 없다.
+//  - 저장 이름은 photo_<XXH64 16자리>.<확장자>. 같은 내용이 이미 있으면 새로
+//    쓰지 않고 기존 경로를 돌려준다 (같은 사진을 다시 가져와도 한 장).
+// ----------------------------------------------------------------------------
+struct ContentDigest {
+    uint64_t fast = 0;
+    bool hasSha256 = false;
+    uint8_t sha256[32] = {};
+
+    std::string fastHex() const;
+    std::string sha256Hex() const;
+};
+
+class ContentHasher {
+public:
+    explicit ContentHasher(bool withSha256);
+
+    void update(const void *data, size_t len);
+    ContentDigest finish();
+
+private:
+    void xxhBlock(const uint8_t *p);
+    void shaBlock(const uint8_t *p);
+    void shaFeed(const uint8_t *p, size_t len);
+
+    // XXH64
+    uint64_t v_[4];
+    uint64_t total_ = 0;
+    uint8_t mem_[32];
+    size_t memSize_ = 0;
+
+    // SHA-256
+    bool sha_;
+    uint32_t h_[8];
+    uint8_t shaBuf_[64];
+    size_t shaSize_ = 0;
+};
+
+// 보관용 SHA-256 계산 여부 (기본 꺼짐). 켜면 저장 파일 옆에 <이름>.sha256 도 남긴다
+void setContentSha256Enabled(bool enabled);
+bool contentSha256Enabled();
+
+// 카메라 파일명에서 소문자 확장자 (없거나 이상하면 "jpg")
+std::string contentExtension(const std::string &cameraName);
+
+// 내려받는 동안 쓸 dir 안의 임시 경로 (.part, 프로세스 안에서 겹치지 않음)
+std::string contentPartPath(const std::string &dir);
+
+// 임시 파일을 dir/photo_<해시>.<ext> 로 확정.
+//  같은 이름의 파일이 이미 있으면 임시 파일을 지우고 duplicate = true.
+//  (이름은 rename 으로만 생기므로 반쯤 쓴 파일은 없다. 크기는 비교하지 않는다:
+//   가져온 뒤 방향 정규화로 내용이 바뀌어도 이름은 카메라 원본의 해시로 남는다)
+int commitContentFile(const std::string &partPath, const std::string &dir, const std::string &ext,
+                      const ContentDigest &digest, std::string &outPath, bool &duplicate);
+
+// 메모리에 있는 내용을 해시해 중복이 아니면 내용 주소 이름으로 저장
+int saveContentAddressed(const char *data, size_t size, const std::string &dir,
+                         const std::string &ext, std::string &outPath, ContentDigest &digest,
+                         bool &duplicate);
+
+struct ContentDownload {
+    std::string path;           // 저장(또는 이미 있던) 파일
+    ContentDigest digest;
+    uint64_t bytes = 0;
+    bool duplicate = false;
+    bool writeFailed = false;   // 실패가 카메라 쪽이 아니라 로컬 쓰기 때문인지
+};
+
+// gp_camera_file_get 을 핸들러 CameraFile 로 받아, 도착하는 대로 해시하며
+// 임시 파일에 쓴 뒤 내용 주소 이름으로 확정한다 (호출자가 카메라 접근을 직렬화).
+// 실패하면 임시 파일은 남기지 않는다.
+int downloadContentAddressed(Camera *camera, GPContext *context, const char *folder,
+                             const char *name, CameraFileType type, const std::string &dir,
+                             ContentDownload &out);
+
+#endif // CONTENT_HASH_H
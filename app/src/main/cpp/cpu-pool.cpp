@@ -0,0 +1,208 @@
+// app/src/main/cpp/cpu-pool.cpp
+
+#include "cpu-pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sched.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <gphoto2/gphoto2-result.h>
+
+#include "native-log.h"
+
+// big 코어 목록: 최대 클럭이 가장 빠른 코어의 70% 이상인 코어 (big + prime)
+static std::vector<int> detectBigCores() {
+    int n = (int) std::thread::hardware_concurrency();
+    if (n <= 0) n = 1;
+
+    std::vector<long> freq(n, 0);
+    long maxFreq = 0;
+    for (int i = 0; i < n; i++) {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", i);
+        FILE *fp = fopen(path, "r");
+        if (!fp) continue;
+        if (fscanf(fp, "%ld", &freq[i]) != 1) freq[i] = 0;
+        fclose(fp);
+        maxFreq = std::max(maxFreq, freq[i]);
+    }
+
+    std::vector<int> cores;
+    for (int i = 0; i < n; i++) {
+        // 클럭을 못 읽으면(x86 호스트, 꺼진 코어 등) 모두 후보
+        if (maxFreq == 0 || freq[i] * 10 >= maxFreq * 7) cores.push_back(i);
+    }
+    if (cores.empty()) cores.push_back(0);
+    return cores;
+}
+
+CpuPool &CpuPool::instance() {
+    static CpuPool pool;
+    return pool;
+}
+
+CpuPool::~CpuPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        epoch_++;
+    }
+    cv_.notify_all();
+    for (auto &w: workers_) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+}
+
+void CpuPool::startLocked() {
+    started_ = true;
+    cores_ = detectBigCores();
+    int n = (int) cores_.size();
+    for (int t = 0; t < JOB_TYPE_COUNT; t++) {
+        if (limit_[t].load() > 0) continue;
+        // 무거운 디코드/인코드는 한 코어를 남겨 둔다
+        bool heavy = t == JOB_THUMBNAIL || t == JOB_ENCODE;
+        limit_[t].store(heavy ? std::max(1, n - 1) : n);
+    }
+    for (int i = 0; i < n; i++) workers_.emplace_back(new Worker());
+    for (int i = 0; i < n; i++) workers_[i]->thread = std::thread(&CpuPool::loop, this, i);
+    LOGD("CpuPool: 작업 스레드 %d 개", n);
+}
+
+std::future<int> CpuPool::post(JobType type, Job job) {
+    Item item;
+    item.type = type;
+    item.job = std::move(job);
+    std::future<int> f = item.result.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            item.result.set_value(GP_ERROR_CANCEL);
+            return f;
+        }
+        if (!started_) startLocked();
+    }
+
+    Worker &w = *workers_[next_.fetch_add(1) % workers_.size()];
+    {
+        std::lock_guard<std::mutex> lk(w.mutex);
+        w.queue.push_back(std::move(item));
+    }
+    queued_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        epoch_++;
+    }
+    cv_.notify_one();
+    return f;
+}
+
+void CpuPool::setLimit(JobType type, int maxConcurrent) {
+    limit_[type].store(std::max(1, maxConcurrent));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        epoch_++;
+    }
+    cv_.notify_all();
+}
+
+int CpuPool::workerCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (int) workers_.size();
+}
+
+// 종류별 상한 안에서 실행 슬롯 하나 확보
+bool CpuPool::reserve(JobType type) {
+    int cur = running_[type].load();
+    while (cur < limit_[type].load()) {
+        if (running_[type].compare_exchange_weak(cur, cur + 1)) return true;
+    }
+    return false;
+}
+
+// 자기 deque 는 앞에서(먼저 들어온 것부터), 훔칠 때는 뒤에서
+bool CpuPool::take(Worker &w, bool own, Item &out) {
+    std::lock_guard<std::mutex> lk(w.mutex);
+    if (own) {
+        for (auto it = w.queue.begin(); it != w.queue.end(); ++it) {
+            if (!reserve(it->type)) continue;
+            out = std::move(*it);
+            w.queue.erase(it);
+            return true;
+        }
+    } else {
+        for (auto it = w.queue.rbegin(); it != w.queue.rend(); ++it) {
+            if (!reserve(it->type)) continue;
+            out = std::move(*it);
+            w.queue.erase(std::next(it).base());
+            return true;
+        }
+    }
+    return false;
+}
+
+void CpuPool::loop(int index) {
+    // affinity/우선순위는 힌트: 실패해도 그대로 돈다
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c: cores_) CPU_SET(c, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+    setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), CPU_POOL_NICE);
+
+    const int n = (int) workers_.size();
+    for (;;) {
+        unsigned long long seen;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            seen = epoch_;
+        }
+
+        Item item;
+        bool got = take(*workers_[index], true, item);
+        for (int k = 1; !got && k < n; k++) {
+            got = take(*workers_[(index + k) % n], false, item);
+            if (got) stolen_.fetch_add(1);
+        }
+
+        if (!got) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this, seen] { return stopping_ || epoch_ != seen; });
+            continue;
+        }
+
+        queued_.fetch_sub(1);
+        int ret = item.job ? item.job() : GP_ERROR_BAD_PARAMETERS;
+        running_[item.type].fetch_sub(1);
+        done_[item.type].fetch_add(1);
+        item.result.set_value(ret);
+
+        // 상한에 걸려 남아 있던 같은 종류 작업을 다른 스레드가 집을 수 있게
+        if (queued_.load() > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                epoch_++;
+            }
+            cv_.notify_all();
+        }
+    }
+}
+
+std::string CpuPool::statsJson() {
+    static const char *names[JOB_TYPE_COUNT] = {"thumbnail", "exif", "hash", "encode"};
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "{\"workers\":" << workers_.size() << ",\"cores\":[";
+    for (size_t i = 0; i < cores_.size(); i++) oss << (i ? "," : "") << cores_[i];
+    oss << "],\"queued\":" << queued_.load() << ",\"stolen\":" << stolen_.load() << ",\"jobs\":{";
+    for (int t = 0; t < JOB_TYPE_COUNT; t++) {
+        oss << (t ? "," : "") << "\"" << names[t] << "\":{\"running\":" << running_[t].load()
+            << ",\"limit\":" << limit_[t].load() << ",\"done\":" << done_[t].load() << "}";
+    }
+    oss << "}}";
+    return oss.str();
+}
@@ -0,0 +1,84 @@
+// app/src/main/cpp/cpu-pool.h
+
+#ifndef CPU_POOL_H
+#define CPU_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 작업 스레드 nice 값 (USB/이벤트 스레드보다 한 단계 양보)
+#define CPU_POOL_NICE 5
+
+// ----------------------------------------------------------------------------
+// 후처리용 CPU 스레드 풀 (프로세스 전역, 첫 post 때 시작)
+//  - 작업 스레드 수는 big 코어 수 (cpuinfo_max_freq 로 little 클러스터를 뺀 것,
+//    알 수 없으면 전체). 각 스레드를 그 코어 집합에 affinity 힌트로 묶는다.
+//  - 스레드마다 deque 를 두고 post 는 돌아가며 넣는다. 자기 deque 가 비면 다른
+//    스레드 deque 의 뒤쪽에서 훔쳐 온다 (work stealing).
+//  - 작업 종류마다 동시 실행 상한이 있어 한 종류가 코어를 다 차지하지 못한다.
+//    상한에 걸린 작업은 deque 에 남아 있다가 같은 종류가 끝나면 다시 집힌다.
+//  - 결과는 CommandQueue 와 같이 std::future<int> (gPhoto2 결과 코드).
+// ----------------------------------------------------------------------------
+class CpuPool {
+public:
+    enum JobType {
+        JOB_THUMBNAIL = 0,
+        JOB_EXIF = 1,
+        JOB_HASH = 2,           // 내용 해시 + 저장
+        JOB_ENCODE = 3,         // 재인코드/변환
+        JOB_TYPE_COUNT = 4,
+    };
+    typedef std::function<int()> Job;
+
+    static CpuPool &instance();
+    ~CpuPool();
+
+    std::future<int> post(JobType type, Job job);
+    void setLimit(JobType type, int maxConcurrent);
+    int workerCount();
+    std::string statsJson();
+
+private:
+    struct Item {
+        JobType type;
+        Job job;
+        std::promise<int> result;
+    };
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Item> queue;
+        std::thread thread;
+    };
+
+    CpuPool() = default;
+
+    void startLocked();
+    void loop(int index);
+    bool take(Worker &w, bool own, Item &out);
+    bool reserve(JobType type);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<int> cores_;            // affinity 힌트
+    bool started_ = false;
+    bool stopping_ = false;
+    unsigned long long epoch_ = 0;      // post/완료마다 증가 (잠든 스레드 깨우기)
+
+    std::atomic<unsigned> next_{0};
+    std::atomic<int> queued_{0};
+    std::atomic<int> running_[JOB_TYPE_COUNT] = {};
+    std::atomic<int> limit_[JOB_TYPE_COUNT] = {};
+    std::atomic<unsigned long long> done_[JOB_TYPE_COUNT] = {};
+    std::atomic<unsigned long long> stolen_{0};
+};
+
+#endif // CPU_POOL_H
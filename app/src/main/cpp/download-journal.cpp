@@ -0,0 +1,284 @@
+// app/src/main/cpp/download-journal.cpp
+
+#include "download-journal.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+#include "native-log.h"
+
+static const unsigned int kJournalMagic = 0x47504a31; // "GPJ1"
+
+// 디스크 레코드 (512 바이트 고정, 리틀엔디안 그대로 기록)
+struct JournalRecord {
+    unsigned int magic;
+    unsigned char state;
+    unsigned char reserved0[3];
+    unsigned long long timeMs;
+    char serial[40];
+    char folder[208];
+    char name[96];
+    char localName[144];
+    unsigned char reserved1[4];
+    unsigned int checksum;      // 앞 508 바이트의 FNV-1a
+};
+static_assert(sizeof(JournalRecord) == 512, "JournalRecord must stay 512 bytes");
+
+static unsigned int fnv1a32(const void *data, size_t len) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool copyField(char *dst, size_t cap, const char *src) {
+    size_t len = src ? strlen(src) : 0;
+    if (len >= cap) return false;
+    memcpy(dst, src ? src : "", len + 1);
+    return true;
+}
+
+static unsigned long long wallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static bool writeFully(int fd, const void *data, size_t len) {
+    const char *p = static_cast<const char *>(data);
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+DownloadJournal &DownloadJournal::instance() {
+    static DownloadJournal journal;
+    return journal;
+}
+
+std::string DownloadJournal::keyOf(const std::string &serial, const char *folder,
+                                   const char *name) {
+    std::string key = serial;
+    key += '\n';
+    key += folder ? folder : "";
+    key += '/';
+    key += name ? name : "";
+    return key;
+}
+
+bool DownloadJournal::open(const std::string &path) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (fd_ >= 0) {
+        if (path == path_) return true;
+        flushLocked();
+        ::close(fd_);
+        fd_ = -1;
+    }
+    path_ = path;
+    pending_.clear();
+    done_ = failed_ = 0;
+
+    // 재생: 온전한 레코드만 순서대로 적용 (잘린 꼬리는 버림)
+    size_t records = 0, torn = 0;
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp) {
+        JournalRecord rec;
+        while (fread(&rec, sizeof(rec), 1, fp) == 1) {
+            if (rec.magic != kJournalMagic ||
+                rec.checksum != fnv1a32(&rec, offsetof(JournalRecord, checksum))) {
+                torn++;
+                continue;
+            }
+            records++;
+            rec.serial[sizeof(rec.serial) - 1] = '\0';
+            rec.folder[sizeof(rec.folder) - 1] = '\0';
+            rec.name[sizeof(rec.name) - 1] = '\0';
+
+            std::string key = keyOf(rec.serial, rec.folder, rec.name);
+            if (rec.state == PENDING) {
+                pending_[key] = Entry{rec.serial, rec.folder, rec.name};
+            } else {
+                pending_.erase(key);
+                if (rec.state == DONE) done_++; else failed_++;
+            }
+        }
+        fclose(fp);
+    }
+
+    // 아직 PENDING 인 것만 남겨 새로 쓰고 이어서 append
+    if (!rewriteLocked(path)) return false;
+    fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd_ < 0) {
+        LOGE("DownloadJournal: %s 열기 실패", path.c_str());
+        return false;
+    }
+    unsynced_ = 0;
+    lastSync_ = std::chrono::steady_clock::now();
+    LOGD("DownloadJournal: 재생 %zu 레코드 (손상 %zu) -> 이어받을 항목 %zu", records, torn,
+         pending_.size());
+    return true;
+}
+
+// 임시 파일에 PENDING 레코드만 쓰고 fsync 후 rename
+bool DownloadJournal::rewriteLocked(const std::string &path) {
+    const std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOGE("DownloadJournal: %s 열기 실패", tmp.c_str());
+        return false;
+    }
+
+    bool ok = true;
+    for (const auto &kv: pending_) {
+        JournalRecord rec;
+        memset(&rec, 0, sizeof(rec));
+        rec.magic = kJournalMagic;
+        rec.state = PENDING;
+        rec.timeMs = wallClockMs();
+        copyField(rec.serial, sizeof(rec.serial), kv.second.serial.c_str());
+        copyField(rec.folder, sizeof(rec.folder), kv.second.folder.c_str());
+        copyField(rec.name, sizeof(rec.name), kv.second.name.c_str());
+        rec.checksum = fnv1a32(&rec, offsetof(JournalRecord, checksum));
+        if (!writeFully(fd, &rec, sizeof(rec))) {
+            ok = false;
+            break;
+        }
+    }
+    ok = fsync(fd) == 0 && ok;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        ::remove(tmp.c_str());
+        LOGE("DownloadJournal: %s 압축 실패", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void DownloadJournal::close() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (fd_ < 0) return;
+    flushLocked();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool DownloadJournal::appendLocked(int state, const std::string &serial, const char *folder,
+                                   const char *name, const char *localName) {
+    if (fd_ < 0) return false;
+
+    JournalRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.magic = kJournalMagic;
+    rec.state = static_cast<unsigned char>(state);
+    rec.timeMs = wallClockMs();
+    if (!copyField(rec.serial, sizeof(rec.serial), serial.c_str()) ||
+        !copyField(rec.folder, sizeof(rec.folder), folder) ||
+        !copyField(rec.name, sizeof(rec.name), name) ||
+        !copyField(rec.localName, sizeof(rec.localName), localName)) {
+        LOGE("DownloadJournal: 경로가 길어 기록 생략 -> %s/%s", folder, name);
+        return false;
+    }
+    rec.checksum = fnv1a32(&rec, offsetof(JournalRecord, checksum));
+
+    // 쓰다 만 레코드(ENOSPC 등)가 중간에 남으면 뒤 레코드가 모두 어긋나 재생에서 버려지므로
+    // 실패하면 마지막 레코드 경계로 잘라낸다
+    off_t end = lseek(fd_, 0, SEEK_END);
+    if (!writeFully(fd_, &rec, sizeof(rec))) {
+        LOGE("DownloadJournal: 기록 실패 (%s)", strerror(errno));
+        if (end >= 0 && ftruncate(fd_, end - end % (off_t) sizeof(rec)) != 0) {
+            LOGE("DownloadJournal: 잘라내기 실패 (%s)", strerror(errno));
+        }
+        return false;
+    }
+
+    unsynced_++;
+    auto now = std::chrono::steady_clock::now();
+    if (unsynced_ >= JOURNAL_FSYNC_BATCH ||
+        now - lastSync_ >= std::chrono::milliseconds(JOURNAL_FSYNC_INTERVAL_MS)) {
+        flushLocked();
+    }
+    return true;
+}
+
+void DownloadJournal::flushLocked() {
+    if (fd_ < 0 || unsynced_ == 0) return;
+    fdatasync(fd_);
+    unsynced_ = 0;
+    lastSync_ = std::chrono::steady_clock::now();
+}
+
+bool DownloadJournal::appendPending(const std::string &serial, const char *folder,
+                                    const char *name) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::string key = keyOf(serial, folder, name);
+    if (pending_.count(key)) return true;
+    if (!appendLocked(PENDING, serial, folder, name, "")) return false;
+    pending_[key] = Entry{serial, folder, name};
+    return true;
+}
+
+bool DownloadJournal::appendDone(const std::string &serial, const char *folder, const char *name,
+                                 const std::string &localName) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!appendLocked(DONE, serial, folder, name, localName.c_str())) return false;
+    pending_.erase(keyOf(serial, folder, name));
+    done_++;
+    return true;
+}
+
+bool DownloadJournal::appendFailed(const std::string &serial, const char *folder,
+                                   const char *name) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!appendLocked(FAILED, serial, folder, name, "")) return false;
+    pending_.erase(keyOf(serial, folder, name));
+    failed_++;
+    return true;
+}
+
+void DownloadJournal::flush() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    flushLocked();
+}
+
+std::vector<DownloadJournal::Entry> DownloadJournal::pendingFor(const std::string &serial) const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::vector<Entry> out;
+    for (const auto &kv: pending_) {
+        if (kv.second.serial == serial) out.push_back(kv.second);
+    }
+    return out;
+}
+
+std::string DownloadJournal::toJson() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::ostringstream oss;
+    oss << "{\"pending\":" << pending_.size() << ",\"done\":" << done_
+        << ",\"failed\":" << failed_ << ",\"unsynced\":" << unsynced_ << "}";
+    return oss.str();
+}
+
+std::string parseSerialNumber(const char *summary) {
+    if (!summary) return "";
+
+    const char *key = "Serial Number:";
+    const char *p = strstr(summary, key);
+    if (!p) return "";
+    p += strlen(key);
+    while (*p == ' ' || *p == '\t') p++;
+    const char *end = p;
+    while (*end && *end != '\n' && *end != '\r') end++;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t')) end--;
+    return std::string(p, end - p);
+}
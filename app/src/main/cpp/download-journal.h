@@ -0,0 +1,79 @@
+// app/src/main/cpp/download-journal.h
+
+#ifndef DOWNLOAD_JOURNAL_H
+#define DOWNLOAD_JOURNAL_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// 다운로드 저널 (filesDir/download_journal.bin)
+//  - 고정 크기(512B) 레코드를 append-only 로 기록한다. 키는 카메라 시리얼 + 폴더 +
+//    파일명. PENDING(FILE_ADDED 로 받을 파일 확인) -> DONE / FAILED.
+//  - fsync 는 JOURNAL_FSYNC_BATCH 개 또는 JOURNAL_FSYNC_INTERVAL_MS 마다 묶어서
+//    하고, 큐가 비었을 때 flush() 로 마무리한다.
+//  - open() 때 전체를 재생해 아직 PENDING 인 항목만 남기고 파일을 다시 쓴다
+//    (잘린 꼬리 레코드/체크섬 불일치는 버림). 같은 카메라가 다시 연결되면
+//    pendingFor(serial) 로 이어받는다.
+// ----------------------------------------------------------------------------
+class DownloadJournal {
+public:
+    enum State {
+        PENDING = 1,
+        DONE = 2,
+        FAILED = 3,     // 재시도해도 안 되는 에러 - 이어받지 않음
+    };
+
+    struct Entry {
+        std::string serial;
+        std::string folder;
+        std::string name;
+    };
+
+    static DownloadJournal &instance();
+
+    // 저널 파일 열기 + 재생 + 압축 (다른 파일이 열려 있으면 flush 후 교체)
+    bool open(const std::string &path);
+    void close();
+
+    // 필드가 레코드 칸보다 길면 기록하지 않고 false
+    bool appendPending(const std::string &serial, const char *folder, const char *name);
+    bool appendDone(const std::string &serial, const char *folder, const char *name,
+                    const std::string &localName);
+    bool appendFailed(const std::string &serial, const char *folder, const char *name);
+
+    // 버퍼에 남은 레코드 fsync
+    void flush();
+
+    std::vector<Entry> pendingFor(const std::string &serial) const;
+    std::string toJson() const;
+
+private:
+    DownloadJournal() = default;
+
+    bool appendLocked(int state, const std::string &serial, const char *folder, const char *name,
+                      const char *localName);
+    void flushLocked();
+    bool rewriteLocked(const std::string &path);
+    static std::string keyOf(const std::string &serial, const char *folder, const char *name);
+
+    mutable std::mutex mutex_;
+    std::string path_;
+    int fd_ = -1;
+    int unsynced_ = 0;
+    std::chrono::steady_clock::time_point lastSync_;
+    std::unordered_map<std::string, Entry> pending_;
+    unsigned long long done_ = 0;
+    unsigned long long failed_ = 0;
+};
+
+#define JOURNAL_FSYNC_BATCH 32
+#define JOURNAL_FSYNC_INTERVAL_MS 500
+
+// 카메라 요약 텍스트에서 시리얼 번호 추출 ("Serial Number: ...", 없으면 빈 문자열)
+std::string parseSerialNumber(const char *summary);
+
+#endif // DOWNLOAD_JOURNAL_H
@@ -0,0 +1,371 @@
+// app/src/main/cpp/exif-index.cpp
+
+#include "exif-index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+#include <gphoto2/gphoto2-result.h>
+#include <libexif/exif-data.h>
+#include <libexif/exif-utils.h>
+
+#include "json-util.h"
+#include "native-log.h"
+
+// ----------------------------------------------------------------------------
+// 추출
+// ----------------------------------------------------------------------------
+static bool entryNumber(ExifEntry *e, ExifByteOrder order, double &out) {
+    if (!e || !e->data || e->components < 1) return false;
+    switch (e->format) {
+        case EXIF_FORMAT_RATIONAL: {
+            ExifRational r = exif_get_rational(e->data, order);
+            if (r.denominator == 0) return false;
+            out = (double) r.numerator / r.denominator;
+            return true;
+        }
+        case EXIF_FORMAT_SRATIONAL: {
+            ExifSRational r = exif_get_srational(e->data, order);
+            if (r.denominator == 0) return false;
+            out = (double) r.numerator / r.denominator;
+            return true;
+        }
+        case EXIF_FORMAT_SHORT:
+            out = exif_get_short(e->data, order);
+            return true;
+        case EXIF_FORMAT_LONG:
+            out = exif_get_long(e->data, order);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static std::string entryString(ExifEntry *e) {
+    if (!e || !e->data || e->format != EXIF_FORMAT_ASCII) return std::string();
+    size_t len = strnlen(reinterpret_cast<const char *>(e->data), e->size);
+    std::string s(reinterpret_cast<const char *>(e->data), len);
+    while (!s.empty() && s.back() == ' ') s.pop_back();
+    return s;
+}
+
+static ExifEntry *entryOf(ExifData *ed, ExifIfd ifd, ExifTag tag) {
+    return ed->ifd[ifd] ? exif_content_get_entry(ed->ifd[ifd], tag) : nullptr;
+}
+
+// "YYYY:MM:DD HH:MM:SS" (+ "123" 1/1000 초 단위 문자열)
+static int64_t parseExifTime(const std::string &dt, const std::string &subSec) {
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    if (sscanf(dt.c_str(), "%d:%d:%d %d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+               &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6 || tm.tm_year < 1970) {
+        return -1;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    int64_t ms = (int64_t) timegm(&tm) * 1000;
+
+    int frac = 0, digits = 0;
+    for (char c: subSec) {
+        if (c < '0' || c > '9' || digits == 3) break;
+        frac = frac * 10 + (c - '0');
+        digits++;
+    }
+    for (; digits > 0 && digits < 3; digits++) frac *= 10;
+    return ms + frac;
+}
+
+// 제조사 노트: 셔터 수와 (표준 태그에 없으면) 시리얼
+static void readMakerNote(ExifData *ed, ExifInfo &out) {
+    ExifMnoteData *md = exif_data_get_mnote_data(ed);
+    if (!md) return;
+    char value[64];
+    unsigned int n = exif_mnote_data_count(md);
+    for (unsigned int i = 0; i < n; i++) {
+        const char *name = exif_mnote_data_get_name(md, i);
+        if (!name) continue;
+        bool count = strcmp(name, "ShutterCount") == 0 || strcmp(name, "TotalPictures") == 0;
+        bool serial = out.serial.empty() && strcmp(name, "SerialNumber") == 0;
+        if (!count && !serial) continue;
+        if (!exif_mnote_data_get_value(md, i, value, sizeof(value))) continue;
+        if (count) {
+            out.shutterCount = atoi(value);
+        } else {
+            out.serial = value;
+        }
+    }
+}
+
+bool exifParse(const uint8_t *data, size_t size, ExifInfo &out) {
+    out = ExifInfo();
+    if (size < 8) return false;
+
+    // TIFF 기반 RAW 는 libexif 가 알아보는 Exif 머리를 붙인다
+    std::vector<uint8_t> tiff;
+    if ((data[0] == 'I' && data[1] == 'I' && data[2] == 42 && data[3] == 0) ||
+        (data[0] == 'M' && data[1] == 'M' && data[2] == 0 && data[3] == 42)) {
+        static const uint8_t header[6] = {'E', 'x', 'i', 'f', 0, 0};
+        tiff.reserve(size + 6);
+        tiff.insert(tiff.end(), header, header + 6);
+        tiff.insert(tiff.end(), data, data + size);
+        data = tiff.data();
+        size = tiff.size();
+    }
+
+    ExifData *ed = exif_data_new_from_data(data, (unsigned int) size);
+    if (!ed) return false;
+    bool any = ed->ifd[EXIF_IFD_0] && ed->ifd[EXIF_IFD_0]->count > 0;
+    if (!any) {
+        exif_data_unref(ed);
+        return false;
+    }
+
+    ExifByteOrder order = exif_data_get_byte_order(ed);
+    double v;
+    if (entryNumber(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_TIME), order, v)) {
+        out.exposureSec = (float) v;
+    }
+    if (entryNumber(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_FNUMBER), order, v)) {
+        out.fNumber = (float) v;
+    }
+    if (entryNumber(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_ISO_SPEED_RATINGS), order, v)) {
+        out.iso = (int32_t) v;
+    }
+    if (entryNumber(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_FOCAL_LENGTH), order, v)) {
+        out.focalMm = (float) v;
+    }
+    if (entryNumber(entryOf(ed, EXIF_IFD_0, EXIF_TAG_ORIENTATION), order, v) && v >= 1 && v <= 8) {
+        out.orientation = (int32_t) v;
+    }
+    out.captureMs = parseExifTime(
+            entryString(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_DATE_TIME_ORIGINAL)),
+            entryString(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_SUB_SEC_TIME_ORIGINAL)));
+    out.serial = entryString(entryOf(ed, EXIF_IFD_EXIF, EXIF_TAG_BODY_SERIAL_NUMBER));
+    readMakerNote(ed, out);
+
+    exif_data_unref(ed);
+    return true;
+}
+
+bool exifParseFile(const std::string &path, ExifInfo &out) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    std::vector<uint8_t> buf(EXIF_PREFIX_BYTES);
+    size_t got = 0;
+    while (got < buf.size()) {
+        ssize_t n = read(fd, buf.data() + got, buf.size() - got);
+        if (n <= 0) break;
+        got += n;
+    }
+    close(fd);
+    return exifParse(buf.data(), got, out);
+}
+
+int exifReadCamera(Camera *camera, GPContext *context, const char *folder, const char *name,
+                   ExifInfo &out) {
+    std::vector<char> buf(EXIF_PREFIX_BYTES);
+    uint64_t size = buf.size();
+    int ret = gp_camera_file_read(camera, folder, name, GP_FILE_TYPE_NORMAL, 0, buf.data(), &size,
+                                  context);
+    if (ret < GP_OK) return ret;
+    return exifParse(reinterpret_cast<const uint8_t *>(buf.data()), (size_t) size, out)
+           ? GP_OK : GP_ERROR_CORRUPTED_DATA;
+}
+
+// 값이 없으면 null
+static void jsonNumber(std::ostringstream &oss, const char *key, double v, bool present) {
+    oss << ",\"" << key << "\":";
+    if (present) {
+        oss << v;
+    } else {
+        oss << "null";
+    }
+}
+
+static void appendFields(std::ostringstream &oss, int64_t captureMs, float exposure, float fNumber,
+                         int32_t iso, float focal, int32_t orientation, int32_t shutterCount,
+                         const std::string &serial) {
+    oss << ",\"captureMs\":";
+    if (captureMs >= 0) {
+        oss << captureMs;
+    } else {
+        oss << "null";
+    }
+    jsonNumber(oss, "exposure", exposure, exposure >= 0);
+    jsonNumber(oss, "fNumber", fNumber, fNumber >= 0);
+    jsonNumber(oss, "iso", iso, iso >= 0);
+    jsonNumber(oss, "focal", focal, focal >= 0);
+    jsonNumber(oss, "orientation", orientation, orientation >= 0);
+    jsonNumber(oss, "shutterCount", shutterCount, shutterCount >= 0);
+    oss << ",\"serial\":\"" << escapeJsonString(serial) << "\"";
+}
+
+std::string exifInfoJson(const ExifInfo &info) {
+    std::ostringstream oss;
+    oss << "{\"ok\":true";
+    appendFields(oss, info.captureMs, info.exposureSec, info.fNumber, info.iso, info.focalMm,
+                 info.orientation, info.shutterCount, info.serial);
+    oss << "}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// ExifIndex
+// ----------------------------------------------------------------------------
+ExifIndex::Query::Query() {
+    for (double &r: ranges) r = NAN;
+}
+
+ExifIndex &ExifIndex::instance() {
+    static ExifIndex index;
+    return index;
+}
+
+int ExifIndex::put(const std::string &key, const ExifInfo &info) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint16_t serialId = 0;
+    auto sit = std::find(serials_.begin(), serials_.end(), info.serial);
+    if (sit != serials_.end()) {
+        serialId = (uint16_t) (sit - serials_.begin());
+    } else if (serials_.size() < 0xffff) {
+        serialId = (uint16_t) serials_.size();
+        serials_.push_back(info.serial);
+    }
+
+    int row;
+    auto it = rowOf_.find(key);
+    if (it != rowOf_.end()) {
+        row = it->second;
+    } else {
+        row = (int) keys_.size();
+        rowOf_[key] = row;
+        keys_.push_back(key);
+        captureMs_.emplace_back();
+        exposure_.emplace_back();
+        fNumber_.emplace_back();
+        iso_.emplace_back();
+        focal_.emplace_back();
+        orientation_.emplace_back();
+        shutterCount_.emplace_back();
+        serialId_.emplace_back();
+    }
+    captureMs_[row] = info.captureMs;
+    exposure_[row] = info.exposureSec;
+    fNumber_[row] = info.fNumber;
+    iso_[row] = info.iso;
+    focal_[row] = info.focalMm;
+    orientation_[row] = (int8_t) info.orientation;
+    shutterCount_[row] = info.shutterCount;
+    serialId_[row] = serialId;
+    return row;
+}
+
+// 없는 값은 NaN
+double ExifIndex::valueLocked(int field, size_t row) const {
+    double v;
+    switch (field) {
+        case CAPTURE_TIME: v = (double) captureMs_[row]; break;
+        case EXPOSURE: v = exposure_[row]; break;
+        case FNUMBER: v = fNumber_[row]; break;
+        case ISO: v = iso_[row]; break;
+        case FOCAL: v = focal_[row]; break;
+        case ORIENTATION: v = orientation_[row]; break;
+        case SHUTTER_COUNT: v = shutterCount_[row]; break;
+        default: return NAN;
+    }
+    return v < 0 ? NAN : v;
+}
+
+// 열 하나를 훑어 [lo, hi] 밖(또는 값 없음)인 행을 거른다
+template<typename T>
+static void filterColumn(const std::vector<T> &col, double lo, double hi, std::vector<int> &rows) {
+    size_t out = 0;
+    for (int r: rows) {
+        double v = (double) col[r];
+        if (v < 0) continue;
+        if (!std::isnan(lo) && v < lo) continue;
+        if (!std::isnan(hi) && v > hi) continue;
+        rows[out++] = r;
+    }
+    rows.resize(out);
+}
+
+std::vector<int> ExifIndex::query(const Query &q) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> rows(keys_.size());
+    for (size_t i = 0; i < rows.size(); i++) rows[i] = (int) i;
+
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        double lo = q.ranges[f * 2], hi = q.ranges[f * 2 + 1];
+        if (std::isnan(lo) && std::isnan(hi)) continue;
+        switch (f) {
+            case CAPTURE_TIME: filterColumn(captureMs_, lo, hi, rows); break;
+            case EXPOSURE: filterColumn(exposure_, lo, hi, rows); break;
+            case FNUMBER: filterColumn(fNumber_, lo, hi, rows); break;
+            case ISO: filterColumn(iso_, lo, hi, rows); break;
+            case FOCAL: filterColumn(focal_, lo, hi, rows); break;
+            case ORIENTATION: filterColumn(orientation_, lo, hi, rows); break;
+            case SHUTTER_COUNT: filterColumn(shutterCount_, lo, hi, rows); break;
+            default: break;
+        }
+    }
+
+    // 정렬 키만 뽑아 정렬 (값 없는 행은 방향과 상관없이 뒤로)
+    std::vector<std::pair<double, int>> keyed(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) keyed[i] = {valueLocked(q.sortBy, rows[i]), rows[i]};
+    bool desc = q.descending;
+    std::stable_sort(keyed.begin(), keyed.end(),
+                     [desc](const std::pair<double, int> &a, const std::pair<double, int> &b) {
+                         if (std::isnan(a.first)) return false;
+                         if (std::isnan(b.first)) return true;
+                         return desc ? a.first > b.first : a.first < b.first;
+                     });
+    for (size_t i = 0; i < rows.size(); i++) rows[i] = keyed[i].second;
+    return rows;
+}
+
+std::string ExifIndex::rowsJson(const std::vector<int> &rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "[";
+    bool first = true;
+    for (int r: rows) {
+        if (r < 0 || (size_t) r >= keys_.size()) continue;
+        if (!first) oss << ",";
+        first = false;
+        oss << "{\"row\":" << r << ",\"key\":\"" << escapeJsonString(keys_[r]) << "\"";
+        appendFields(oss, captureMs_[r], exposure_[r], fNumber_[r], iso_[r], focal_[r],
+                     orientation_[r], shutterCount_[r], serials_[serialId_[r]]);
+        oss << "}";
+    }
+    oss << "]";
+    return oss.str();
+}
+
+size_t ExifIndex::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return keys_.size();
+}
+
+void ExifIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rowOf_.clear();
+    keys_.clear();
+    captureMs_.clear();
+    exposure_.clear();
+    fNumber_.clear();
+    iso_.clear();
+    focal_.clear();
+    orientation_.clear();
+    shutterCount_.clear();
+    serialId_.clear();
+    serials_.clear();
+}
@@ -0,0 +1,99 @@
+// app/src/main/cpp/exif-index.h
+
+#ifndef EXIF_INDEX_H
+#define EXIF_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gphoto2/gphoto2-camera.h>
+
+// EXIF 는 파일 앞부분(APP1, 최대 64KB)에 있으므로 이만큼만 읽는다
+#define EXIF_PREFIX_BYTES (64 * 1024)
+
+// ----------------------------------------------------------------------------
+// EXIF 추출 (번들 libexif, jniLibs/<abi>/libexif.a)
+//  - 이미지를 디코드하지 않고 앞부분 버퍼만 해석한다. JPEG 은 그대로, TIFF 기반
+//    RAW(NEF/CR2/ARW/DNG)는 "Exif\0\0" 머리를 붙여 넘긴다.
+//  - 없는 값은 숫자 필드 -1 (float 는 NaN), 문자열은 빈 값.
+// ----------------------------------------------------------------------------
+struct ExifInfo {
+    int64_t captureMs = -1;         // DateTimeOriginal(+SubSec), 카메라 현지 시각을 UTC 로 간주
+    float exposureSec = -1;
+    float fNumber = -1;
+    int32_t iso = -1;
+    float focalMm = -1;
+    int32_t orientation = -1;       // 1..8
+    int32_t shutterCount = -1;      // 제조사 노트 (Nikon TotalPictures 등, 없으면 -1)
+    std::string serial;
+};
+
+bool exifParse(const uint8_t *data, size_t size, ExifInfo &out);
+bool exifParseFile(const std::string &path, ExifInfo &out);
+
+// gp_camera_file_read 로 앞 EXIF_PREFIX_BYTES 만 읽어 해석 (호출자가 카메라 접근 직렬화)
+int exifReadCamera(Camera *camera, GPContext *context, const char *folder, const char *name,
+                   ExifInfo &out);
+
+std::string exifInfoJson(const ExifInfo &info);
+
+// ----------------------------------------------------------------------------
+// 열 지향 EXIF 색인 (프로세스 전역)
+//  - 필드마다 배열 하나. 필터/정렬은 필요한 열만 훑으므로 수천 장도 파일을 다시
+//    열지 않고 끝난다. 키는 로컬 파일명(내용 주소) 또는 "폴더/이름".
+//  - query 는 행 번호 배열을 돌려주고 rowsJson 으로 필요한 만큼만 꺼낸다.
+// ----------------------------------------------------------------------------
+class ExifIndex {
+public:
+    enum Field {
+        CAPTURE_TIME = 0,
+        EXPOSURE = 1,
+        FNUMBER = 2,
+        ISO = 3,
+        FOCAL = 4,
+        ORIENTATION = 5,
+        SHUTTER_COUNT = 6,
+        FIELD_COUNT = 7,
+    };
+
+    // ranges: 필드마다 [min, max] (NaN 이면 그쪽 제한 없음, 값이 없는 행은 제한이 있으면 제외)
+    struct Query {
+        int sortBy = CAPTURE_TIME;
+        bool descending = false;
+        double ranges[FIELD_COUNT * 2];
+        Query();
+    };
+
+    static ExifIndex &instance();
+
+    // 같은 키면 덮어쓴다. 행 번호
+    int put(const std::string &key, const ExifInfo &info);
+    std::vector<int> query(const Query &q);
+    std::string rowsJson(const std::vector<int> &rows);
+    size_t size();
+    void clear();
+
+private:
+    ExifIndex() = default;
+
+    double valueLocked(int field, size_t row) const;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, int> rowOf_;
+    std::vector<std::string> keys_;
+    std::vector<int64_t> captureMs_;
+    std::vector<float> exposure_;
+    std::vector<float> fNumber_;
+    std::vector<int32_t> iso_;
+    std::vector<float> focal_;
+    std::vector<int8_t> orientation_;
+    std::vector<int32_t> shutterCount_;
+    std::vector<uint16_t> serialId_;        // serials_ 의 번호 (세션 안에서는 몇 개뿐)
+    std::vector<std::string> serials_;
+};
+
+#endif // EXIF_INDEX_H
@@ -0,0 +1,248 @@
+// app/src/main/cpp/imported-index.cpp
+
+#include "imported-index.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "native-log.h"
+
+static const uint32_t kImportedMagic = 0x31584449; // "IDX1"
+
+struct ImportedIndex::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+    uint64_t capacity;      // 슬롯 수 (2의 거듭제곱)
+    uint64_t reserved;
+};
+
+struct ImportedIndex::Slot {
+    uint64_t key;           // 0 = 빈 슬롯
+    uint64_t size;
+    int64_t mtime;
+};
+
+static uint64_t fnv1a64(const std::string &s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c: s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+ImportedIndex &ImportedIndex::instance() {
+    static ImportedIndex index;
+    return index;
+}
+
+uint64_t ImportedIndex::keyOf(const std::string &serial, const char *folder, const char *name) {
+    std::string key = serial;
+    key += '\n';
+    key += folder ? folder : "";
+    key += '/';
+    key += name ? name : "";
+    uint64_t h = fnv1a64(key);
+    return h ? h : 1;
+}
+
+// 새 파일이면 빈 테이블로 초기화한 뒤 전체를 매핑
+bool ImportedIndex::mapLocked(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return false;
+
+    Header h;
+    bool valid = (size_t) st.st_size >= sizeof(Header) &&
+                 pread(fd, &h, sizeof(h), 0) == (ssize_t) sizeof(h) &&
+                 h.magic == kImportedMagic && h.capacity > 0 &&
+                 (h.capacity & (h.capacity - 1)) == 0 &&
+                 (size_t) st.st_size >= sizeof(Header) + h.capacity * sizeof(Slot);
+    if (!valid) {
+        if (st.st_size > 0) LOGE("ImportedIndex: 손상된 인덱스 -> 새로 만듦");
+        memset(&h, 0, sizeof(h));
+        h.magic = kImportedMagic;
+        h.version = 1;
+        h.capacity = IMPORTED_INDEX_INITIAL_SLOTS;
+        if (ftruncate(fd, 0) != 0 ||
+            ftruncate(fd, sizeof(Header) + h.capacity * sizeof(Slot)) != 0 ||
+            pwrite(fd, &h, sizeof(h), 0) != (ssize_t) sizeof(h)) {
+            return false;
+        }
+    }
+
+    size_t size = sizeof(Header) + h.capacity * sizeof(Slot);
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) return false;
+    map_ = map;
+    mapSize_ = size;
+    return true;
+}
+
+void ImportedIndex::unmapLocked() {
+    if (map_) munmap(map_, mapSize_);
+    map_ = nullptr;
+    mapSize_ = 0;
+}
+
+bool ImportedIndex::open(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0 && path == path_) return true;
+    if (fd_ >= 0) {
+        unmapLocked();
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0 || !mapLocked(fd)) {
+        LOGE("ImportedIndex: %s 열기 실패", path.c_str());
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    fd_ = fd;
+    path_ = path;
+    const Header *h = static_cast<const Header *>(map_);
+    LOGD("ImportedIndex: %s (%llu/%llu)", path.c_str(), (unsigned long long) h->count,
+         (unsigned long long) h->capacity);
+    return true;
+}
+
+void ImportedIndex::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) return;
+    msync(map_, mapSize_, MS_SYNC);
+    unmapLocked();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+ImportedIndex::Slot *ImportedIndex::findLocked(uint64_t key) const {
+    Header *h = static_cast<Header *>(map_);
+    Slot *slots = reinterpret_cast<Slot *>(h + 1);
+    uint64_t mask = h->capacity - 1;
+    for (uint64_t i = key & mask;; i = (i + 1) & mask) {
+        // 적재율 상한 덕분에 빈 슬롯이 반드시 있다
+        if (slots[i].key == key || slots[i].key == 0) return &slots[i];
+    }
+}
+
+ImportedIndex::Status ImportedIndex::lookup(const std::string &serial, const char *folder,
+                                            const char *name, uint64_t size,
+                                            int64_t mtime) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!map_) return NEW;
+
+    const Slot *slot = findLocked(keyOf(serial, folder, name));
+    if (slot->key == 0) return NEW;
+    if (size && slot->size && size != slot->size) return CHANGED;
+    if (mtime && slot->mtime && mtime != slot->mtime) return CHANGED;
+    return IMPORTED;
+}
+
+// 두 배 크기 임시 파일에 다시 넣고 rename 후 교체
+bool ImportedIndex::growLocked() {
+    const Header *old = static_cast<const Header *>(map_);
+    const Slot *oldSlots = reinterpret_cast<const Slot *>(old + 1);
+
+    Header h = *old;
+    h.capacity = old->capacity * 2;
+    size_t size = sizeof(Header) + h.capacity * sizeof(Slot);
+
+    const std::string tmp = path_ + ".tmp";
+    int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+    void *map = ftruncate(fd, size) == 0
+                ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        ::remove(tmp.c_str());
+        return false;
+    }
+
+    memcpy(map, &h, sizeof(h));
+    Slot *slots = reinterpret_cast<Slot *>(static_cast<Header *>(map) + 1);
+    uint64_t mask = h.capacity - 1;
+    for (uint64_t i = 0; i < old->capacity; i++) {
+        if (oldSlots[i].key == 0) continue;
+        uint64_t j = oldSlots[i].key & mask;
+        while (slots[j].key != 0) j = (j + 1) & mask;
+        slots[j] = oldSlots[i];
+    }
+
+    if (msync(map, size, MS_SYNC) != 0 || rename(tmp.c_str(), path_.c_str()) != 0) {
+        munmap(map, size);
+        ::close(fd);
+        ::remove(tmp.c_str());
+        return false;
+    }
+    unmapLocked();
+    ::close(fd_);
+    fd_ = fd;
+    map_ = map;
+    mapSize_ = size;
+    LOGD("ImportedIndex: 슬롯 %llu 로 확장", (unsigned long long) h.capacity);
+    return true;
+}
+
+bool ImportedIndex::markImported(const std::string &serial, const char *folder, const char *name,
+                                 uint64_t size, int64_t mtime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!map_) return false;
+
+    Header *h = static_cast<Header *>(map_);
+    if ((double) (h->count + 1) > (double) h->capacity * IMPORTED_INDEX_MAX_LOAD) {
+        if (!growLocked()) {
+            LOGE("ImportedIndex: 확장 실패");
+            return false;
+        }
+        h = static_cast<Header *>(map_);
+    }
+
+    uint64_t key = keyOf(serial, folder, name);
+    Slot *slot = findLocked(key);
+    if (slot->key == 0) h->count++;
+    slot->size = size;
+    slot->mtime = mtime;
+    slot->key = key;        // 키를 마지막에 써서 중간에 죽어도 반쪽 슬롯이 보이지 않게
+    return true;
+}
+
+// 선형 탐사라 빈 칸을 그냥 두면 뒤쪽 키를 못 찾는다: 뒤 슬롯을 당겨 채운다 (backward shift)
+bool ImportedIndex::forget(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!map_ || key == 0) return false;
+
+    Header *h = static_cast<Header *>(map_);
+    Slot *slots = reinterpret_cast<Slot *>(h + 1);
+    const uint64_t mask = h->capacity - 1;
+    Slot *slot = findLocked(key);
+    if (slot->key == 0) return false;
+
+    uint64_t hole = (uint64_t) (slot - slots);
+    for (uint64_t j = (hole + 1) & mask; slots[j].key != 0; j = (j + 1) & mask) {
+        const uint64_t home = slots[j].key & mask;
+        // home 이 (hole, j] 안이면 그대로 두어도 찾을 수 있다
+        bool reachable = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+        if (reachable) continue;
+        slots[hole] = slots[j];
+        hole = j;
+    }
+    memset(&slots[hole], 0, sizeof(Slot));
+    h->count--;
+    return true;
+}
+
+void ImportedIndex::sync(bool wait) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_) msync(map_, mapSize_, wait ? MS_SYNC : MS_ASYNC);
+}
+
+uint64_t ImportedIndex::count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_ ? static_cast<const Header *>(map_)->count : 0;
+}
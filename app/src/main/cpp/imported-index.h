@@ -0,0 +1,69 @@
+// app/src/main/cpp/imported-index.h
+
+#ifndef IMPORTED_INDEX_H
+#define IMPORTED_INDEX_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// 가져오기 완료 인덱스 (filesDir/imported_index.bin, mmap)
+//  - 이미 내려받은 카메라 파일을 (시리얼 + 폴더 + 파일명) 64비트 해시로 기록하는
+//    개방 주소법 해시 테이블. 슬롯마다 크기/수정 시각을 함께 두어 같은 이름으로
+//    바뀐 파일은 CHANGED 로 판정한다.
+//  - 파일 전체를 MAP_SHARED 로 매핑해 조회는 디스크 I/O 없이 끝나고, 기록은 페이지
+//    캐시에 바로 반영된다. 적재율이 IMPORTED_INDEX_MAX_LOAD 를 넘으면 두 배 크기의
+//    임시 파일로 재해싱한 뒤 rename.
+//  - 슬롯 24바이트, 5만 장 기준 약 3MB.
+// ----------------------------------------------------------------------------
+class ImportedIndex {
+public:
+    enum Status {
+        NEW = 0,
+        CHANGED = 1,    // 같은 이름, 다른 크기/시각 (카드 포맷 후 번호 재사용 등)
+        IMPORTED = 2,
+    };
+
+    static ImportedIndex &instance();
+
+    bool open(const std::string &path);
+    void close();
+
+    // size/mtime 이 0 이면(카메라가 안 줌) 비교하지 않는다
+    Status lookup(const std::string &serial, const char *folder, const char *name,
+                  uint64_t size, int64_t mtime) const;
+    bool markImported(const std::string &serial, const char *folder, const char *name,
+                      uint64_t size, int64_t mtime);
+    // 로컬 사본을 지웠을 때 (PhotoStore 축출) 다음 동기화에서 다시 받도록 기록을 지운다
+    bool forget(uint64_t key);
+
+    // (시리얼 + 폴더 + 파일명) 키. 0 은 쓰지 않는다
+    static uint64_t keyOf(const std::string &serial, const char *folder, const char *name);
+
+    // 변경 페이지를 디스크로 (wait=false 면 비동기 요청만)
+    void sync(bool wait);
+    uint64_t count() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    ImportedIndex() = default;
+
+    bool mapLocked(int fd);
+    void unmapLocked();
+    bool growLocked();
+    Slot *findLocked(uint64_t key) const;
+
+    mutable std::mutex mutex_;
+    std::string path_;
+    int fd_ = -1;
+    void *map_ = nullptr;
+    size_t mapSize_ = 0;
+};
+
+#define IMPORTED_INDEX_INITIAL_SLOTS 4096
+#define IMPORTED_INDEX_MAX_LOAD 0.7
+
+#endif // IMPORTED_INDEX_H
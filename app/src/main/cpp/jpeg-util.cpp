@@ -0,0 +1,714 @@
+// app/src/main/cpp/jpeg-util.cpp
+
+#include "jpeg-util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <jpeglib.h>
+
+#include "native-log.h"
+
+namespace {
+
+struct JpegErrorMgr {
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+};
+
+void onJpegError(j_common_ptr cinfo) {
+    char msg[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, msg);
+    LOGE("libjpeg: %s", msg);
+    longjmp(reinterpret_cast<JpegErrorMgr *>(cinfo->err)->jump, 1);
+}
+
+// 경고(손상된 데이터 등)는 디코드를 멈추지 않고 로그도 남기지 않는다
+void onJpegMessage(j_common_ptr) {}
+
+// std::vector 로 바로 쓰는 출력 관리자 (jpeg_mem_dest 는 libjpeg 버전마다 시그니처가 다름)
+#define JPEG_DEST_CHUNK 65536
+
+struct VectorDest {
+    jpeg_destination_mgr pub;
+    std::vector<uint8_t> *out;
+};
+
+void destInit(j_compress_ptr cinfo) {
+    VectorDest *d = reinterpret_cast<VectorDest *>(cinfo->dest);
+    d->out->resize(JPEG_DEST_CHUNK);
+    d->pub.next_output_byte = d->out->data();
+    d->pub.free_in_buffer = d->out->size();
+}
+
+boolean destEmpty(j_compress_ptr cinfo) {
+    VectorDest *d = reinterpret_cast<VectorDest *>(cinfo->dest);
+    size_t used = d->out->size();
+    d->out->resize(used * 2);
+    d->pub.next_output_byte = d->out->data() + used;
+    d->pub.free_in_buffer = d->out->size() - used;
+    return TRUE;
+}
+
+void destTerm(j_compress_ptr cinfo) {
+    VectorDest *d = reinterpret_cast<VectorDest *>(cinfo->dest);
+    d->out->resize(d->out->size() - d->pub.free_in_buffer);
+}
+
+} // namespace
+
+bool jpegReadSize(const uint8_t *data, size_t size, int &width, int &height) {
+    jpeg_decompress_struct cinfo;
+    JpegErrorMgr err;
+    cinfo.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = onJpegError;
+    err.pub.output_message = onJpegMessage;
+    if (setjmp(err.jump)) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, size);
+    jpeg_read_header(&cinfo, TRUE);
+    width = (int) cinfo.image_width;
+    height = (int) cinfo.image_height;
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+int jpegPickScaleDenom(int width, int height, int minEdge) {
+    int edge = width > height ? width : height;
+    int denom = 1;
+    while (denom < 8 && minEdge > 0 && edge / (denom * 2) >= minEdge) denom *= 2;
+    return denom;
+}
+
+// RGB(3) 또는 휘도(1) 출력. 휘도만이면 libjpeg 이 색차 성분 IDCT/업샘플을 건너뛴다
+static bool decodeScaled(const uint8_t *data, size_t size, int scaleDenom, J_COLOR_SPACE space,
+                         int channels, JpegImage &out) {
+    jpeg_decompress_struct cinfo;
+    JpegErrorMgr err;
+    cinfo.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = onJpegError;
+    err.pub.output_message = onJpegMessage;
+    if (setjmp(err.jump)) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, size);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = space;
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scaleDenom > 0 ? scaleDenom : 1;
+    // 축소 디코드에서는 화질 차이가 거의 없고 빠른 쪽으로
+    if (cinfo.scale_denom > 1) {
+        cinfo.dct_method = JDCT_IFAST;
+        cinfo.do_fancy_upsampling = FALSE;
+    }
+    jpeg_start_decompress(&cinfo);
+
+    out.width = (int) cinfo.output_width;
+    out.height = (int) cinfo.output_height;
+    out.pixels.resize((size_t) out.width * out.height * channels);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = out.pixels.data() + (size_t) cinfo.output_scanline * out.width * channels;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+bool jpegDecodeRgb(const uint8_t *data, size_t size, int scaleDenom, JpegImage &out) {
+    return decodeScaled(data, size, scaleDenom, JCS_RGB, 3, out);
+}
+
+bool jpegDecodeLuma(const uint8_t *data, size_t size, int scaleDenom, JpegImage &out) {
+    return decodeScaled(data, size, scaleDenom, JCS_GRAYSCALE, 1, out);
+}
+
+bool jpegEncodeRgb(const JpegImage &img, int quality, std::vector<uint8_t> &out) {
+    if (img.width <= 0 || img.height <= 0) return false;
+
+    jpeg_compress_struct cinfo;
+    JpegErrorMgr err;
+    cinfo.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = onJpegError;
+    err.pub.output_message = onJpegMessage;
+    if (setjmp(err.jump)) {
+        jpeg_destroy_compress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_compress(&cinfo);
+    VectorDest dest;
+    dest.pub.init_destination = destInit;
+    dest.pub.empty_output_buffer = destEmpty;
+    dest.pub.term_destination = destTerm;
+    dest.out = &out;
+    cinfo.dest = &dest.pub;
+
+    cinfo.image_width = (JDIMENSION) img.width;
+    cinfo.image_height = (JDIMENSION) img.height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = const_cast<JSAMPROW>(img.pixels.data() +
+                                            (size_t) cinfo.next_scanline * img.width * 3);
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// 무손실 방향 변환 (DCT 계수 블록 재배치)
+// ----------------------------------------------------------------------------
+namespace {
+
+// orientation 을 "출력 = 원본을 (전치 후) 좌우/상하 뒤집기" 로 분해
+struct Orient {
+    bool transpose;
+    bool mirrorX;       // 원본 x 축을 뒤집음
+    bool mirrorY;
+};
+
+bool orientOf(int orientation, Orient &o) {
+    static const Orient table[9] = {
+            {false, false, false}, {false, false, false},
+            {false, true, false},   // 2 좌우 반전
+            {false, true, true},    // 3 180도
+            {false, false, true},   // 4 상하 반전
+            {true, false, false},   // 5 전치
+            {true, false, true},    // 6 시계 90도
+            {true, true, true},     // 7 역전치
+            {true, true, false},    // 8 시계 270도
+    };
+    if (orientation < 2 || orientation > 8) return false;
+    o = table[orientation];
+    return true;
+}
+
+uint16_t exifGet16(const uint8_t *p, bool le) {
+    return le ? (uint16_t) (p[0] | p[1] << 8) : (uint16_t) (p[0] << 8 | p[1]);
+}
+
+uint32_t exifGet32(const uint8_t *p, bool le) {
+    return le ? (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24
+              : (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 | (uint32_t) p[3];
+}
+
+// APP1 "Exif\0\0" 안 IFD0 의 Orientation(0x0112) 값을 1 로 (버퍼 안에서 바로 고침)
+void resetExifOrientation(uint8_t *app1, size_t len) {
+    if (len < 14 || memcmp(app1, "Exif\0\0", 6) != 0) return;
+    uint8_t *tiff = app1 + 6;
+    size_t tiffLen = len - 6;
+    bool le = tiff[0] == 'I' && tiff[1] == 'I';
+    if (!le && !(tiff[0] == 'M' && tiff[1] == 'M')) return;
+    uint32_t ifd = exifGet32(tiff + 4, le);
+    if (ifd + 2 > tiffLen) return;
+    uint16_t count = exifGet16(tiff + ifd, le);
+    for (uint16_t i = 0; i < count; i++) {
+        size_t e = ifd + 2 + (size_t) i * 12;
+        if (e + 12 > tiffLen) return;
+        // SHORT 하나라 값은 항목 안(+8)에 있다
+        if (exifGet16(tiff + e, le) == 0x0112 && exifGet16(tiff + e + 2, le) == 3) {
+            tiff[e + 8] = le ? 1 : 0;
+            tiff[e + 9] = le ? 0 : 1;
+            return;
+        }
+    }
+}
+
+} // namespace
+
+bool jpegTransformOrientation(const uint8_t *data, size_t size, int orientation,
+                              std::vector<uint8_t> &out) {
+    Orient o;
+    if (!orientOf(orientation, o)) return false;
+
+    jpeg_decompress_struct src;
+    jpeg_compress_struct dst;
+    JpegErrorMgr err;
+    // 에러 관리자 하나를 둘이 같이 쓴다: 어느 쪽에서 나든 여기로 와서 둘 다 정리
+    src.err = dst.err = jpeg_std_error(&err.pub);
+    err.pub.error_exit = onJpegError;
+    err.pub.output_message = onJpegMessage;
+    jpeg_create_decompress(&src);
+    jpeg_create_compress(&dst);
+    if (setjmp(err.jump)) {
+        jpeg_destroy_compress(&dst);
+        jpeg_destroy_decompress(&src);
+        return false;
+    }
+
+    jpeg_mem_src(&src, data, size);
+    jpeg_save_markers(&src, JPEG_COM, 0xFFFF);
+    for (int m = 0; m < 16; m++) jpeg_save_markers(&src, JPEG_APP0 + m, 0xFFFF);
+    jpeg_read_header(&src, TRUE);
+
+    const int iMcuW = src.max_h_samp_factor * DCTSIZE;
+    const int iMcuH = src.max_v_samp_factor * DCTSIZE;
+    // 뒤집히는 축은 MCU 배수로 잘라야 블록이 통째로 옮겨진다
+    JDIMENSION srcW = src.image_width;
+    JDIMENSION srcH = src.image_height;
+    if (o.mirrorX) srcW -= srcW % iMcuW;
+    if (o.mirrorY) srcH -= srcH % iMcuH;
+    if (srcW == 0 || srcH == 0) {
+        jpeg_destroy_compress(&dst);
+        jpeg_destroy_decompress(&src);
+        return false;
+    }
+    const JDIMENSION dstW = o.transpose ? srcH : srcW;
+    const JDIMENSION dstH = o.transpose ? srcW : srcH;
+    const int dstMcuW = o.transpose ? iMcuH : iMcuW;
+    const int dstMcuH = o.transpose ? iMcuW : iMcuH;
+
+    // 출력 계수 배열은 read_coefficients 가 실체화하도록 그 전에 요청
+    // (longjmp 로 빠져나갈 수 있어 힙을 쓰는 컨테이너 대신 고정 배열)
+    const int nComp = src.num_components;
+    jvirt_barray_ptr dstArrays[MAX_COMPONENTS];
+    JDIMENSION dstBlocksW[MAX_COMPONENTS], dstBlocksH[MAX_COMPONENTS];
+    for (int c = 0; c < nComp; c++) {
+        const jpeg_component_info *comp = src.comp_info + c;
+        int hs = o.transpose ? comp->v_samp_factor : comp->h_samp_factor;
+        int vs = o.transpose ? comp->h_samp_factor : comp->v_samp_factor;
+        dstBlocksW[c] = (dstW + dstMcuW - 1) / dstMcuW * hs;
+        dstBlocksH[c] = (dstH + dstMcuH - 1) / dstMcuH * vs;
+        dstArrays[c] = (*src.mem->request_virt_barray)(
+                reinterpret_cast<j_common_ptr>(&src), JPOOL_IMAGE, FALSE,
+                dstBlocksW[c], dstBlocksH[c], (JDIMENSION) vs);
+    }
+    jvirt_barray_ptr *srcArrays = jpeg_read_coefficients(&src);
+
+    // 블록 안 계수 재배치: 공간에서 x 를 뒤집으면 가로 주파수가 홀수인 계수의 부호가,
+    // y 를 뒤집으면 세로 주파수가 홀수인 계수의 부호가 바뀐다. 전치는 행/열 교환.
+    int sign[DCTSIZE2];
+    int pos[DCTSIZE2];
+    for (int r = 0; r < DCTSIZE; r++) {
+        for (int k = 0; k < DCTSIZE; k++) {
+            bool flip = (o.mirrorX && (k & 1)) != (o.mirrorY && (r & 1));
+            sign[r * DCTSIZE + k] = flip ? -1 : 1;
+            pos[r * DCTSIZE + k] = o.transpose ? k * DCTSIZE + r : r * DCTSIZE + k;
+        }
+    }
+
+    for (int c = 0; c < nComp; c++) {
+        const jpeg_component_info *comp = src.comp_info + c;
+        // 뒤집는 축의 원본 블록 수 (MCU 배수로 자른 뒤라 딱 떨어진다)
+        const JDIMENSION lastX = srcW / iMcuW * comp->h_samp_factor - 1;
+        const JDIMENSION lastY = srcH / iMcuH * comp->v_samp_factor - 1;
+
+        // 전치하면 출력 한 행이 원본 여러 행에 걸치므로 원본 행 포인터를 먼저 모은다
+        // (계수는 모두 메모리에 있다. 표는 JPOOL_IMAGE 라 destroy 때 같이 풀림)
+        const JDIMENSION srcRowCount = o.transpose ? dstBlocksW[c] : dstBlocksH[c];
+        JBLOCKROW *srcRows = static_cast<JBLOCKROW *>((*src.mem->alloc_small)(
+                reinterpret_cast<j_common_ptr>(&src), JPOOL_IMAGE, srcRowCount * sizeof(JBLOCKROW)));
+        for (JDIMENSION i = 0; i < srcRowCount; i++) {
+            JDIMENSION sy = o.mirrorY ? lastY - i : i;
+            srcRows[i] = (*src.mem->access_virt_barray)(
+                    reinterpret_cast<j_common_ptr>(&src), srcArrays[c], sy, 1, FALSE)[0];
+        }
+
+        for (JDIMENSION by = 0; by < dstBlocksH[c]; by++) {
+            JBLOCKROW dstRow = (*src.mem->access_virt_barray)(
+                    reinterpret_cast<j_common_ptr>(&src), dstArrays[c], by, 1, TRUE)[0];
+            if (o.transpose) {
+                const JDIMENSION sx = o.mirrorX ? lastX - by : by;
+                for (JDIMENSION bx = 0; bx < dstBlocksW[c]; bx++) {
+                    const JCOEF *in = srcRows[bx][sx];
+                    JCOEF *outBlock = dstRow[bx];
+                    for (int i = 0; i < DCTSIZE2; i++) outBlock[pos[i]] = (JCOEF) (in[i] * sign[i]);
+                }
+            } else {
+                const JBLOCKROW srcRow = srcRows[by];
+                for (JDIMENSION bx = 0; bx < dstBlocksW[c]; bx++) {
+                    const JCOEF *in = srcRow[o.mirrorX ? lastX - bx : bx];
+                    JCOEF *outBlock = dstRow[bx];
+                    for (int i = 0; i < DCTSIZE2; i++) outBlock[i] = (JCOEF) (in[i] * sign[i]);
+                }
+            }
+        }
+    }
+
+    jpeg_copy_critical_parameters(&src, &dst);
+    dst.image_width = dstW;
+    dst.image_height = dstH;
+#if JPEG_LIB_VERSION >= 70
+    dst.jpeg_width = dstW;
+    dst.jpeg_height = dstH;
+#endif
+    if (o.transpose) {
+        for (int c = 0; c < nComp; c++) {
+            jpeg_component_info *comp = dst.comp_info + c;
+            std::swap(comp->h_samp_factor, comp->v_samp_factor);
+        }
+        // 계수를 전치했으니 양자화 표도 전치 (dst 가 가진 사본)
+        for (int t = 0; t < NUM_QUANT_TBLS; t++) {
+            JQUANT_TBL *q = dst.quant_tbl_ptrs[t];
+            if (!q) continue;
+            for (int r = 0; r < DCTSIZE; r++) {
+                for (int k = r + 1; k < DCTSIZE; k++) {
+                    std::swap(q->quantval[r * DCTSIZE + k], q->quantval[k * DCTSIZE + r]);
+                }
+            }
+        }
+    }
+    // 원본 APP0/APP14 를 그대로 옮기므로 라이브러리가 새로 쓰지 않게
+    dst.write_JFIF_header = FALSE;
+    dst.write_Adobe_marker = FALSE;
+
+    VectorDest dest;
+    dest.pub.init_destination = destInit;
+    dest.pub.empty_output_buffer = destEmpty;
+    dest.pub.term_destination = destTerm;
+    dest.out = &out;
+    dst.dest = &dest.pub;
+
+    jpeg_write_coefficients(&dst, dstArrays);
+    for (jpeg_saved_marker_ptr m = src.marker_list; m; m = m->next) {
+        if (m->marker == JPEG_APP0 + 1) resetExifOrientation(m->data, m->data_length);
+        jpeg_write_marker(&dst, m->marker, m->data, m->data_length);
+    }
+    jpeg_finish_compress(&dst);
+    jpeg_destroy_compress(&dst);
+    jpeg_finish_decompress(&src);
+    jpeg_destroy_decompress(&src);
+    return true;
+}
+
+void fitLongEdge(int width, int height, int maxEdge, int &outWidth, int &outHeight) {
+    outWidth = width;
+    outHeight = height;
+    if (maxEdge <= 0 || (width <= maxEdge && height <= maxEdge)) return;
+    if (width >= height) {
+        outWidth = maxEdge;
+        outHeight = std::max(1, (int) (((int64_t) height * maxEdge + width / 2) / width));
+    } else {
+        outHeight = maxEdge;
+        outWidth = std::max(1, (int) (((int64_t) width * maxEdge + height / 2) / height));
+    }
+}
+
+// 출력 좌표 i 가 덮는 입력 구간 [lo, hi) - 최소 한 칸
+static void boxSpans(int srcLen, int dstLen, std::vector<int> &lo, std::vector<int> &hi) {
+    lo.resize(dstLen);
+    hi.resize(dstLen);
+    for (int i = 0; i < dstLen; i++) {
+        int a = (int) ((int64_t) i * srcLen / dstLen);
+        int b = (int) ((int64_t) (i + 1) * srcLen / dstLen);
+        if (b <= a) b = std::min(a + 1, srcLen);
+        if (a >= srcLen) a = srcLen - 1;
+        lo[i] = a;
+        hi[i] = b;
+    }
+}
+
+void resizeBoxRgb(const JpegImage &src, int dstWidth, int dstHeight, JpegImage &dst) {
+    dst.width = dstWidth;
+    dst.height = dstHeight;
+    dst.pixels.resize((size_t) dstWidth * dstHeight * 3);
+    if (dstWidth <= 0 || dstHeight <= 0 || src.width <= 0 || src.height <= 0) return;
+
+    std::vector<int> xLo, xHi, yLo, yHi;
+    boxSpans(src.width, dstWidth, xLo, xHi);
+    boxSpans(src.height, dstHeight, yLo, yHi);
+
+    // 가로: 입력 행마다 출력 폭으로 (합계를 유지해 세로에서 한 번에 나눈다)
+    std::vector<uint32_t> rows((size_t) dstWidth * src.height * 3);
+    for (int y = 0; y < src.height; y++) {
+        const uint8_t *in = src.pixels.data() + (size_t) y * src.width * 3;
+        uint32_t *out = rows.data() + (size_t) y * dstWidth * 3;
+        for (int x = 0; x < dstWidth; x++) {
+            uint32_t r = 0, g = 0, b = 0;
+            for (int sx = xLo[x]; sx < xHi[x]; sx++) {
+                r += in[sx * 3];
+                g += in[sx * 3 + 1];
+                b += in[sx * 3 + 2];
+            }
+            out[x * 3] = r;
+            out[x * 3 + 1] = g;
+            out[x * 3 + 2] = b;
+        }
+    }
+
+    // 세로: 덮는 행을 더해 면적으로 나눈다
+    std::vector<uint32_t> acc((size_t) dstWidth * 3);
+    for (int y = 0; y < dstHeight; y++) {
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int sy = yLo[y]; sy < yHi[y]; sy++) {
+            const uint32_t *in = rows.data() + (size_t) sy * dstWidth * 3;
+            for (size_t i = 0; i < acc.size(); i++) acc[i] += in[i];
+        }
+        uint8_t *out = dst.pixels.data() + (size_t) y * dstWidth * 3;
+        uint32_t rowsCovered = (uint32_t) (yHi[y] - yLo[y]);
+        for (int x = 0; x < dstWidth; x++) {
+            uint32_t area = rowsCovered * (uint32_t) (xHi[x] - xLo[x]);
+            out[x * 3] = (uint8_t) ((acc[x * 3] + area / 2) / area);
+            out[x * 3 + 1] = (uint8_t) ((acc[x * 3 + 1] + area / 2) / area);
+            out[x * 3 + 2] = (uint8_t) ((acc[x * 3 + 2] + area / 2) / area);
+        }
+    }
+}
+
+void fitArea(int width, int height, int64_t maxPixels, int &outWidth, int &outHeight) {
+    outWidth = width;
+    outHeight = height;
+    if (maxPixels <= 0 || (int64_t) width * height <= maxPixels) return;
+    double s = sqrt((double) maxPixels / ((double) width * height));
+    outWidth = std::max(1, (int) (width * s));
+    outHeight = std::max(1, (int) (height * s));
+}
+
+// ----------------------------------------------------------------------------
+// 분리형 Catmull-Rom 리샘플
+// ----------------------------------------------------------------------------
+#define RESAMPLE_BITS 14
+#define RESAMPLE_CHUNK 1024
+
+namespace {
+
+float catmullRom(float x) {
+    x = fabsf(x);
+    if (x < 1.0f) return 1.5f * x * x * x - 2.5f * x * x + 1.0f;
+    if (x < 2.0f) return -0.5f * x * x * x + 2.5f * x * x - 4.0f * x + 2.0f;
+    return 0.0f;
+}
+
+// 출력 좌표마다 같은 개수(taps)의 가중치. 가장자리에선 창을 안쪽으로 밀고 다시 정규화
+struct Kernel {
+    int taps = 0;
+    std::vector<int> start;         // 출력 i 의 첫 입력 좌표
+    std::vector<int16_t> weights;   // [i * taps + k], 합 = 1 << RESAMPLE_BITS
+};
+
+void buildKernel(int srcLen, int dstLen, Kernel &k) {
+    const float scale = (float) srcLen / dstLen;
+    const float stretch = std::max(1.0f, scale);
+    const float support = 2.0f * stretch;
+    k.taps = std::min(srcLen, (int) ceilf(support * 2.0f) + 1);
+    k.start.resize(dstLen);
+    k.weights.assign((size_t) dstLen * k.taps, 0);
+
+    std::vector<float> w(k.taps);
+    for (int i = 0; i < dstLen; i++) {
+        const float center = (i + 0.5f) * scale - 0.5f;
+        int first = (int) floorf(center - support) + 1;
+        first = std::max(0, std::min(first, srcLen - k.taps));
+        float sum = 0.0f;
+        for (int t = 0; t < k.taps; t++) {
+            w[t] = catmullRom((first + t - center) / stretch);
+            sum += w[t];
+        }
+        // 고정소수점 반올림 오차는 가장 큰 탭에 몰아 합을 정확히 맞춘다
+        int16_t *out = k.weights.data() + (size_t) i * k.taps;
+        int total = 0, peak = 0;
+        for (int t = 0; t < k.taps; t++) {
+            out[t] = (int16_t) lrintf(w[t] / sum * (1 << RESAMPLE_BITS));
+            total += out[t];
+            if (out[t] > out[peak]) peak = t;
+        }
+        out[peak] = (int16_t) (out[peak] + (1 << RESAMPLE_BITS) - total);
+        k.start[i] = first;
+    }
+}
+
+inline uint8_t clampRound(int32_t acc) {
+    acc = (acc + (1 << (RESAMPLE_BITS - 1))) >> RESAMPLE_BITS;
+    return (uint8_t) (acc < 0 ? 0 : acc > 255 ? 255 : acc);
+}
+
+// acc[i] += w * in[i] (세로 패스의 핵심 루프, n 은 16 의 배수가 아니어도 됨)
+void accumulateRow(int32_t *acc, const uint8_t *in, int16_t w, size_t n) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(in + i);
+        int16x8_t lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(v)));
+        int16x8_t hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(v)));
+        vst1q_s32(acc + i, vmlal_n_s16(vld1q_s32(acc + i), vget_low_s16(lo), w));
+        vst1q_s32(acc + i + 4, vmlal_n_s16(vld1q_s32(acc + i + 4), vget_high_s16(lo), w));
+        vst1q_s32(acc + i + 8, vmlal_n_s16(vld1q_s32(acc + i + 8), vget_low_s16(hi), w));
+        vst1q_s32(acc + i + 12, vmlal_n_s16(vld1q_s32(acc + i + 12), vget_high_s16(hi), w));
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wv = _mm_set1_epi16(w);
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i halves[2] = {_mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero)};
+        for (int h = 0; h < 2; h++) {
+            // 16비트 곱의 하위/상위를 합쳐 32비트 곱
+            __m128i pl = _mm_mullo_epi16(halves[h], wv);
+            __m128i ph = _mm_mulhi_epi16(halves[h], wv);
+            __m128i *a = reinterpret_cast<__m128i *>(acc + i + h * 8);
+            _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a), _mm_unpacklo_epi16(pl, ph)));
+            _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), _mm_unpackhi_epi16(pl, ph)));
+        }
+    }
+#endif
+    for (; i < n; i++) acc[i] += w * in[i];
+}
+
+// out[i] = clamp(round(acc[i] >> RESAMPLE_BITS))
+void packRow(const int32_t *acc, uint8_t *out, size_t n) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + 8 <= n; i += 8) {
+        uint16x4_t lo = vqrshrun_n_s32(vld1q_s32(acc + i), RESAMPLE_BITS);
+        uint16x4_t hi = vqrshrun_n_s32(vld1q_s32(acc + i + 4), RESAMPLE_BITS);
+        vst1_u8(out + i, vqmovn_u16(vcombine_u16(lo, hi)));
+    }
+#elif defined(__SSE2__)
+    const __m128i round = _mm_set1_epi32(1 << (RESAMPLE_BITS - 1));
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i + 4));
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, round), RESAMPLE_BITS);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, round), RESAMPLE_BITS);
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), packed);
+    }
+#endif
+    for (; i < n; i++) out[i] = clampRound(acc[i]);
+}
+
+// 가로 패스: 출력 픽셀마다 RGB 세 채널을 한 벡터(마지막 레인은 버림)로 누적.
+// 탭마다 4(NEON 은 8)바이트를 읽으므로 in 은 행 끝 뒤로 RESAMPLE_ROW_PAD 만큼 여유가 있어야 함
+#define RESAMPLE_ROW_PAD 8
+
+void resampleRowRgb(const uint8_t *in, const Kernel &k, uint8_t *out, int dstWidth) {
+    for (int x = 0; x < dstWidth; x++) {
+        const uint8_t *p = in + (size_t) k.start[x] * 3;
+        const int16_t *w = k.weights.data() + (size_t) x * k.taps;
+        int t = 0;
+#if defined(__ARM_NEON)
+        int32x4_t acc = vdupq_n_s32(0);
+        for (; t < k.taps; t++) {
+            uint16x8_t px = vmovl_u8(vld1_u8(p + t * 3));
+            acc = vmlal_n_s16(acc, vreinterpret_s16_u16(vget_low_u16(px)), w[t]);
+        }
+        uint16x4_t px16 = vqrshrun_n_s32(acc, RESAMPLE_BITS);
+        uint8x8_t px8 = vqmovn_u16(vcombine_u16(px16, px16));
+        out[x * 3] = vget_lane_u8(px8, 0);
+        out[x * 3 + 1] = vget_lane_u8(px8, 1);
+        out[x * 3 + 2] = vget_lane_u8(px8, 2);
+#elif defined(__SSE2__)
+        // 이웃한 두 탭의 바이트를 엇갈려 펼치고 madd 로 (a*w0 + b*w1) 를 한 번에
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = zero;
+        for (; t < k.taps; t += 2) {
+            int32_t a, b = 0;
+            memcpy(&a, p + t * 3, 4);
+            int32_t wpair = (uint16_t) w[t];
+            if (t + 1 < k.taps) {
+                memcpy(&b, p + t * 3 + 3, 4);
+                wpair |= (int32_t) ((uint32_t) (uint16_t) w[t + 1] << 16);
+            }
+            __m128i ab = _mm_unpacklo_epi8(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b));
+            ab = _mm_unpacklo_epi8(ab, zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(ab, _mm_set1_epi32(wpair)));
+        }
+        acc = _mm_srai_epi32(_mm_add_epi32(acc, _mm_set1_epi32(1 << (RESAMPLE_BITS - 1))),
+                             RESAMPLE_BITS);
+        acc = _mm_packus_epi16(_mm_packs_epi32(acc, zero), zero);
+        const uint32_t rgb = (uint32_t) _mm_cvtsi128_si32(acc);
+        out[x * 3] = (uint8_t) rgb;
+        out[x * 3 + 1] = (uint8_t) (rgb >> 8);
+        out[x * 3 + 2] = (uint8_t) (rgb >> 16);
+#else
+        int32_t r = 0, g = 0, b = 0;
+        for (; t < k.taps; t++) {
+            r += w[t] * p[t * 3];
+            g += w[t] * p[t * 3 + 1];
+            b += w[t] * p[t * 3 + 2];
+        }
+        out[x * 3] = clampRound(r);
+        out[x * 3 + 1] = clampRound(g);
+        out[x * 3 + 2] = clampRound(b);
+#endif
+    }
+}
+
+} // namespace
+
+void resizeCubicRgb(const JpegImage &src, int dstWidth, int dstHeight, JpegImage &dst) {
+    dst.width = dstWidth;
+    dst.height = dstHeight;
+    dst.pixels.resize((size_t) dstWidth * dstHeight * 3);
+    if (dstWidth <= 0 || dstHeight <= 0 || src.width <= 0 || src.height <= 0) return;
+
+    Kernel kx, ky;
+    buildKernel(src.width, dstWidth, kx);
+    buildKernel(src.height, dstHeight, ky);
+
+    // 출력 행마다: 세로로 먼저 (입력 폭 전체, 탭마다 연속 행을 누적 - 분기 없는 벡터화
+    // 대상) 한 행을 만들고, 그 행을 가로로 줄인다. 중간 버퍼는 한 행뿐이라 캐시에 남는다
+    const size_t srcLen = (size_t) src.width * 3;
+    std::vector<uint8_t> column(srcLen + RESAMPLE_ROW_PAD);
+    for (int y = 0; y < dstHeight; y++) {
+        const int16_t *wy = ky.weights.data() + (size_t) y * ky.taps;
+        const uint8_t *first = src.pixels.data() + (size_t) ky.start[y] * srcLen;
+        // 누적 버퍼가 L1 에 머물도록 행을 잘라서
+        for (size_t base = 0; base < srcLen; base += RESAMPLE_CHUNK) {
+            const size_t n = std::min((size_t) RESAMPLE_CHUNK, srcLen - base);
+            int32_t acc[RESAMPLE_CHUNK] = {};
+            for (int t = 0; t < ky.taps; t++) {
+                if (wy[t] != 0) accumulateRow(acc, first + (size_t) t * srcLen + base, wy[t], n);
+            }
+            packRow(acc, column.data() + base, n);
+        }
+
+        resampleRowRgb(column.data(), kx, dst.pixels.data() + (size_t) y * dstWidth * 3,
+                       dstWidth);
+    }
+}
+
+void orientRgb(const JpegImage &src, int orientation, JpegImage &dst) {
+    if (orientation < 2 || orientation > 8) {
+        dst = src;
+        return;
+    }
+    const bool transpose = orientation >= 5;
+    const int w = src.width, h = src.height;
+    dst.width = transpose ? h : w;
+    dst.height = transpose ? w : h;
+    dst.pixels.resize(src.pixels.size());
+    for (int y = 0; y < dst.height; y++) {
+        uint8_t *out = dst.pixels.data() + (size_t) y * dst.width * 3;
+        for (int x = 0; x < dst.width; x++) {
+            // 표시 좌표 (x, y) 가 가리키는 원본 좌표
+            int sx, sy;
+            switch (orientation) {
+                case 2: sx = w - 1 - x; sy = y; break;
+                case 3: sx = w - 1 - x; sy = h - 1 - y; break;
+                case 4: sx = x; sy = h - 1 - y; break;
+                case 5: sx = y; sy = x; break;
+                case 6: sx = y; sy = h - 1 - x; break;
+                case 7: sx = w - 1 - y; sy = h - 1 - x; break;
+                default: sx = w - 1 - y; sy = x; break;
+            }
+            const uint8_t *in = src.pixels.data() + ((size_t) sy * w + sx) * 3;
+            out[x * 3] = in[0];
+            out[x * 3 + 1] = in[1];
+            out[x * 3 + 2] = in[2];
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// app/src/main/cpp/jpeg-util.h
+
+#ifndef JPEG_UTIL_H
+#define JPEG_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// 번들 libjpeg(9.x, jniLibs/<abi>/libjpeg.a) 보조 함수
+//  - 에러는 LOGE 로 남기고 false 를 돌려준다 (libjpeg 의 exit 대신 longjmp).
+//  - 디코드 결과는 RGB 3채널, 행 사이 여백 없음.
+// ----------------------------------------------------------------------------
+struct JpegImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;    // RGB (jpegDecodeLuma 는 휘도 1채널)
+};
+
+// 헤더만 읽어 원본 크기
+bool jpegReadSize(const uint8_t *data, size_t size, int &width, int &height);
+
+// 긴 변이 minEdge 이상으로 남는 가장 큰 DCT 축소 분모 (1, 2, 4, 8)
+int jpegPickScaleDenom(int width, int height, int minEdge);
+
+// scaleDenom 으로 DCT 단계에서 축소하며 디코드 (1 이면 원본 크기)
+bool jpegDecodeRgb(const uint8_t *data, size_t size, int scaleDenom, JpegImage &out);
+
+// jpegDecodeRgb 와 같지만 Y 성분만 (1채널). 색 변환/색차 디코드를 하지 않아 더 빠르다
+bool jpegDecodeLuma(const uint8_t *data, size_t size, int scaleDenom, JpegImage &out);
+
+// RGB 를 quality(1..100) 로 인코드해 out 에 (기존 내용은 지움)
+bool jpegEncodeRgb(const JpegImage &img, int quality, std::vector<uint8_t> &out);
+
+// EXIF orientation(2..8)을 DCT 계수 단계에서 되돌려 1 로 만든 JPEG 을 out 에 (무손실,
+// jpegtran 과 같은 블록 재배치). 뒤집히는 축이 MCU 배수가 아니면 그 가장자리 몇 픽셀을
+// 잘라낸다 (jpegtran -trim). APPn/COM 마커는 그대로 옮기고 EXIF 의 Orientation 은 1 로.
+bool jpegTransformOrientation(const uint8_t *data, size_t size, int orientation,
+                              std::vector<uint8_t> &out);
+
+// 면적 평균(box) 축소로 정확히 dstWidth x dstHeight 로. 확대 방향이면 가장 가까운 픽셀
+void resizeBoxRgb(const JpegImage &src, int dstWidth, int dstHeight, JpegImage &dst);
+
+// 분리형 Catmull-Rom 리샘플 (축소면 필터 폭을 배율만큼 넓혀 앨리어싱 방지).
+// 가중치는 14비트 고정소수점으로 미리 계산하고 세로 패스는 행 전체를 한 번에 누적해
+// 컴파일러가 NEON/SSE 로 벡터화할 수 있게 둔다. 가장자리에선 창을 안쪽으로 민다
+void resizeCubicRgb(const JpegImage &src, int dstWidth, int dstHeight, JpegImage &dst);
+
+// EXIF orientation(2..8)대로 픽셀을 돌려 똑바로 (그 밖의 값이면 그대로 복사)
+void orientRgb(const JpegImage &src, int orientation, JpegImage &dst);
+
+// 면적이 maxPixels 이하가 되도록 비율을 유지해 줄인 크기 (원본이 더 작으면 그대로)
+void fitArea(int width, int height, int64_t maxPixels, int &outWidth, int &outHeight);
+
+// 긴 변을 maxEdge 에 맞춘 크기 (원본이 더 작으면 그대로)
+void fitLongEdge(int width, int height, int maxEdge, int &outWidth, int &outHeight);
+
+#endif // JPEG_UTIL_H
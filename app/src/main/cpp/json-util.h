@@ -0,0 +1,47 @@
+// app/src/main/cpp/json-util.h
+
+#ifndef JSON_UTIL_H
+#define JSON_UTIL_H
+
+#include <cstdio>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// 특수 문자 이스케이프 (JSON 문자열 값)
+//  - 카메라에서 온 폴더/파일명/시리얼 등은 따옴표나 제어 문자를 담을 수 있다.
+// ----------------------------------------------------------------------------
+inline std::string escapeJsonString(const std::string &s) {
+    std::string out;
+    out.reserve(s.size() + 20);
+    for (char c: s) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(c));
+                    out += buf;
+                } else {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    return out;
+}
+
+#endif // JSON_UTIL_H
@@ -0,0 +1,395 @@
+// app/src/main/cpp/liveview-analysis.cpp
+
+#include "liveview-analysis.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static std::atomic_int gAnalysisFlags{0};
+static std::atomic_int gPeakingThreshold{LIVEVIEW_PEAKING_DEFAULT_THRESHOLD};
+
+void setLiveViewAnalysis(int flags) {
+    gAnalysisFlags.store(flags);
+}
+
+int liveViewAnalysisFlags() {
+    return gAnalysisFlags.load();
+}
+
+void setLiveViewPeakingThreshold(int threshold) {
+    gPeakingThreshold.store(threshold);
+}
+
+int liveViewPeakingThreshold() {
+    return gPeakingThreshold.load();
+}
+
+// 휘도 = (77R + 150G + 29B + 128) >> 8 (BT.601, JPEG 의 Y 와 같은 계수)
+static inline uint8_t lumaOf(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t) ((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+static inline uint8_t flagsOf(uint8_t r, uint8_t g, uint8_t b, uint8_t y) {
+    uint8_t m = r > g ? r : g;
+    m = m > b ? m : b;
+    return (uint8_t) ((m >= LIVEVIEW_CLIP_HIGH ? LIVEVIEW_CLIP_HIGHLIGHT : 0) |
+                      (y <= LIVEVIEW_CLIP_LOW ? LIVEVIEW_CLIP_SHADOW : 0));
+}
+
+#if defined(__SSSE3__) && !defined(__ARM_NEON)
+namespace {
+
+// 16 픽셀(48 바이트, 레지스터 3 개)에서 채널 하나를 모으는 pshufb 마스크
+struct DeinterleaveMasks {
+    __m128i m[3][3];    // [채널][원본 레지스터]
+
+    DeinterleaveMasks() {
+        for (int ch = 0; ch < 3; ch++) {
+            for (int v = 0; v < 3; v++) {
+                alignas(16) int8_t bytes[16];
+                for (int k = 0; k < 16; k++) {
+                    int src = 3 * k + ch;
+                    bytes[k] = src / 16 == v ? (int8_t) (src % 16) : (int8_t) 0x80;
+                }
+                m[ch][v] = _mm_load_si128(reinterpret_cast<const __m128i *>(bytes));
+            }
+        }
+    }
+};
+
+const DeinterleaveMasks gMasks;
+
+inline __m128i channel(const __m128i src[3], int ch) {
+    return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(src[0], gMasks.m[ch][0]),
+                                     _mm_shuffle_epi8(src[1], gMasks.m[ch][1])),
+                        _mm_shuffle_epi8(src[2], gMasks.m[ch][2]));
+}
+
+// 8 픽셀 (16비트) 휘도
+inline __m128i luma16(__m128i r, __m128i g, __m128i b) {
+    __m128i y = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(77)),
+                              _mm_mullo_epi16(g, _mm_set1_epi16(150)));
+    y = _mm_add_epi16(y, _mm_mullo_epi16(b, _mm_set1_epi16(29)));
+    // 합은 최대 65408 이라 부호 없는 16비트로 보고 논리 시프트
+    return _mm_srli_epi16(_mm_add_epi16(y, _mm_set1_epi16(128)), 8);
+}
+
+} // namespace
+#endif
+
+void liveViewAnalyzeRow(const uint8_t *rgb, size_t n, uint8_t *luma, uint8_t *flags) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    const uint8x8_t kr = vdup_n_u8(77), kg = vdup_n_u8(150), kb = vdup_n_u8(29);
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x3_t px = vld3q_u8(rgb + i * 3);
+        uint16x8_t lo = vmull_u8(vget_low_u8(px.val[0]), kr);
+        lo = vmlal_u8(lo, vget_low_u8(px.val[1]), kg);
+        lo = vmlal_u8(lo, vget_low_u8(px.val[2]), kb);
+        uint16x8_t hi = vmull_u8(vget_high_u8(px.val[0]), kr);
+        hi = vmlal_u8(hi, vget_high_u8(px.val[1]), kg);
+        hi = vmlal_u8(hi, vget_high_u8(px.val[2]), kb);
+        uint8x16_t y = vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+        vst1q_u8(luma + i, y);
+
+        uint8x16_t m = vmaxq_u8(vmaxq_u8(px.val[0], px.val[1]), px.val[2]);
+        uint8x16_t f = vandq_u8(vcgeq_u8(m, vdupq_n_u8(LIVEVIEW_CLIP_HIGH)),
+                                vdupq_n_u8(LIVEVIEW_CLIP_HIGHLIGHT));
+        f = vorrq_u8(f, vandq_u8(vcleq_u8(y, vdupq_n_u8(LIVEVIEW_CLIP_LOW)),
+                                 vdupq_n_u8(LIVEVIEW_CLIP_SHADOW)));
+        vst1q_u8(flags + i, f);
+    }
+#elif defined(__SSSE3__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i high = _mm_set1_epi8((char) LIVEVIEW_CLIP_HIGH);
+    const __m128i low = _mm_set1_epi8((char) LIVEVIEW_CLIP_LOW);
+    for (; i + 16 <= n; i += 16) {
+        const __m128i *p = reinterpret_cast<const __m128i *>(rgb + i * 3);
+        const __m128i src[3] = {_mm_loadu_si128(p), _mm_loadu_si128(p + 1), _mm_loadu_si128(p + 2)};
+        __m128i r = channel(src, 0), g = channel(src, 1), b = channel(src, 2);
+        __m128i yLo = luma16(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero),
+                             _mm_unpacklo_epi8(b, zero));
+        __m128i yHi = luma16(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero),
+                             _mm_unpackhi_epi8(b, zero));
+        __m128i y = _mm_packus_epi16(yLo, yHi);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(luma + i), y);
+
+        // a >= c  <=>  max(a, c) == a  (부호 없는 비교가 없어서)
+        __m128i m = _mm_max_epu8(_mm_max_epu8(r, g), b);
+        __m128i f = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(m, high), m),
+                                  _mm_set1_epi8(LIVEVIEW_CLIP_HIGHLIGHT));
+        f = _mm_or_si128(f, _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(y, low), y),
+                                          _mm_set1_epi8(LIVEVIEW_CLIP_SHADOW)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(flags + i), f);
+    }
+#endif
+    for (; i < n; i++) {
+        const uint8_t *px = rgb + i * 3;
+        luma[i] = lumaOf(px[0], px[1], px[2]);
+        flags[i] = flagsOf(px[0], px[1], px[2], luma[i]);
+    }
+}
+
+bool LiveViewAnalyzer::analyze(const uint8_t *jpeg, size_t size, LiveViewHistogram &out) {
+    int w = 0, h = 0;
+    if (!jpegReadSize(jpeg, size, w, h)) return false;
+    if (!jpegDecodeRgb(jpeg, size, jpegPickScaleDenom(w, h, LIVEVIEW_ANALYSIS_EDGE), frame_)) {
+        return false;
+    }
+    histogramOf(false, out);
+    return true;
+}
+
+bool LiveViewAnalyzer::analyzeBoth(const uint8_t *jpeg, size_t size, int threshold,
+                                   LiveViewHistogram &hist, LiveViewFocus &focus) {
+    int w = 0, h = 0;
+    if (!jpegReadSize(jpeg, size, w, h)) return false;
+    // 초점 쪽 해상도로 한 번만 디코드. 히스토그램은 픽셀이 늘 뿐 분포는 같다
+    if (!jpegDecodeRgb(jpeg, size, jpegPickScaleDenom(w, h, LIVEVIEW_FOCUS_EDGE), frame_)) {
+        return false;
+    }
+    histogramOf(true, hist);
+    focusOf(threshold, focus);
+    return true;
+}
+
+// frame_ 에서. keepLuma 면 휘도 평면을 gray_ 에 남겨 focusOf 가 쓴다
+void LiveViewAnalyzer::histogramOf(bool keepLuma, LiveViewHistogram &out) {
+    const int width = frame_.width, height = frame_.height;
+    luma_.resize(width);
+    if (keepLuma) {
+        gray_.width = width;
+        gray_.height = height;
+        gray_.pixels.resize((size_t) width * height);
+    }
+    flags_.resize(width);
+    if (cellOfColumn_.size() != (size_t) width) {
+        cellOfColumn_.resize(width);
+        for (int x = 0; x < width; x++) {
+            cellOfColumn_[x] = (uint8_t) ((int64_t) x * LIVEVIEW_CLIP_GRID_W / width);
+        }
+    }
+
+    // 4 벌로 나눠 누적 (바로 앞 픽셀과 같은 칸이어도 서로 기다리지 않게)
+    static_assert(LIVEVIEW_HIST_BINS == 256, "8비트 채널");
+    uint32_t hist[4][4][LIVEVIEW_HIST_BINS];
+    memset(hist, 0, sizeof(hist));
+    uint32_t cellHigh[LIVEVIEW_CLIP_GRID_W * LIVEVIEW_CLIP_GRID_H] = {};
+    uint32_t cellLow[LIVEVIEW_CLIP_GRID_W * LIVEVIEW_CLIP_GRID_H] = {};
+    uint32_t cellPixels[LIVEVIEW_CLIP_GRID_W * LIVEVIEW_CLIP_GRID_H] = {};
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t *row = frame_.pixels.data() + (size_t) y * width * 3;
+        uint8_t *luma = keepLuma ? gray_.pixels.data() + (size_t) y * width : luma_.data();
+        liveViewAnalyzeRow(row, width, luma, flags_.data());
+
+        const int cellRow = (int) ((int64_t) y * LIVEVIEW_CLIP_GRID_H / height) * LIVEVIEW_CLIP_GRID_W;
+        for (int x = 0; x < width; x++) {
+            uint32_t (*hs)[LIVEVIEW_HIST_BINS] = hist[x & 3];
+            hs[0][row[x * 3]]++;
+            hs[1][row[x * 3 + 1]]++;
+            hs[2][row[x * 3 + 2]]++;
+            hs[3][luma[x]]++;
+            const int cell = cellRow + cellOfColumn_[x];
+            cellPixels[cell]++;
+            cellHigh[cell] += flags_[x] & LIVEVIEW_CLIP_HIGHLIGHT;
+            cellLow[cell] += flags_[x] >> 1;
+        }
+    }
+
+    for (int c = 0; c < 4; c++) {
+        for (int v = 0; v < LIVEVIEW_HIST_BINS; v++) {
+            out.bins[c * LIVEVIEW_HIST_BINS + v] = hist[0][c][v] + hist[1][c][v] + hist[2][c][v] +
+                                                   hist[3][c][v];
+        }
+    }
+    out.highlightPixels = out.shadowPixels = 0;
+    for (int i = 0; i < LIVEVIEW_CLIP_GRID_W * LIVEVIEW_CLIP_GRID_H; i++) {
+        out.highlightPixels += cellHigh[i];
+        out.shadowPixels += cellLow[i];
+        uint32_t limit = cellPixels[i] * LIVEVIEW_CLIP_CELL_PERCENT;
+        out.clip[i] = (uint8_t) ((cellPixels[i] > 0 && cellHigh[i] * 100 >= limit
+                                  ? LIVEVIEW_CLIP_HIGHLIGHT : 0) |
+                                 (cellPixels[i] > 0 && cellLow[i] * 100 >= limit
+                                  ? LIVEVIEW_CLIP_SHADOW : 0));
+    }
+    out.pixels = (uint32_t) width * height;
+    out.width = width;
+    out.height = height;
+}
+
+// ----------------------------------------------------------------------------
+// 초점 (Sobel)
+// ----------------------------------------------------------------------------
+int liveViewSobelRow(const uint8_t *above, const uint8_t *row, const uint8_t *below, int width,
+                     int threshold, int16_t *magnitude, uint8_t *mask) {
+    if (width <= 0) return 0;
+    // 크기는 최대 2040 이라 그 위 기준은 아무것도 표시하지 않는 것과 같다
+    const int16_t thr = (int16_t) std::min(std::max(threshold, 1), 2041);
+    magnitude[0] = 0;
+    mask[0] = 0;
+    int peaks = 0;
+    int x = 1;
+#if defined(__ARM_NEON)
+    // 세로 가중합 v = a + 2b + c (gx 용), 가로 가중합 h = l + 2c + r (gy 용)를 8 픽셀씩
+    const int16x8_t vThr = vdupq_n_s16(thr);
+    uint16x8_t count = vdupq_n_u16(0);
+    for (; x + 9 <= width; x += 8) {
+        uint8x8_t al = vld1_u8(above + x - 1), ac = vld1_u8(above + x), ar = vld1_u8(above + x + 1);
+        uint8x8_t bl = vld1_u8(row + x - 1), br = vld1_u8(row + x + 1);
+        uint8x8_t cl = vld1_u8(below + x - 1), cc = vld1_u8(below + x), cr = vld1_u8(below + x + 1);
+        uint16x8_t left = vaddq_u16(vaddl_u8(al, cl), vshll_n_u8(bl, 1));
+        uint16x8_t right = vaddq_u16(vaddl_u8(ar, cr), vshll_n_u8(br, 1));
+        uint16x8_t top = vaddq_u16(vaddl_u8(al, ar), vshll_n_u8(ac, 1));
+        uint16x8_t bottom = vaddq_u16(vaddl_u8(cl, cr), vshll_n_u8(cc, 1));
+        int16x8_t gx = vsubq_s16(vreinterpretq_s16_u16(right), vreinterpretq_s16_u16(left));
+        int16x8_t gy = vsubq_s16(vreinterpretq_s16_u16(bottom), vreinterpretq_s16_u16(top));
+        int16x8_t m = vaddq_s16(vabsq_s16(gx), vabsq_s16(gy));
+        vst1q_s16(magnitude + x, m);
+        uint16x8_t on = vcgeq_s16(m, vThr);
+        vst1_u8(mask + x, vmovn_u16(on));
+        count = vsubq_u16(count, on);       // on = 0xFFFF(-1)
+    }
+    uint16_t lanes[8];
+    vst1q_u16(lanes, count);
+    for (uint16_t c: lanes) peaks += c;
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vThr = _mm_set1_epi16((int16_t) (thr - 1));
+    __m128i count = zero;
+    for (; x + 9 <= width; x += 8) {
+        auto load = [zero](const uint8_t *p) {
+            return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), zero);
+        };
+        __m128i al = load(above + x - 1), ac = load(above + x), ar = load(above + x + 1);
+        __m128i bl = load(row + x - 1), br = load(row + x + 1);
+        __m128i cl = load(below + x - 1), cc = load(below + x), cr = load(below + x + 1);
+        __m128i left = _mm_add_epi16(_mm_add_epi16(al, cl), _mm_slli_epi16(bl, 1));
+        __m128i right = _mm_add_epi16(_mm_add_epi16(ar, cr), _mm_slli_epi16(br, 1));
+        __m128i top = _mm_add_epi16(_mm_add_epi16(al, ar), _mm_slli_epi16(ac, 1));
+        __m128i bottom = _mm_add_epi16(_mm_add_epi16(cl, cr), _mm_slli_epi16(cc, 1));
+        __m128i gx = _mm_sub_epi16(right, left);
+        __m128i gy = _mm_sub_epi16(bottom, top);
+        // SSE2 에는 abs 가 없어 max(v, -v)
+        __m128i m = _mm_add_epi16(_mm_max_epi16(gx, _mm_sub_epi16(zero, gx)),
+                                  _mm_max_epi16(gy, _mm_sub_epi16(zero, gy)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(magnitude + x), m);
+        __m128i on = _mm_cmpgt_epi16(m, vThr);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(mask + x), _mm_packs_epi16(on, on));
+        count = _mm_sub_epi16(count, on);
+    }
+    alignas(16) uint16_t lanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), count);
+    for (uint16_t c: lanes) peaks += c;
+#endif
+    for (; x < width - 1; x++) {
+        int gx = (above[x + 1] + 2 * row[x + 1] + below[x + 1]) -
+                 (above[x - 1] + 2 * row[x - 1] + below[x - 1]);
+        int gy = (below[x - 1] + 2 * below[x] + below[x + 1]) -
+                 (above[x - 1] + 2 * above[x] + above[x + 1]);
+        int m = abs(gx) + abs(gy);
+        magnitude[x] = (int16_t) m;
+        mask[x] = m >= thr ? 255 : 0;
+        peaks += m >= thr;
+    }
+    if (width > 1) {
+        magnitude[width - 1] = 0;
+        mask[width - 1] = 0;
+    }
+    return peaks;
+}
+
+// 크기 제곱합. 32비트 칸에 쌓다가 넘치기 전에(2040^2 x 256 < 2^31) 64비트로 옮긴다
+static uint64_t sumSquares(const int16_t *v, int n) {
+    uint64_t total = 0;
+    int i = 0;
+#if defined(__ARM_NEON)
+    while (i + 8 <= n) {
+        uint32x4_t acc = vdupq_n_u32(0);
+        for (int end = std::min(n, i + 1024); i + 8 <= end; i += 8) {
+            uint16x8_t m = vreinterpretq_u16_s16(vld1q_s16(v + i));
+            acc = vmlal_u16(acc, vget_low_u16(m), vget_low_u16(m));
+            acc = vmlal_u16(acc, vget_high_u16(m), vget_high_u16(m));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, acc);
+        total += (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+#elif defined(__SSE2__)
+    while (i + 8 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        for (int end = std::min(n, i + 1024); i + 8 <= end; i += 8) {
+            __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(v + i));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(m, m));
+        }
+        alignas(16) uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        total += (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+    for (; i < n; i++) total += (uint32_t) (v[i] * v[i]);
+    return total;
+}
+
+bool LiveViewAnalyzer::analyzeFocus(const uint8_t *jpeg, size_t size, int threshold,
+                                    LiveViewFocus &out) {
+    int w = 0, h = 0;
+    if (!jpegReadSize(jpeg, size, w, h)) return false;
+    if (!jpegDecodeLuma(jpeg, size, jpegPickScaleDenom(w, h, LIVEVIEW_FOCUS_EDGE), gray_)) {
+        return false;
+    }
+    focusOf(threshold, out);
+    return true;
+}
+
+// gray_ (휘도 평면) 에서
+void LiveViewAnalyzer::focusOf(int threshold, LiveViewFocus &out) {
+    const int width = gray_.width, height = gray_.height;
+    magnitude_.resize(width);
+    peak_.assign((size_t) width * height, 0);
+
+    const int cells = LIVEVIEW_FOCUS_GRID_W * LIVEVIEW_FOCUS_GRID_H;
+    uint64_t cellSum[cells] = {};
+    uint32_t cellCount[cells] = {};
+    int columnStart[LIVEVIEW_FOCUS_GRID_W + 1];
+    for (int c = 0; c <= LIVEVIEW_FOCUS_GRID_W; c++) {
+        columnStart[c] = (int) ((int64_t) c * width / LIVEVIEW_FOCUS_GRID_W);
+    }
+
+    uint32_t peaks = 0;
+    const uint8_t *luma = gray_.pixels.data();
+    for (int y = 1; y + 1 < height; y++) {
+        const uint8_t *row = luma + (size_t) y * width;
+        peaks += liveViewSobelRow(row - width, row, row + width, width, threshold,
+                                  magnitude_.data(), peak_.data() + (size_t) y * width);
+
+        const int cellRow = (int) ((int64_t) y * LIVEVIEW_FOCUS_GRID_H / height) * LIVEVIEW_FOCUS_GRID_W;
+        for (int c = 0; c < LIVEVIEW_FOCUS_GRID_W; c++) {
+            const int n = columnStart[c + 1] - columnStart[c];
+            cellSum[cellRow + c] += sumSquares(magnitude_.data() + columnStart[c], n);
+            cellCount[cellRow + c] += n;
+        }
+    }
+
+    uint64_t total = 0, counted = 0;
+    for (int i = 0; i < cells; i++) {
+        out.regions[i] = cellCount[i] > 0 ? (float) std::sqrt((double) cellSum[i] / cellCount[i]) : 0.f;
+        total += cellSum[i];
+        counted += cellCount[i];
+    }
+    out.sharpness = counted > 0 ? (float) std::sqrt((double) total / counted) : 0.f;
+    out.peakPixels = peaks;
+    out.width = width;
+    out.height = height;
+}
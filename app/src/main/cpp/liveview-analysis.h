@@ -0,0 +1,103 @@
+// app/src/main/cpp/liveview-analysis.h
+
+#ifndef LIVEVIEW_ANALYSIS_H
+#define LIVEVIEW_ANALYSIS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "jpeg-util.h"
+
+// setLiveViewAnalysis 플래그
+#define LIVEVIEW_ANALYZE_HISTOGRAM 1
+#define LIVEVIEW_ANALYZE_FOCUS 2
+
+// 분석은 DCT 축소 디코드로 긴 변이 이만큼 남게 (분포/클리핑 판단에는 충분)
+#define LIVEVIEW_ANALYSIS_EDGE 640
+
+#define LIVEVIEW_HIST_BINS 256
+#define LIVEVIEW_CLIP_GRID_W 32
+#define LIVEVIEW_CLIP_GRID_H 24
+#define LIVEVIEW_CLIP_HIGH 250          // R/G/B 중 하나라도 이 이상이면 하이라이트 클리핑
+#define LIVEVIEW_CLIP_LOW 5             // 휘도가 이 이하면 섀도 클리핑
+#define LIVEVIEW_CLIP_CELL_PERCENT 2    // 칸 안 클리핑 픽셀이 이 비율 이상이면 표시
+
+// 격자 칸 값
+#define LIVEVIEW_CLIP_HIGHLIGHT 1
+#define LIVEVIEW_CLIP_SHADOW 2
+
+// 초점 분석은 긴 변이 이 이상 남도록만 DCT 축소 (보통 미리보기는 원본 해상도 그대로)
+#define LIVEVIEW_FOCUS_EDGE 1280
+#define LIVEVIEW_FOCUS_GRID_W 8
+#define LIVEVIEW_FOCUS_GRID_H 6
+// 피킹 기준: Sobel |gx| + |gy| (0..2040). 대비 255 의 선명한 경계가 1020
+#define LIVEVIEW_PEAKING_DEFAULT_THRESHOLD 160
+
+// ----------------------------------------------------------------------------
+// 라이브뷰 프레임 분석 (라이브뷰 스레드에서 프레임마다)
+//  - JPEG 프레임을 한 번 디코드해 R/G/B/휘도(BT.601) 히스토그램과 클리핑 격자를
+//    만든다. 결과는 고정 크기 배열이라 Kotlin 쪽에서 프레임을 다시 디코드하지 않는다.
+//  - 행 단위 커널(휘도 + 클리핑 플래그)은 arm64 NEON / x86 SSSE3 / 이식용 C 세 갈래.
+//    히스토그램 누적은 흩어 쓰기라 4 벌로 나눠 같은 칸 연속 증가의 지연을 숨긴다.
+//  - 초점: 휘도만 디코드해 3x3 Sobel 크기 |gx| + |gy| 를 구한다. 기준 이상인 픽셀은
+//    피킹 마스크(255), 선명도는 크기의 RMS (프레임 전체와 8x6 격자). 같은 장면에서
+//    값이 클수록 초점이 맞은 것이라 절대값보다 프레임 사이 변화로 본다.
+//  - 디코드/작업 버퍼는 객체에 남겨 프레임마다 다시 잡지 않는다.
+// ----------------------------------------------------------------------------
+void setLiveViewAnalysis(int flags);
+int liveViewAnalysisFlags();
+void setLiveViewPeakingThreshold(int threshold);
+int liveViewPeakingThreshold();
+
+struct LiveViewHistogram {
+    uint32_t bins[4 * LIVEVIEW_HIST_BINS];              // R, G, B, 휘도 순
+    uint8_t clip[LIVEVIEW_CLIP_GRID_W * LIVEVIEW_CLIP_GRID_H];
+    uint32_t pixels;
+    uint32_t highlightPixels;
+    uint32_t shadowPixels;
+    int width;                                          // 분석한 크기 (축소 디코드 후)
+    int height;
+};
+
+// 행 커널: rgb 픽셀 n 개 -> 휘도와 플래그 (LIVEVIEW_CLIP_HIGHLIGHT | LIVEVIEW_CLIP_SHADOW)
+void liveViewAnalyzeRow(const uint8_t *rgb, size_t n, uint8_t *luma, uint8_t *flags);
+
+struct LiveViewFocus {
+    float sharpness;                                    // 프레임 전체 RMS
+    float regions[LIVEVIEW_FOCUS_GRID_W * LIVEVIEW_FOCUS_GRID_H];  // 행 우선
+    uint32_t peakPixels;
+    int width;                                          // 마스크 크기
+    int height;
+};
+
+// Sobel 행 커널: 세 행(위/가운데/아래)에서 가운데 행의 크기와 마스크 (양 끝 픽셀은 0).
+// 피킹 픽셀 수
+int liveViewSobelRow(const uint8_t *above, const uint8_t *row, const uint8_t *below, int width,
+                      int threshold, int16_t *magnitude, uint8_t *mask);
+
+class LiveViewAnalyzer {
+public:
+    bool analyze(const uint8_t *jpeg, size_t size, LiveViewHistogram &out);
+    bool analyzeFocus(const uint8_t *jpeg, size_t size, int threshold, LiveViewFocus &out);
+    // 둘 다 켜졌을 때: RGB 를 초점 해상도로 한 번만 디코드하고 휘도 평면을 같이 쓴다
+    bool analyzeBoth(const uint8_t *jpeg, size_t size, int threshold, LiveViewHistogram &hist,
+                     LiveViewFocus &focus);
+
+    // 마지막 analyzeFocus 의 피킹 마스크 (width x height, 0 또는 255)
+    const std::vector<uint8_t> &peakMask() const { return peak_; }
+
+private:
+    void histogramOf(bool keepLuma, LiveViewHistogram &out);
+    void focusOf(int threshold, LiveViewFocus &out);
+
+    JpegImage frame_;
+    std::vector<uint8_t> luma_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint8_t> cellOfColumn_;
+
+    JpegImage gray_;
+    std::vector<int16_t> magnitude_;
+    std::vector<uint8_t> peak_;
+};
+
+#endif // LIVEVIEW_ANALYSIS_H
@@ -6,10 +6,15 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <vector>
+#include <sys/stat.h>
 
 // --- gPhoto2 헤더 ---
 #include <gphoto2/gphoto2.h>
@@ -22,32 +27,62 @@
 #include <gphoto2/gphoto2-widget.h>
 #include <gphoto2/gphoto2-list.h>
 
-#ifndef TAG
-#define TAG "CameraNative"
-#endif
-
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
+#include "abilities-cache.h"
+#include "bulk-import.h"
+#include "camera-index.h"
+#include "camera-presets.h"
+#include "camera-session.h"
+#include "camlib-select.h"
+#include "config-schema-cache.h"
+#include "connection-state.h"
+#include "content-hash.h"
+#include "cpu-pool.h"
+#include "download-journal.h"
+#include "exif-index.h"
+#include "imported-index.h"
+#include "jpeg-util.h"
+#include "json-util.h"
+#include "liveview-analysis.h"
+#include "native-log.h"
+#include "photo-export.h"
+#include "photo-orientation.h"
+#include "photo-store.h"
+#include "photo-thumbnail.h"
+#include "raw-preview.h"
+#include "startup-timeline.h"
+#include "sync-trigger.h"
+#include "thumbnail-cache.h"
+#include "widget-index.h"
 
 // ----------------------------------------------------------------------------
 // 전역/공유 자원
 // ----------------------------------------------------------------------------
-static std::mutex cameraMutex;
-static GPContext *context = nullptr;
-static Camera *camera = nullptr;
+// 기존 단일 카메라 API 는 레지스트리의 기본 세션(핸들 0)을 그대로 쓴다.
+// (추가 카메라는 openSession 으로 받은 핸들의 세션에서 독립적으로 동작)
+static CameraSession &primarySession = SessionRegistry::instance().primary();
+static std::mutex &cameraMutex = primarySession.mutex;
+static GPContext *&context = primarySession.context;
+static Camera *&camera = primarySession.camera;
 static JavaVM *gJvm = nullptr;
 
-// 이벤트 리스너 관련
-static std::atomic_bool eventListenerRunning(false);
-static std::thread eventListenerThread;
-static std::mutex eventCvMtx;
-static std::condition_variable eventCv;
+// 앱 저장소 경로 (Java 에서 setStorageDir 로 덮어씀)
+static std::string storageDir = "/data/data/com.inik.phototest2/files";
+
+// 기본 세션의 config 스냅샷 / 기종별 스키마 캐시 (cameraMutex 로 보호)
+static ConfigSnapshot &configSnapshot = primarySession.config;
+static ConfigSchemaCache schemaCache;
+static PresetStore presetStore;
+
+// 연결 시간 프로파일 (자체 락 보유)
+static StartupTimeline startupTimeline;
 
-// 라이브뷰 관련
-static std::atomic_bool liveViewRunning(false);
-static std::thread liveViewThread;
-static jobject gCallback = nullptr;
-static std::atomic_bool captureRequested(false);
+// 기본 세션 연결 상태 (원자 변수, 락 없이 조회) + 모든 세션을 도는 probe 스레드
+static ConnectionState &connectionState = primarySession.connection;
+static std::atomic_bool healthProbeRunning(false);
+static std::thread healthProbeThread;
+static std::mutex healthProbeMtx;
+static std::condition_variable healthProbeCv;
+static std::mutex healthProbeLifeMtx;     // start/stop 직렬화 (healthProbeThread 대입/join)
 
 // gPhoto2에 공식 정의되지 않은 확장 상수 (사용자 임의 정의)
 #ifndef GP_ERROR_IO_IN_PROGRESS
@@ -83,39 +118,54 @@ static void error_callback(GPContext *context, const char *str, void *data) {
 }
 
 // ----------------------------------------------------------------------------
-// 간단 라이브뷰 지원 체크 (liveviewsize 위젯 존재 여부로 가정)
+// config 스냅샷 다시 읽기 / 확보 (cameraMutex 보유 상태에서 호출)
+//  - 연결 후 첫 config 읽기는 연결 타임라인에 기록
 // ----------------------------------------------------------------------------
-static bool checkLiveViewSupport(Camera *cam, GPContext *ctx) {
-    CameraWidget *config = nullptr;
-    int ret = gp_camera_get_config(cam, &config, ctx);
-    if (ret < GP_OK || !config) return false;
+static int reloadConfigSnapshot(Camera *cam, GPContext *ctx) {
+    auto t0 = StartupTimeline::Clock::now();
+    int ret = configSnapshot.load(cam, ctx);
+    connectionState.noteResult(ret);
+    if (ret == GP_OK) {
+        startupTimeline.recordOnce("first_config", t0, StartupTimeline::Clock::now(), ret);
+    }
+    return ret;
+}
 
-    CameraWidget *lvWidget = nullptr;
-    ret = gp_widget_get_child_by_name(config, "liveviewsize", &lvWidget);
-    gp_widget_free(config);
+static int ensureConfigSnapshot(Camera *cam, GPContext *ctx) {
+    if (configSnapshot.valid()) return GP_OK;
+    return reloadConfigSnapshot(cam, ctx);
+}
 
-    return (ret >= GP_OK && lvWidget != nullptr);
+// 현재값을 믿어야 하는 곳(프리셋 저장/적용): 낡았다고 표시됐으면 트리를 한 번에 다시 읽는다
+static int ensureFreshConfigSnapshot(Camera *cam, GPContext *ctx) {
+    if (configSnapshot.fresh()) return GP_OK;
+    return reloadConfigSnapshot(cam, ctx);
 }
 
 // ----------------------------------------------------------------------------
-// 특수 문자 이스케이프 (JSON)
-static std::string escapeJsonString(const std::string &s) {
-    std::string out;
-    out.reserve(s.size() + 20);
-    for (char c: s) {
-        switch (c) {
-            case '\\':
-                out += "\\\\";
-                break;
-            case '\"':
-                out += "\\\"";
-                break;
-            default:
-                out.push_back(c);
-                break;
-        }
-    }
-    return out;
+// 스키마 캐시 키 설정 (기종 + VID/PID + 펌웨어, cameraMutex 보유 상태에서 호출)
+// ----------------------------------------------------------------------------
+static void setSchemaKey(Camera *cam, const char *summary) {
+    CameraAbilities abilities;
+    if (gp_camera_get_abilities(cam, &abilities) < GP_OK) return;
+    schemaCache.setKey(abilities, summary);
+}
+
+static bool ensureSchemaKey(Camera *cam, GPContext *ctx) {
+    if (schemaCache.hasKey()) return true;
+
+    CameraText txt;
+    int ret = gp_camera_get_summary(cam, &txt, ctx);
+    setSchemaKey(cam, ret >= GP_OK ? txt.text : nullptr);
+    return schemaCache.hasKey();
+}
+
+// ----------------------------------------------------------------------------
+// 간단 라이브뷰 지원 체크 (liveviewsize 위젯 존재 여부로 가정)
+// ----------------------------------------------------------------------------
+static bool checkLiveViewSupport(Camera *cam, GPContext *ctx) {
+    if (ensureConfigSnapshot(cam, ctx) < GP_OK) return false;
+    return configSnapshot.widget("liveviewsize") != nullptr;
 }
 
 // ----------------------------------------------------------------------------
@@ -195,20 +245,276 @@ static std::string buildWidgetJson(CameraWidget *widget) {
     return oss.str();
 }
 
+// ----------------------------------------------------------------------------
+// 위젯 현재값만 {"name":"value",...} 로 변환 (스키마 캐시와 짝)
+// ----------------------------------------------------------------------------
+static std::string buildWidgetValuesJson(const WidgetIndex &index) {
+    std::ostringstream oss;
+    oss << "{";
+    bool first = true;
+    for (const WidgetNode &n: index.nodes()) {
+        if (n.name.empty()) continue;
+        // 같은 이름이 여럿이면 인덱스가 가리키는 첫 번째만
+        if (index.findByName(n.name.c_str()) != &n) continue;
+
+        std::string value;
+        if (!widgetValueToString(n.widget, value)) continue;
+
+        if (!first) oss << ",";
+        oss << "\"" << escapeJsonString(n.name) << "\":\"" << escapeJsonString(value) << "\"";
+        first = false;
+    }
+    oss << "}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// Java String[] -> std::vector<std::string>
+// ----------------------------------------------------------------------------
+static std::vector<std::string> toStringVector(JNIEnv *env, jobjectArray arr) {
+    std::vector<std::string> out;
+    if (!arr) return out;
+    jsize n = env->GetArrayLength(arr);
+    out.reserve(n);
+    for (jsize i = 0; i < n; i++) {
+        jstring js = static_cast<jstring>(env->GetObjectArrayElement(arr, i));
+        const char *c = js ? env->GetStringUTFChars(js, nullptr) : nullptr;
+        out.emplace_back(c ? c : "");
+        if (c) env->ReleaseStringUTFChars(js, c);
+        if (js) env->DeleteLocalRef(js);
+    }
+    return out;
+}
+
 // ----------------------------------------------------------------------------
 // JNI_OnLoad
 // ----------------------------------------------------------------------------
 extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *) {
     gJvm = vm;
+    startupTimeline.markProcessLoad();
     context = gp_context_new();
 
     gp_context_set_message_func(context, message_callback, nullptr);
     gp_context_set_error_func(context, error_callback, nullptr);
+    schemaCache.setDirectory(storageDir);
+    presetStore.setFile(storageDir + "/camera_presets.txt");
+    presetStore.load();
+    AbilitiesCache::instance().setDiskDirectory(storageDir);
+    DownloadJournal::instance().open(storageDir + "/download_journal.bin");
+    ImportedIndex::instance().open(storageDir + "/imported_index.bin");
+    ThumbnailCache::instance().setDirectory(storageDir + "/thumbs");
+    PhotoStore::instance().open(storageDir);
 
     LOGD("JNI_OnLoad -> gJvm=%p, gp_context_new 완료", gJvm);
     return JNI_VERSION_1_6;
 }
 
+// ----------------------------------------------------------------------------
+// 앱 저장소 경로 설정 (캐시/인덱스 파일 위치)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setStorageDir(JNIEnv *env, jobject, jstring dir_) {
+    const char *dir = env->GetStringUTFChars(dir_, nullptr);
+    LOGD("setStorageDir: %s", dir);
+
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    storageDir = dir;
+    schemaCache.setDirectory(storageDir);
+    presetStore.setFile(storageDir + "/camera_presets.txt");
+    presetStore.load();
+    AbilitiesCache::instance().setDiskDirectory(storageDir);
+    DownloadJournal::instance().open(storageDir + "/download_journal.bin");
+    ImportedIndex::instance().open(storageDir + "/imported_index.bin");
+    ThumbnailCache::instance().setDirectory(storageDir + "/thumbs");
+    PhotoStore::instance().open(storageDir);
+
+    env->ReleaseStringUTFChars(dir_, dir);
+}
+
+// 보관용 SHA-256 을 다운로드 중에 같이 계산 (<파일>.sha256 을 옆에 남김)
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setArchivalHashEnabled(JNIEnv *, jobject, jboolean enabled) {
+    setContentSha256Enabled(enabled == JNI_TRUE);
+}
+
+// ----------------------------------------------------------------------------
+// 사진 저장소 (예산 + LRU, 동기화 전 파일 고정)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setPhotoStoreLimits(JNIEnv *, jobject, jint budgetMb,
+                                                          jboolean pinNewFiles) {
+    uint64_t mb = budgetMb > 0 ? (uint64_t) budgetMb : PHOTO_STORE_DEFAULT_MB;
+    PhotoStore::instance().setLimits(mb * 1024 * 1024, pinNewFiles == JNI_TRUE);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_touchPhoto(JNIEnv *env, jobject, jstring path_) {
+    const char *path = env->GetStringUTFChars(path_, nullptr);
+    bool ok = PhotoStore::instance().touch(path);
+    env->ReleaseStringUTFChars(path_, path);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_setPhotoSynced(JNIEnv *env, jobject, jstring path_,
+                                                     jboolean synced) {
+    const char *path = env->GetStringUTFChars(path_, nullptr);
+    bool ok = PhotoStore::instance().setSynced(path, synced == JNI_TRUE);
+    env->ReleaseStringUTFChars(path_, path);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+// 백그라운드 전환 때: 예산까지 지우고 인덱스 저장
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_trimPhotoStore(JNIEnv *, jobject) {
+    return PhotoStore::instance().trim();
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getPhotoStoreStatsJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(PhotoStore::instance().statsJson().c_str());
+}
+
+// ----------------------------------------------------------------------------
+// 연결 상태 health probe
+//  - 열린 모든 세션을 돌며, 최근 HEALTH_PROBE_IDLE_MS 동안 성공한 동작이 없는
+//    세션에만 가벼운 PTP 요청(storage 정보)을 보내 상태를 갱신한다.
+//  - 라이브뷰/이벤트 처리 중에는 그 결과로 충분하므로 세션 mutex 를 try_lock 으로만
+//    잡는다. 그래서 세션 mutex 를 쥔 채로 stopHealthProbe() 를 불러도 교착되지 않는다.
+// ----------------------------------------------------------------------------
+#define HEALTH_PROBE_INTERVAL_MS 1000
+#define HEALTH_PROBE_IDLE_MS 3000
+
+static void healthProbeLoop() {
+    while (healthProbeRunning.load()) {
+        {
+            std::unique_lock<std::mutex> lk(healthProbeMtx);
+            healthProbeCv.wait_for(lk, std::chrono::milliseconds(HEALTH_PROBE_INTERVAL_MS),
+                                   [] { return !healthProbeRunning.load(); });
+        }
+        if (!healthProbeRunning.load()) break;
+
+        for (const auto &s: SessionRegistry::instance().all()) {
+            if (!s->connection.isConnected() || s->connection.idleMs() < HEALTH_PROBE_IDLE_MS) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(s->mutex, std::try_to_lock);
+            if (!lock.owns_lock() || !s->camera) continue;
+
+            CameraStorageInformation *si = nullptr;
+            int n = 0;
+            int ret = gp_camera_get_storageinfo(s->camera, &si, &n, s->context);
+            free(si);
+            s->connection.noteResult(ret);
+        }
+    }
+}
+
+// 세션 열기(openMutex 보유)와 닫기(락 없음)에서 동시에 불릴 수 있어 healthProbeLifeMtx 로
+// 묶는다. probe 스레드는 이 락을 잡지 않으므로 쥔 채로 join 해도 된다.
+static void startHealthProbe() {
+    std::lock_guard<std::mutex> life(healthProbeLifeMtx);
+    if (healthProbeRunning.load()) return;
+    if (healthProbeThread.joinable()) healthProbeThread.join();
+    healthProbeRunning.store(true);
+    healthProbeThread = std::thread(healthProbeLoop);
+}
+
+static void stopHealthProbe() {
+    std::lock_guard<std::mutex> life(healthProbeLifeMtx);
+    {
+        std::lock_guard<std::mutex> lk(healthProbeMtx);
+        healthProbeRunning.store(false);
+    }
+    healthProbeCv.notify_all();
+    if (healthProbeThread.joinable()) healthProbeThread.join();
+}
+
+// self 외에 열린 세션이 남아 있는지 (probe 를 계속 돌릴지 판단)
+static bool otherSessionOpen(const CameraSession &self) {
+    for (const auto &s: SessionRegistry::instance().all()) {
+        if (s.get() == &self) continue;
+        if (s->connection.state() != ConnectionState::DISCONNECTED) return true;
+    }
+    return false;
+}
+
+// "모델 @ 포트" - detectCamera 가 autodetect 없이 돌려줄 설명 (세션 mutex 보유 상태)
+static std::string describeCameraLocked(CameraSession &s) {
+    CameraAbilities abilities;
+    GPPortInfo info;
+    char *path = nullptr;
+    std::string desc = "Unknown";
+    if (gp_camera_get_abilities(s.camera, &abilities) >= GP_OK) desc = abilities.model;
+    if (gp_camera_get_port_info(s.camera, &info) >= GP_OK) gp_port_info_get_path(info, &path);
+    return desc + " @ " + (path ? path : "Unknown");
+}
+
+static void startReconnectSupervisor();
+
+// 초기화 성공 후 연결 상태 추적 시작 (세션 mutex 보유 상태)
+static void onSessionOpenedLocked(CameraSession &s) {
+    // autodetect 경로는 VID/PID 를 모르므로 abilities 값으로 채운다 (범용 PTP 면 0)
+    CameraAbilities abilities;
+    if (s.usbVendor == 0 && gp_camera_get_abilities(s.camera, &abilities) >= GP_OK) {
+        s.usbVendor = abilities.usb_vendor;
+        s.usbProduct = abilities.usb_product;
+    }
+    s.connection.onOpened(describeCameraLocked(s));
+    startHealthProbe();
+    startReconnectSupervisor();
+}
+
+// ----------------------------------------------------------------------------
+// 카메라 초기화 공통 보조 함수
+// ----------------------------------------------------------------------------
+// 환경변수 설정 (libgphoto2 camlibs/iolibs)
+static void setCamlibEnv(const char *libDir) {
+    setenv("CAMLIBS", libDir, 1);
+    setenv("IOLIBS", libDir, 1);
+    setenv("CAMLIBS_PREFIX", "libgphoto2_camlib_", 1);
+    setenv("IOLIBS_PREFIX", "libgphoto2_port_iolib_", 1);
+}
+
+// 세션의 기존 카메라 해제 (세션 mutex 보유 상태에서 호출)
+//  - keepCache: 같은 카메라 재연결이면 config 스냅샷과 스키마 캐시 키를 그대로 둔다
+static void releaseSessionLocked(CameraSession &s, bool keepCache) {
+    if (!otherSessionOpen(s)) stopHealthProbe();
+    s.connection.onClosed();
+    if (!keepCache) {
+        s.serial.clear();
+        s.fileIndex.clear();
+        s.config.reset();
+        if (&s == &primarySession) schemaCache.clearKey();
+    } else {
+        // 끊긴 동안 본체에서 바꿨을 수 있다
+        s.config.markStale();
+    }
+    if (s.camera) {
+        gp_camera_exit(s.camera, s.context);
+        gp_camera_free(s.camera);
+        s.camera = nullptr;
+    }
+}
+
+// 썸네일 선읽기 정지 (명령 큐에 올려 둔 것까지 끝날 때까지 대기, 세션 mutex 미보유 상태)
+static void stopThumbnailPump(CameraSession &s) {
+    std::lock_guard<std::mutex> life(s.lifecycle);
+    s.thumbs.stop();
+    if (s.thumbThread.joinable()) s.thumbThread.join();
+    s.thumbsRunning.store(false);
+}
+
+// 진행 중인 파일 색인을 취소하고 스레드 종료를 기다린다 (세션 mutex 미보유 상태)
+static void stopCameraIndex(CameraSession &s) {
+    std::lock_guard<std::mutex> life(s.lifecycle);
+    s.indexCancel.store(true);
+    if (s.indexThread.joinable() && s.indexThread.get_id() != std::this_thread::get_id()) {
+        s.indexThread.join();
+    }
+}
+
 // ----------------------------------------------------------------------------
 // 기본 카메라 초기화/종료
 // ----------------------------------------------------------------------------
@@ -224,6 +530,7 @@ Java_com_inik_phototest2_CameraNative_initCamera(JNIEnv *env, jobject) {
     }
     ret = gp_camera_init(camera, context);
     LOGD("initCamera - gp_camera_init ret=%d (%s)", ret, gp_result_as_string(ret));
+    if (ret == GP_OK) onSessionOpenedLocked(primarySession);
 
     return env->NewStringUTF(gp_result_as_string(ret));
 }
@@ -231,14 +538,17 @@ Java_com_inik_phototest2_CameraNative_initCamera(JNIEnv *env, jobject) {
 extern "C" JNIEXPORT void JNICALL
 Java_com_inik_phototest2_CameraNative_closeCamera(JNIEnv *, jobject) {
     LOGD("closeCamera 호출");
+    stopCameraIndex(primarySession);
+    stopThumbnailPump(primarySession);
+    std::lock_guard<std::mutex> life(primarySession.lifecycle);
     std::lock_guard<std::mutex> lock(cameraMutex);
 
-    if (camera) {
-        gp_camera_exit(camera, context);
-        gp_camera_free(camera);
-        camera = nullptr;
-        LOGD("closeCamera: camera freed");
-    }
+    // 명시적으로 닫으면 재연결 대상이 아니다
+    primarySession.suspended.store(false);
+    primarySession.restoreLiveView = false;
+    primarySession.restoreEvents = false;
+    releaseSessionLocked(primarySession, false);
+    LOGD("closeCamera: camera freed");
     if (context) {
         gp_context_unref(context);
         context = nullptr;
@@ -247,6 +557,126 @@ Java_com_inik_phototest2_CameraNative_closeCamera(JNIEnv *, jobject) {
     LOGD("closeCamera 완료");
 }
 
+// abilities / 포트를 직접 지정해 autodetect 와 전체 camlib 스캔을 건너뛴다
+static int initCameraDirectLocked(CameraSession &s, const CameraAbilities &abilities) {
+    GPPortInfoList *pil = nullptr;
+    int ret = gp_port_info_list_new(&pil);
+    if (ret < GP_OK) return ret;
+
+    GPPortInfo info;
+    {
+        StartupTimeline::Scope span(startupTimeline, "port_info");
+        ret = gp_port_info_list_load(pil);
+        if (ret >= GP_OK) ret = findUsbPortInfo(pil, &info);
+        span.setResult(ret);
+    }
+    if (ret < GP_OK) {
+        LOGE("initCameraDirect: USB 포트 없음 -> %s", gp_result_as_string(ret));
+        gp_port_info_list_free(pil);
+        return ret;
+    }
+
+    ret = gp_camera_new(&s.camera);
+    if (ret >= GP_OK) ret = gp_camera_set_abilities(s.camera, abilities);
+    if (ret >= GP_OK) ret = gp_camera_set_port_info(s.camera, info);
+    gp_port_info_list_free(pil);
+    if (ret >= GP_OK) {
+        // 여기서 선택된 camlib 하나만 로드된다
+        StartupTimeline::Scope span(startupTimeline, "init_direct");
+        ret = gp_camera_init(s.camera, s.context);
+        span.setResult(ret);
+    }
+
+    if (ret < GP_OK && s.camera) {
+        gp_camera_free(s.camera);
+        s.camera = nullptr;
+    }
+    LOGD("initCameraDirect: model=%s ret=%d (%s)", abilities.model, ret, gp_result_as_string(ret));
+    return ret;
+}
+
+// 기존 autodetect 초기화 - 에러 코드별 재시도 정책 적용
+// (openMutex + 세션 mutex 보유 상태)
+static int initCameraAutodetectLocked(CameraSession &s, int fd) {
+    int ret;
+    {
+        StartupTimeline::Scope span(startupTimeline, "sysdev");
+        ret = gp_port_usb_set_sys_device(fd);
+        span.setResult(ret);
+    }
+    LOGD("initCameraWithFd gp_port_usb_set_sys_device ret=%d (%s)", ret, gp_result_as_string(ret));
+    if (ret < GP_OK) return ret;
+
+    for (int attempt = 1;; ++attempt) {
+        const std::string spanName = "init#" + std::to_string(attempt);
+        {
+            StartupTimeline::Scope span(startupTimeline, spanName.c_str());
+            ret = gp_camera_new(&s.camera);
+            if (ret >= GP_OK) {
+                ret = gp_camera_init(s.camera, s.context);
+                if (ret < GP_OK) {
+                    gp_camera_free(s.camera);
+                    s.camera = nullptr;
+                }
+            }
+            span.setResult(ret);
+        }
+        if (ret == GP_OK) break;
+
+        int delayMs = initRetryDelayMs(ret, attempt);
+        LOGE("initCameraWithFd: 시도 %d 실패 -> %s, 다음 대기 %dms", attempt,
+             gp_result_as_string(ret), delayMs);
+        if (delayMs < 0) break;
+        if (delayMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+    }
+    return ret;
+}
+
+// 빠른 초기화: VID/PID/인터페이스 클래스로 드라이버를 골라 바로 init,
+// 실패하면 autodetect 초기화로 폴백 (reconnect: 같은 카메라 재연결 - 캐시 유지)
+static int openSessionFast(CameraSession &s, int fd, const char *libDir,
+                           int vendorId, int productId, int usbClass, bool reconnect) {
+    std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+    {
+        StartupTimeline::Scope span(startupTimeline, "setenv");
+        setCamlibEnv(libDir);
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    releaseSessionLocked(s, reconnect);
+    s.fd = fd;
+    s.usbVendor = vendorId;
+    s.usbProduct = productId;
+
+    int ret;
+    {
+        StartupTimeline::Scope span(startupTimeline, "sysdev");
+        ret = gp_port_usb_set_sys_device(fd);
+        span.setResult(ret);
+    }
+    if (ret < GP_OK) {
+        LOGE("openSessionFast gp_port_usb_set_sys_device ret=%d", ret);
+        return ret;
+    }
+
+    CameraAbilities abilities;
+    bool resolved;
+    {
+        StartupTimeline::Scope span(startupTimeline, "abilities");
+        resolved = resolveUsbAbilities(libDir, storageDir, vendorId, productId, usbClass,
+                                       abilities);
+        span.setResult(resolved ? GP_OK : GP_ERROR_MODEL_NOT_FOUND);
+    }
+    ret = resolved ? initCameraDirectLocked(s, abilities) : GP_ERROR_MODEL_NOT_FOUND;
+
+    if (ret != GP_OK) {
+        LOGD("openSessionFast: 빠른 경로 실패(%d) -> autodetect 로 폴백", ret);
+        ret = initCameraAutodetectLocked(s, fd);
+    }
+    if (ret == GP_OK) onSessionOpenedLocked(s);
+    return ret;
+}
+
 // ----------------------------------------------------------------------------
 // FD를 통한 카메라 초기화(안드로이드 USB) - openDeviceAndInit()
 // ----------------------------------------------------------------------------
@@ -257,53 +687,78 @@ Java_com_inik_phototest2_CameraNative_initCameraWithFd(
     const char *libDir = env->GetStringUTFChars(libDir_, nullptr);
     LOGD("initCameraWithFd 시작: fd=%d, libDir=%s", fd, libDir);
 
-    // 환경변수 설정 (libgphoto2 camlibs/iolibs)
-    setenv("CAMLIBS", libDir, 1);
-    setenv("IOLIBS", libDir, 1);
-    setenv("CAMLIBS_PREFIX", "libgphoto2_camlib_", 1);
-    setenv("IOLIBS_PREFIX", "libgphoto2_port_iolib_", 1);
-
-    std::lock_guard<std::mutex> lock(cameraMutex);
-    if (camera) {
-        gp_camera_exit(camera, context);
-        gp_camera_free(camera);
-        camera = nullptr;
-    }
-
-    // fd 설정
-    int ret = gp_port_usb_set_sys_device(fd);
-    LOGD("initCameraWithFd gp_port_usb_set_sys_device ret=%d (%s)", ret, gp_result_as_string(ret));
-    if (ret < GP_OK) {
-        env->ReleaseStringUTFChars(libDir_, libDir);
-        return ret;
-    }
+    startupTimeline.reset("autodetect");
 
-    int finalRet = -1;
-    // 재시도 (3회)
-    for (int i = 0; i < 3; ++i) {
-        ret = gp_camera_new(&camera);
-        if (ret < GP_OK) {
-            finalRet = ret;
-            continue;
+    int finalRet;
+    {
+        std::lock_guard<std::mutex> life(primarySession.lifecycle);
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        {
+            StartupTimeline::Scope span(startupTimeline, "setenv");
+            setCamlibEnv(libDir);
         }
+        env->ReleaseStringUTFChars(libDir_, libDir);
 
-        ret = gp_camera_init(camera, context);
-        if (ret == GP_OK) {
-            finalRet = ret;
-            break;
-        } else {
-            gp_camera_free(camera);
-            camera = nullptr;
-            finalRet = ret;
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
+        std::lock_guard<std::mutex> lock(cameraMutex);
+        releaseSessionLocked(primarySession, false);
+        primarySession.fd = fd;
+        primarySession.usbVendor = 0;
+        primarySession.usbProduct = 0;
+        finalRet = initCameraAutodetectLocked(primarySession, fd);
+        if (finalRet == GP_OK) onSessionOpenedLocked(primarySession);
+        primarySession.suspended.store(false);
+        primarySession.restoreLiveView = false;
+        primarySession.restoreEvents = false;
     }
 
-    env->ReleaseStringUTFChars(libDir_, libDir);
     LOGD("initCameraWithFd done -> ret=%d", finalRet);
+    LOGD("%s", startupTimeline.summary().c_str());
+
+    // 기능 조회용 abilities 목록은 연결 후 백그라운드에서 미리 읽어둔다
+    if (finalRet == GP_OK) AbilitiesCache::instance().preloadAsync();
     return finalRet;
 }
 
+// ----------------------------------------------------------------------------
+// 빠른 초기화: UsbDevice 의 VID/PID/인터페이스 클래스로 드라이버를 골라
+// gp_camera_set_abilities/gp_camera_set_port_info 로 바로 init
+// (실패하면 기존 autodetect 초기화로 폴백)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_initCameraWithFdFast(
+        JNIEnv *env, jobject, jint fd, jstring libDir_,
+        jint vendorId, jint productId, jint usbClass) {
+
+    const char *libDir = env->GetStringUTFChars(libDir_, nullptr);
+    LOGD("initCameraWithFdFast 시작: fd=%d, %04x:%04x class=%d", fd, vendorId, productId, usbClass);
+
+    startupTimeline.reset("fast");
+    int ret;
+    {
+        // 직접 다시 여는 것이므로 suspend 상태를 풀어 reconnectSession 과 겹치지 않게 한다
+        std::lock_guard<std::mutex> life(primarySession.lifecycle);
+        ret = openSessionFast(primarySession, fd, libDir, vendorId, productId, usbClass, false);
+        primarySession.suspended.store(false);
+        primarySession.restoreLiveView = false;
+        primarySession.restoreEvents = false;
+    }
+    env->ReleaseStringUTFChars(libDir_, libDir);
+
+    LOGD("initCameraWithFdFast done -> ret=%d", ret);
+    LOGD("%s", startupTimeline.summary().c_str());
+
+    if (ret == GP_OK) AbilitiesCache::instance().preloadAsync();
+    return ret;
+}
+
+// ----------------------------------------------------------------------------
+// 연결 타임라인 (JSON) - 단계별 시작/소요 시간(us)과 결과 코드
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getStartupTimelineJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(startupTimeline.toJson().c_str());
+}
+
 // ----------------------------------------------------------------------------
 // 카메라 감지, 요약 등
 // ----------------------------------------------------------------------------
@@ -311,10 +766,20 @@ extern "C" JNIEXPORT jstring JNICALL
 Java_com_inik_phototest2_CameraNative_detectCamera(JNIEnv *env, jobject) {
     LOGD("detectCamera 호출");
 
+    // 열린 세션이 정상이면 포트 재열거 없이 캐시된 정보로 응답
+    if (connectionState.isConnected()) {
+        return env->NewStringUTF((connectionState.description() + "\n").c_str());
+    }
+
     CameraList *cl = nullptr;
     gp_list_new(&cl);
 
-    int ret = gp_camera_autodetect(cl, context);
+    int ret;
+    {
+        // 드라이버 로딩은 세션 열기/abilities 로드와 겹치면 안 된다
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        ret = gp_camera_autodetect(cl, context);
+    }
     int count = gp_list_count(cl);
 
     std::ostringstream oss;
@@ -344,21 +809,33 @@ Java_com_inik_phototest2_CameraNative_getCameraSummary(JNIEnv *env, jobject) {
 
     CameraText txt;
     int ret = gp_camera_get_summary(camera, &txt, context);
+    connectionState.noteResult(ret);
     if (ret < GP_OK) {
         return env->NewStringUTF(gp_result_as_string(ret));
     }
 
+    // summary 를 읽은 김에 스키마 캐시 키도 잡아둔다
+    if (!schemaCache.hasKey()) setSchemaKey(camera, txt.text);
+
     return env->NewStringUTF(txt.text);
 }
 
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_inik_phototest2_CameraNative_isCameraConnected(JNIEnv *env, jobject) {
-    LOGD("isCameraConnected 호출");
+    // 열린 세션이 있으면 캐시된 상태만 본다 (USB 접근 없음)
+    if (connectionState.state() != ConnectionState::DISCONNECTED) {
+        return connectionState.isConnected();
+    }
+    LOGD("isCameraConnected 호출 (열린 세션 없음 -> autodetect)");
 
     CameraList *cl = nullptr;
     gp_list_new(&cl);
 
-    int ret = gp_camera_autodetect(cl, context);
+    int ret;
+    {
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        ret = gp_camera_autodetect(cl, context);
+    }
     int count = gp_list_count(cl);
     gp_list_free(cl);
 
@@ -379,7 +856,10 @@ Java_com_inik_phototest2_CameraNative_cameraAutoDetect(JNIEnv *env, jobject) {
         return env->NewStringUTF("Failed to create camera list");
     }
 
-    ret = gp_camera_autodetect(list, ctx);
+    {
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        ret = gp_camera_autodetect(list, ctx);
+    }
     if (ret < GP_OK) {
         gp_list_free(list);
         gp_context_unref(ctx);
@@ -407,6 +887,12 @@ Java_com_inik_phototest2_CameraNative_cameraAutoDetect(JNIEnv *env, jobject) {
     return env->NewStringUTF(result);
 }
 
+// 연결 상태 (JSON) - state/idleMs/consecutiveErrors/lastError
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getConnectionStateJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(connectionState.toJson().c_str());
+}
+
 // ----------------------------------------------------------------------------
 // gPhoto2 라이브러리/포트 테스트용
 // ----------------------------------------------------------------------------
@@ -418,7 +904,10 @@ Java_com_inik_phototest2_CameraNative_testLibraryLoad(JNIEnv *env, jobject) {
         return env->NewStringUTF(gp_result_as_string(ret));
     }
 
-    ret = gp_port_info_list_load(pil);
+    {
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        ret = gp_port_info_list_load(pil);
+    }
     gp_port_info_list_free(pil);
 
     return env->NewStringUTF(ret >= GP_OK ? "OK" : gp_result_as_string(ret));
@@ -434,7 +923,10 @@ extern "C" JNIEXPORT jstring JNICALL
 Java_com_inik_phototest2_CameraNative_getPortInfo(JNIEnv *env, jobject) {
     GPPortInfoList *pil = nullptr;
     gp_port_info_list_new(&pil);
-    int ret = gp_port_info_list_load(pil);
+    {
+        std::lock_guard<std::mutex> openLock(SessionRegistry::instance().openMutex());
+        gp_port_info_list_load(pil);
+    }
 
     std::ostringstream oss;
     int count = gp_port_info_list_count(pil);
@@ -452,12 +944,71 @@ Java_com_inik_phototest2_CameraNative_getPortInfo(JNIEnv *env, jobject) {
     return env->NewStringUTF(oss.str().c_str());
 }
 
+// ----------------------------------------------------------------------------
+// 내려받은 사진 한 장 마무리: 저장소 등록 + EXIF 색인 (파일 앞부분만 읽음) + 썸네일
+//  - 등록만 여기서 하고 나머지는 CPU 풀로 넘긴다 (촬영/USB 스레드를 잡지 않음)
+//  - 세로 사진이면 EXIF 다음에 방향 정규화(JOB_ENCODE)를 거쳐 썸네일을 만든다
+// ----------------------------------------------------------------------------
+static void postPhotoThumbnail(const std::string &path) {
+    CpuPool::instance().post(CpuPool::JOB_THUMBNAIL, [path]() {
+        std::string thumbPath;
+        return makePhotoThumbnail(path, PHOTO_THUMB_DEFAULT_EDGE, thumbPath);
+    });
+}
+
+// 같은 경로를 동시에 두 번 저장(중복 다운로드)해도 회전이 겹치지 않도록 경로별로 묶는다
+static std::mutex photoOrientationMtx[16];
+
+static std::mutex &orientationLockOf(const std::string &path) {
+    return photoOrientationMtx[std::hash<std::string>()(path) % 16];
+}
+
+static void onPhotoStored(const std::string &path, uint64_t bytes) {
+    // 중복이면 이미 정규화된 파일일 수 있어 실제 크기로 등록
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) bytes = (uint64_t) st.st_size;
+    PhotoStore::instance().add(path, bytes);
+    CpuPool::instance().post(CpuPool::JOB_EXIF, [path]() {
+        const std::string key = path.substr(path.find_last_of('/') + 1);
+        ExifInfo info;
+        if (!exifParseFile(path, info)) {
+            postPhotoThumbnail(path);
+            return GP_ERROR_CORRUPTED_DATA;
+        }
+        if (info.orientation < 2 || !orientationNormalizeEnabled() || contentSha256Enabled()) {
+            ExifIndex::instance().put(key, info);
+            postPhotoThumbnail(path);
+            return GP_OK;
+        }
+        CpuPool::instance().post(CpuPool::JOB_ENCODE, [path, key, info]() mutable {
+            std::lock_guard<std::mutex> lock(orientationLockOf(path));
+            // EXIF 작업 뒤 다른 작업이 이미 세웠을 수 있어 파일에서 다시 읽는다
+            ExifInfo current;
+            if (exifParseFile(path, current)) info = current;
+            if (info.orientation < 2) {
+                ExifIndex::instance().put(key, info);
+                postPhotoThumbnail(path);
+                return GP_OK;
+            }
+            uint64_t newSize = 0;
+            int ret = normalizePhotoOrientation(path, info.orientation, newSize);
+            if (ret == GP_OK) {
+                info.orientation = 1;
+                PhotoStore::instance().add(path, newSize);
+            }
+            ExifIndex::instance().put(key, info);
+            postPhotoThumbnail(path);
+            return ret;
+        });
+        return GP_OK;
+    });
+}
+
 // ----------------------------------------------------------------------------
 // 사진 촬영(동기)
 // ----------------------------------------------------------------------------
-extern "C" JNIEXPORT jint JNICALL
-Java_com_inik_phototest2_CameraNative_capturePhoto(JNIEnv *env, jobject, jstring) {
-    LOGD("capturePhoto");
+// 촬영 후 앱 저장소로 받아 savedPath 에 실제 저장 경로 (내용 주소 이름)
+static int capturePrimaryPhoto(std::string &savedPath) {
     std::lock_guard<std::mutex> lock(cameraMutex);
 
     if (!camera) {
@@ -466,32 +1017,33 @@ Java_com_inik_phototest2_CameraNative_capturePhoto(JNIEnv *env, jobject, jstring
 
     CameraFilePath cfp;
     int ret = gp_camera_capture(camera, GP_CAPTURE_IMAGE, &cfp, context);
+    configSnapshot.markStale();
+    connectionState.noteResult(ret);
     if (ret < GP_OK) {
         return ret;
     }
 
-    CameraFile *file;
-    gp_file_new(&file);
-    int getRet = gp_camera_file_get(camera, cfp.folder, cfp.name, GP_FILE_TYPE_NORMAL, file,
-                                    context);
+    // 내용 주소 이름이라 같은 초에 두 장을 찍어도 서로 덮어쓰지 않는다
+    ContentDownload dl;
+    int getRet = downloadContentAddressed(camera, context, cfp.folder, cfp.name,
+                                          GP_FILE_TYPE_NORMAL, storageDir, dl);
     if (getRet < GP_OK) {
-        gp_file_free(file);
         return getRet;
     }
 
-    // 저장 경로 예시
-    char savePath[128];
-    snprintf(savePath, sizeof(savePath),
-             "/data/data/com.inik.phototest2/files/photo_%lld.jpg",
-             (long long) std::time(nullptr));
-
-    gp_file_save(file, savePath);
-    gp_file_free(file);
-
-    LOGD("capturePhoto -> 저장 완료: %s", savePath);
+    onPhotoStored(dl.path, dl.bytes);
+    LOGD("capturePhoto -> 저장 완료: %s", dl.path.c_str());
+    savedPath = dl.path;
     return ret;
 }
 
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_capturePhoto(JNIEnv *env, jobject, jstring) {
+    LOGD("capturePhoto");
+    std::string savedPath;
+    return capturePrimaryPhoto(savedPath);
+}
+
 // 비동기 촬영
 extern "C" JNIEXPORT void JNICALL
 Java_com_inik_phototest2_CameraNative_capturePhotoAsync(JNIEnv *env, jobject, jobject cb) {
@@ -505,15 +1057,13 @@ Java_com_inik_phototest2_CameraNative_capturePhotoAsync(JNIEnv *env, jobject, jo
         JNIEnv *threadEnv;
         vm->AttachCurrentThread(&threadEnv, nullptr);
 
-        jstring dummyPath = threadEnv->NewStringUTF("unused");
-        jint result = Java_com_inik_phototest2_CameraNative_capturePhoto(threadEnv, nullptr,
-                                                                         dummyPath);
+        std::string savedPath;
+        jint result = capturePrimaryPhoto(savedPath);
 
         jclass cls = threadEnv->GetObjectClass(globalCb);
         if (result >= GP_OK) {
             jmethodID m = threadEnv->GetMethodID(cls, "onPhotoCaptured", "(Ljava/lang/String;)V");
-            jstring path = threadEnv->NewStringUTF(
-                    "/data/data/com.inik.phototest2/files/photo.jpg");
+            jstring path = threadEnv->NewStringUTF(savedPath.c_str());
             threadEnv->CallVoidMethod(globalCb, m, path);
             threadEnv->DeleteLocalRef(path);
         } else {
@@ -521,7 +1071,7 @@ Java_com_inik_phototest2_CameraNative_capturePhotoAsync(JNIEnv *env, jobject, jo
             threadEnv->CallVoidMethod(globalCb, m, result);
         }
 
-        threadEnv->DeleteLocalRef(dummyPath);
+        threadEnv->DeleteLocalRef(cls);
         threadEnv->DeleteGlobalRef(globalCb);
         vm->DetachCurrentThread();
     }).detach();
@@ -542,155 +1092,377 @@ static void callJavaPhotoCallback(JNIEnv *env, jobject callbackObj, const char *
     env->DeleteLocalRef(jPath);
 }
 
-extern "C" JNIEXPORT void JNICALL
-Java_com_inik_phototest2_CameraNative_listenCameraEvents(JNIEnv *env, jobject, jobject callback) {
-    if (eventListenerRunning.load()) {
-        LOGD("listenCameraEvents: 이미 실행 중");
-        return;
+// 이벤트 대기 한 번의 최대 시간 - 세션 mutex 를 쥔 채 기다리므로 라이브뷰 중에는 짧게
+#define EVENT_WAIT_TIMEOUT_MS 200
+#define EVENT_WAIT_TIMEOUT_LIVEVIEW_MS 20
+
+// 추가된 파일 하나를 내려받아 Java 에 알린다 (세션 mutex 보유 상태)
+//  - 연결이 끊겨 실패하면 false: 호출자가 큐에 되돌려 재연결 후 다시 받는다
+//  - 받으면서 해시해 내용 주소 이름으로 저장 (같은 사진이 이미 있으면 그 경로)
+static bool downloadAddedFileLocked(CameraSession &s, JNIEnv *env, jobject callback,
+                                    const CameraFilePath &cfp) {
+    ContentDownload dl;
+    int getRet = -1;
+    for (int i = 0; i < 5; ++i) {
+        getRet = downloadContentAddressed(s.camera, s.context, cfp.folder, cfp.name,
+                                          GP_FILE_TYPE_NORMAL, storageDir, dl);
+        if (dl.writeFailed) break;
+        s.connection.noteResult(getRet);
+        if (getRet >= GP_OK || s.connection.state() == ConnectionState::LOST) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
     }
 
-    jobject globalCb = env->NewGlobalRef(callback);
-    JavaVM *vm;
-    env->GetJavaVM(&vm);
+    DownloadJournal &journal = DownloadJournal::instance();
+    bool done = true;
+    const std::string &path = dl.path;
+    if (getRet >= GP_OK) {
+        LOGD("listenCameraEvents: %s -> %s", dl.duplicate ? "이미 있음" : "저장 완료", path.c_str());
+        onPhotoStored(path, dl.bytes);
+        if (!s.serial.empty()) {
+            journal.appendDone(s.serial, cfp.folder, cfp.name,
+                               path.substr(path.find_last_of('/') + 1));
+            // 이후 "새 파일만 가져오기" 에서 건너뛰도록
+            ImportedIndex::instance().markImported(s.serial, cfp.folder, cfp.name, 0, 0);
+            PhotoStore::instance().setOrigin(
+                    path, ImportedIndex::keyOf(s.serial, cfp.folder, cfp.name));
+        }
+        callJavaPhotoCallback(env, callback, path.c_str());
+    } else if (dl.writeFailed) {
+        // 카메라에는 남아 있으므로 PENDING 으로 두어 다음 실행에서 다시 받는다
+        LOGE("listenCameraEvents: 저장 실패 -> %s/%s (%s)", cfp.folder, cfp.name,
+             gp_result_as_string(getRet));
+    } else if (s.connection.state() == ConnectionState::LOST) {
+        LOGE("listenCameraEvents: 연결 끊김, 재연결 후 다시 받음 -> %s/%s", cfp.folder, cfp.name);
+        done = false;
+    } else {
+        LOGE("listenCameraEvents: 사진 가져오기 실패 -> %s", gp_result_as_string(getRet));
+        if (!s.serial.empty()) journal.appendFailed(s.serial, cfp.folder, cfp.name);
 
-    eventListenerRunning.store(true);
+        jclass cls = env->GetObjectClass(callback);
+        jmethodID m = env->GetMethodID(cls, "onCaptureFailed", "(I)V");
+        env->CallVoidMethod(callback, m, getRet);
+    }
+    return done;
+}
 
-    eventListenerThread = std::thread([vm, globalCb]() {
-        JNIEnv *threadEnv;
-        if (vm->AttachCurrentThread(&threadEnv, nullptr) != JNI_OK) {
-            LOGE("listenCameraEvents: AttachCurrentThread 실패");
-            return;
+// 저널 키로 쓸 카메라 시리얼 (세션 mutex 보유 상태)
+//  - 요약을 읽는 김에 기본 세션의 스키마 캐시 키도 잡는다
+static void ensureSerialLocked(CameraSession &s) {
+    if (!s.serial.empty() || !s.camera) return;
+
+    CameraText txt;
+    int ret = gp_camera_get_summary(s.camera, &txt, s.context);
+    s.connection.noteResult(ret);
+    if (ret >= GP_OK) s.serial = parseSerialNumber(txt.text);
+    if (&s == &primarySession && !schemaCache.hasKey()) {
+        setSchemaKey(s.camera, ret >= GP_OK ? txt.text : nullptr);
+    }
+    if (s.serial.empty()) {
+        // 시리얼을 안 주는 기종은 모델 + VID/PID 로 대신한다
+        CameraAbilities abilities;
+        char buf[96];
+        snprintf(buf, sizeof(buf), "%s@%04x:%04x",
+                 gp_camera_get_abilities(s.camera, &abilities) >= GP_OK ? abilities.model : "?",
+                 s.usbVendor, s.usbProduct);
+        s.serial = buf;
+    }
+}
+
+// 이전 실행(또는 끊기기 전)에 받지 못한 파일을 저널에서 꺼내 대기열에 넣는다 (세션 mutex 보유 상태)
+static void resumeJournaledDownloadsLocked(CameraSession &s) {
+    ensureSerialLocked(s);
+    std::vector<DownloadJournal::Entry> entries = DownloadJournal::instance().pendingFor(s.serial);
+    if (entries.empty()) return;
+
+    std::lock_guard<std::mutex> lk(s.downloadMtx);
+    int added = 0;
+    for (const DownloadJournal::Entry &e: entries) {
+        bool queued = false;
+        for (const CameraFilePath &q: s.pendingDownloads) {
+            if (e.folder == q.folder && e.name == q.name) {
+                queued = true;
+                break;
+            }
         }
+        if (queued) continue;
 
-        static std::atomic<int> photoCounter{0};
+        CameraFilePath cfp;
+        snprintf(cfp.folder, sizeof(cfp.folder), "%s", e.folder.c_str());
+        snprintf(cfp.name, sizeof(cfp.name), "%s", e.name.c_str());
+        s.pendingDownloads.push_back(cfp);
+        added++;
+    }
+    LOGD("listenCameraEvents[%d]: 저널에서 이어받을 파일 %d 개 (%s)", s.handle, added,
+         s.serial.c_str());
+}
 
-        while (eventListenerRunning.load()) {
-            {
-                std::lock_guard<std::mutex> lock(cameraMutex);
-                if (!camera) {
-                    LOGE("listenCameraEvents: camera=null -> 종료");
-                    break;
-                }
+// 이벤트 펌프: 세션 mutex 를 쥔 채 짧게 이벤트를 기다리고, FILE_ADDED 는
+// pendingDownloads 에 넣은 뒤 (동기 트리거 등이 넣은 것까지) 순서대로 내려받는다.
+// generation 이 바뀌면(정지/재시작) 종료. 콜백 전역 참조는 세션 소유.
+static void sessionEventLoop(std::shared_ptr<CameraSession> s, int generation, jobject callback) {
+    JNIEnv *threadEnv;
+    if (gJvm->AttachCurrentThread(&threadEnv, nullptr) != JNI_OK) {
+        LOGE("listenCameraEvents: AttachCurrentThread 실패");
+        return;
+    }
+    auto running = [&s, generation] { return s->eventGeneration.load() == generation; };
+    {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (s->camera) resumeJournaledDownloadsLocked(*s);
+    }
+
+    while (running()) {
+        int ret;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->camera) {
+                LOGE("listenCameraEvents[%d]: camera=null -> 종료", s->handle);
+                break;
             }
 
             CameraEventType type;
             void *data = nullptr;
-            int ret = gp_camera_wait_for_event(camera, 5000, &type, &data, context);
-            if (!eventListenerRunning.load()) break;
-            if (ret != GP_OK) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                continue;
-            }
+            int timeoutMs = s->liveViewRunning.load() ? EVENT_WAIT_TIMEOUT_LIVEVIEW_MS
+                                                      : EVENT_WAIT_TIMEOUT_MS;
+            ret = gp_camera_wait_for_event(s->camera, timeoutMs, &type, &data, s->context);
+            s->connection.noteResult(ret);
 
-            if (type == GP_EVENT_FILE_ADDED) {
+            if (ret == GP_OK && type == GP_EVENT_FILE_ADDED) {
                 CameraFilePath *cfp = static_cast<CameraFilePath *>(data);
-                LOGD("새 파일 추가: %s/%s", cfp->folder, cfp->name);
-
-                char pathBuf[128];
-                auto now = std::chrono::system_clock::now();
-                auto nowMs = std::chrono::time_point_cast<std::chrono::milliseconds>(now);
-                long long millis = nowMs.time_since_epoch().count();
-                int count = photoCounter.fetch_add(1);
-
-                snprintf(pathBuf, sizeof(pathBuf),
-                         "/data/data/com.inik.phototest2/files/photo_%lld_%d.jpg",
-                         millis, count);
-
-                CameraFile *file;
-                gp_file_new(&file);
-
-                int getRet = -1;
-                for (int i = 0; i < 5; ++i) {
-                    getRet = gp_camera_file_get(camera, cfp->folder, cfp->name,
-                                                GP_FILE_TYPE_NORMAL, file, context);
-                    if (getRet >= GP_OK) break;
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                }
-
-                if (getRet >= GP_OK) {
-                    gp_file_save(file, pathBuf);
-                    LOGD("listenCameraEvents: 저장 완료 -> %s", pathBuf);
-
-                    jclass cls = threadEnv->GetObjectClass(globalCb);
-                    jmethodID m = threadEnv->GetMethodID(cls, "onPhotoCaptured",
-                                                         "(Ljava/lang/String;)V");
-                    jstring pathStr = threadEnv->NewStringUTF(pathBuf);
-                    threadEnv->CallVoidMethod(globalCb, m, pathStr);
-                    threadEnv->DeleteLocalRef(pathStr);
-                } else {
-                    LOGE("listenCameraEvents: 사진 가져오기 실패 -> %s", gp_result_as_string(getRet));
-
-                    jclass cls = threadEnv->GetObjectClass(globalCb);
-                    jmethodID m = threadEnv->GetMethodID(cls, "onCaptureFailed", "(I)V");
-                    threadEnv->CallVoidMethod(globalCb, m, getRet);
-                }
-                gp_file_free(file);
-
-            } else if (type == GP_EVENT_CAPTURE_COMPLETE) {
+                LOGD("새 파일 추가[%d]: %s/%s", s->handle, cfp->folder, cfp->name);
+                s->config.markStale();      // 본체 셔터로 찍어도 남은 매수 등이 바뀐다
+                queueDownload(*s, *cfp);
+            } else if (ret == GP_OK && type == GP_EVENT_CAPTURE_COMPLETE) {
                 // 촬영 완료 이벤트
                 LOGD("listenCameraEvents: CAPTURE_COMPLETE");
+                s->config.markStale();
+            } else if (ret == GP_OK && type == GP_EVENT_UNKNOWN && data &&
+                       strstr(static_cast<const char *>(data), "changed")) {
+                // PTP 드라이버는 본체 다이얼 조작을 "PTP Property xxxx changed ..." 로 알린다
+                s->config.markStale();
             }
+            free(data);
 
-            std::unique_lock<std::mutex> lk(eventCvMtx);
-            eventCv.wait_for(lk, std::chrono::milliseconds(100),
-                             [] { return !eventListenerRunning.load(); });
+            while (running()) {
+                CameraFilePath cfp;
+                {
+                    std::lock_guard<std::mutex> lk(s->downloadMtx);
+                    if (s->pendingDownloads.empty()) break;
+                    cfp = s->pendingDownloads.front();
+                    s->pendingDownloads.pop_front();
+                }
+                if (!downloadAddedFileLocked(*s, threadEnv, callback, cfp)) {
+                    std::lock_guard<std::mutex> lk(s->downloadMtx);
+                    s->pendingDownloads.push_front(cfp);
+                    break;
+                }
+            }
+            // 한 묶음을 받았으면 저널을 디스크에 확정 (기록할 게 없으면 바로 반환)
+            DownloadJournal::instance().flush();
+        }
+        if (!running()) break;
+        if (ret != GP_OK) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            continue;
         }
 
-        threadEnv->DeleteGlobalRef(globalCb);
-        vm->DetachCurrentThread();
-    });
+        std::unique_lock<std::mutex> lk(s->eventCvMtx);
+        s->eventCv.wait_for(lk, std::chrono::milliseconds(100), [&s, &running] {
+            if (!running()) return true;
+            std::lock_guard<std::mutex> dl(s->downloadMtx);
+            return !s->pendingDownloads.empty();
+        });
+    }
+
+    DownloadJournal::instance().flush();
+    gJvm->DetachCurrentThread();
+}
+
+// 아무 스레드에서나 전역 참조 해제
+static void deleteGlobalRefAnyThread(jobject ref) {
+    if (!ref) return;
+    JNIEnv *env = nullptr;
+    if (gJvm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        env->DeleteGlobalRef(ref);
+        return;
+    }
+    if (gJvm->AttachCurrentThread(&env, nullptr) != JNI_OK) return;
+    env->DeleteGlobalRef(ref);
+    gJvm->DetachCurrentThread();
+}
+
+// 펌프 스레드 시작/정지 - 콜백은 건드리지 않음 (lifecycle 보유 상태)
+static void startEventThreadLocked(const std::shared_ptr<CameraSession> &s) {
+    if (s->eventThread.joinable()) s->eventThread.join();
+    int generation = ++s->eventGeneration;
+    s->eventsRunning.store(true);
+    s->eventThread = std::thread(sessionEventLoop, s, generation, s->eventCallback);
+}
+
+static void stopEventThreadLocked(const std::shared_ptr<CameraSession> &s) {
+    s->eventsRunning.store(false);
+    s->eventGeneration++;
+    s->eventCv.notify_all();
+    if (s->eventThread.joinable()) s->eventThread.join();
+}
+
+static void startEventPump(JNIEnv *env, const std::shared_ptr<CameraSession> &s, jobject callback) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (s->eventsRunning.load()) {
+        LOGD("listenCameraEvents[%d]: 이미 실행 중", s->handle);
+        return;
+    }
+
+    if (s->eventCallback) env->DeleteGlobalRef(s->eventCallback);
+    s->eventCallback = env->NewGlobalRef(callback);
+    if (s->suspended.load()) {
+        // 재연결되면 시작
+        s->restoreEvents = true;
+        return;
+    }
+    startEventThreadLocked(s);
+}
+
+// wait=false 면 스레드 join 을 별도 스레드에 맡기고 바로 반환 (UI 스레드용)
+static void stopEventPump(const std::shared_ptr<CameraSession> &s, bool wait) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    s->restoreEvents = false;
+    s->eventsRunning.store(false);
+    s->eventGeneration++;
+    s->eventCv.notify_all();
+
+    std::thread t = std::move(s->eventThread);
+    jobject callback = s->eventCallback;
+    s->eventCallback = nullptr;
+
+    if (wait) {
+        if (t.joinable()) t.join();
+        deleteGlobalRefAnyThread(callback);
+        return;
+    }
+    int handle = s->handle;
+    std::thread([handle, callback](std::thread t) {
+        if (t.joinable()) {
+            t.join();
+            LOGD("stopListenCameraEvents[%d]: 정상 종료", handle);
+        }
+        deleteGlobalRefAnyThread(callback);
+    }, std::move(t)).detach();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_listenCameraEvents(JNIEnv *env, jobject, jobject callback) {
+    startEventPump(env, SessionRegistry::instance().get(0), callback);
 }
 
 extern "C" JNIEXPORT void JNICALL
 Java_com_inik_phototest2_CameraNative_stopListenCameraEvents(JNIEnv *env, jobject) {
     LOGD("stopListenCameraEvents: 호출");
-    eventListenerRunning.store(false);
-    eventCv.notify_all();
-
-    std::thread([]() {
-        if (eventListenerThread.joinable()) {
-            eventListenerThread.join();
-            LOGD("stopListenCameraEvents: 정상 종료");
-        }
-    }).detach();
+    stopEventPump(SessionRegistry::instance().get(0), false);
     LOGD("stopListenCameraEvents: 요청 완료");
 }
 
+// 다운로드 저널 상태 (이어받을/완료/실패 개수)
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getDownloadJournalJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(DownloadJournal::instance().toJson().c_str());
+}
+
 // ----------------------------------------------------------------------------
 // 라이브뷰
 // ----------------------------------------------------------------------------
-static void liveViewLoop() {
+// onLiveViewHistogram(IntArray, ByteArray): 콜백에 없으면(기본 메서드) 조용히 넘긴다
+static void deliverLiveViewHistogram(JNIEnv *env, jobject callback, const LiveViewHistogram &h) {
+    jclass cls = env->GetObjectClass(callback);
+    jmethodID mid = env->GetMethodID(cls, "onLiveViewHistogram", "([I[B)V");
+    if (!mid) {
+        env->ExceptionClear();
+        env->DeleteLocalRef(cls);
+        return;
+    }
+    const jsize bins = (jsize) (sizeof(h.bins) / sizeof(h.bins[0]));
+    jintArray jBins = env->NewIntArray(bins);
+    jbyteArray jClip = env->NewByteArray((jsize) sizeof(h.clip));
+    if (jBins && jClip) {
+        env->SetIntArrayRegion(jBins, 0, bins, reinterpret_cast<const jint *>(h.bins));
+        env->SetByteArrayRegion(jClip, 0, (jsize) sizeof(h.clip),
+                                reinterpret_cast<const jbyte *>(h.clip));
+        env->CallVoidMethod(callback, mid, jBins, jClip);
+    }
+    if (jBins) env->DeleteLocalRef(jBins);
+    if (jClip) env->DeleteLocalRef(jClip);
+    env->DeleteLocalRef(cls);
+}
+
+// onLiveViewFocus(ByteBuffer, Int, Int, Float, FloatArray): 마스크는 다음 프레임 분석 전까지만 유효
+static void deliverLiveViewFocus(JNIEnv *env, jobject callback, const LiveViewFocus &f,
+                                 const std::vector<uint8_t> &mask) {
+    jclass cls = env->GetObjectClass(callback);
+    jmethodID mid = env->GetMethodID(cls, "onLiveViewFocus", "(Ljava/nio/ByteBuffer;IIF[F)V");
+    if (!mid) {
+        env->ExceptionClear();
+        env->DeleteLocalRef(cls);
+        return;
+    }
+    const jsize cells = (jsize) (sizeof(f.regions) / sizeof(f.regions[0]));
+    jobject jMask = env->NewDirectByteBuffer((void *) mask.data(), (jlong) mask.size());
+    jfloatArray jRegions = env->NewFloatArray(cells);
+    if (jMask && jRegions) {
+        env->SetFloatArrayRegion(jRegions, 0, cells, f.regions);
+        env->CallVoidMethod(callback, mid, jMask, (jint) f.width, (jint) f.height,
+                            (jfloat) f.sharpness, jRegions);
+    }
+    if (jMask) env->DeleteLocalRef(jMask);
+    if (jRegions) env->DeleteLocalRef(jRegions);
+    env->DeleteLocalRef(cls);
+}
+
+static void sessionLiveViewLoop(std::shared_ptr<CameraSession> s) {
     JNIEnv *env;
     gJvm->AttachCurrentThread(&env, nullptr);
 
     CameraFile *file = nullptr;
     gp_file_new(&file);
 
-    while (liveViewRunning.load()) {
+    // 프레임마다 버퍼를 다시 잡지 않도록 루프 동안 유지
+    LiveViewAnalyzer analyzer;
+    LiveViewHistogram histogram;
+    LiveViewFocus focus;
+
+    while (s->liveViewRunning.load()) {
+        const char *frameData = nullptr;
+        unsigned long frameSize = 0;
         {
-            std::lock_guard<std::mutex> lock(cameraMutex);
-            if (!camera) {
-                LOGE("liveViewLoop: camera=null -> 종료");
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->camera) {
+                LOGE("liveViewLoop[%d]: camera=null -> 종료", s->handle);
                 break;
             }
 
-            int pret = gp_camera_capture_preview(camera, file, context);
+            auto t0 = StartupTimeline::Clock::now();
+            int pret = gp_camera_capture_preview(s->camera, file, s->context);
+            s->connection.noteResult(pret);
             if (pret < GP_OK) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
                 continue;
             }
+            if (startupTimeline.recordOnce("first_preview", t0, StartupTimeline::Clock::now(), pret)) {
+                LOGD("%s", startupTimeline.summary().c_str());
+            }
 
             const char *data = nullptr;
             unsigned long size = 0;
             gp_file_get_data_and_size(file, &data, &size);
+            frameData = data;
+            frameSize = size;
 
-            if (!gCallback) {
-                LOGE("liveViewLoop: gCallback is null");
+            if (!s->liveViewCallback) {
+                LOGE("liveViewLoop: callback is null");
                 break;
             }
 
             // onLiveViewFrame(ByteBuffer)
-            jclass cls = env->GetObjectClass(gCallback);
+            jclass cls = env->GetObjectClass(s->liveViewCallback);
             if (!cls) {
                 LOGE("liveViewLoop: callback class not found");
             } else {
@@ -698,40 +1470,54 @@ static void liveViewLoop() {
                                                  "(Ljava/nio/ByteBuffer;)V");
                 if (mid) {
                     jobject byteBuffer = env->NewDirectByteBuffer((void *) data, size);
-                    env->CallVoidMethod(gCallback, mid, byteBuffer);
+                    env->CallVoidMethod(s->liveViewCallback, mid, byteBuffer);
                     env->DeleteLocalRef(byteBuffer);
                 }
             }
 
             // 촬영 요청이 온 경우
-            if (captureRequested.exchange(false)) {
+            if (s->captureRequested.exchange(false)) {
                 CameraFilePath cfp;
-                int cret = gp_camera_capture(camera, GP_CAPTURE_IMAGE, &cfp, context);
+                int cret = gp_camera_capture(s->camera, GP_CAPTURE_IMAGE, &cfp, s->context);
+                s->config.markStale();
+                ContentDownload dl;
                 if (cret >= GP_OK) {
-                    CameraFile *photoFile;
-                    gp_file_new(&photoFile);
-
-                    gp_camera_file_get(camera, cfp.folder, cfp.name, GP_FILE_TYPE_NORMAL,
-                                       photoFile, context);
-
-                    char path[128];
-                    snprintf(path, sizeof(path),
-                             "/data/data/com.inik.phototest2/files/photo_%lld.jpg",
-                             (long long) time(nullptr));
-                    gp_file_save(photoFile, path);
-                    gp_file_free(photoFile);
+                    cret = downloadContentAddressed(s->camera, s->context, cfp.folder, cfp.name,
+                                                    GP_FILE_TYPE_NORMAL, storageDir, dl);
+                }
+                if (cret >= GP_OK) {
+                    onPhotoStored(dl.path, dl.bytes);
 
                     // onLivePhotoCaptured(...) 호출
                     jmethodID mid2 = env->GetMethodID(cls, "onLivePhotoCaptured",
                                                       "(Ljava/lang/String;)V");
                     if (mid2) {
-                        jstring jPath = env->NewStringUTF(path);
-                        env->CallVoidMethod(gCallback, mid2, jPath);
+                        jstring jPath = env->NewStringUTF(dl.path.c_str());
+                        env->CallVoidMethod(s->liveViewCallback, mid2, jPath);
                         env->DeleteLocalRef(jPath);
                     }
                 }
             }
         }
+
+        // 분석은 카메라 잠금 밖에서 (file 데이터는 gp_file_free 전까지 유효)
+        const int analysis = frameData ? liveViewAnalysisFlags() : 0;
+        const uint8_t *jpeg = reinterpret_cast<const uint8_t *>(frameData);
+        const int both = LIVEVIEW_ANALYZE_HISTOGRAM | LIVEVIEW_ANALYZE_FOCUS;
+        if ((analysis & both) == both) {
+            if (analyzer.analyzeBoth(jpeg, frameSize, liveViewPeakingThreshold(), histogram,
+                                     focus)) {
+                deliverLiveViewHistogram(env, s->liveViewCallback, histogram);
+                deliverLiveViewFocus(env, s->liveViewCallback, focus, analyzer.peakMask());
+            }
+        } else if ((analysis & LIVEVIEW_ANALYZE_HISTOGRAM) &&
+                   analyzer.analyze(jpeg, frameSize, histogram)) {
+            deliverLiveViewHistogram(env, s->liveViewCallback, histogram);
+        } else if ((analysis & LIVEVIEW_ANALYZE_FOCUS) &&
+                   analyzer.analyzeFocus(jpeg, frameSize, liveViewPeakingThreshold(), focus)) {
+            deliverLiveViewFocus(env, s->liveViewCallback, focus, analyzer.peakMask());
+        }
+
         gp_file_free(file);
         gp_file_new(&file);
         std::this_thread::sleep_for(std::chrono::milliseconds(42));
@@ -741,49 +1527,942 @@ static void liveViewLoop() {
     gJvm->DetachCurrentThread();
 }
 
-extern "C" JNIEXPORT void JNICALL
-Java_com_inik_phototest2_CameraNative_startLiveView(JNIEnv *env, jobject, jobject callback) {
-    LOGD("startLiveView 호출");
+static void startLiveViewThreadLocked(const std::shared_ptr<CameraSession> &s) {
+    if (s->liveViewThread.joinable()) s->liveViewThread.join();
+    s->liveViewRunning.store(true);
+    s->liveViewThread = std::thread(sessionLiveViewLoop, s);
+}
+
+static void stopLiveViewThreadLocked(const std::shared_ptr<CameraSession> &s) {
+    s->liveViewRunning.store(false);
+    if (s->liveViewThread.joinable()) {
+        s->liveViewThread.join();
+    }
+}
+
+static void startLiveViewPump(JNIEnv *env, const std::shared_ptr<CameraSession> &s,
+                              jobject callback) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (s->liveViewRunning.load()) {
+        LOGD("startLiveView[%d]: 이미 라이브뷰 실행중", s->handle);
+        return;
+    }
 
-    if (liveViewRunning.load()) {
-        LOGD("startLiveView: 이미 라이브뷰 실행중");
+    if (s->suspended.load()) {
+        // 재연결되면 시작
+        if (s->liveViewCallback) env->DeleteGlobalRef(s->liveViewCallback);
+        s->liveViewCallback = env->NewGlobalRef(callback);
+        s->restoreLiveView = true;
         return;
     }
 
     {
-        std::lock_guard<std::mutex> lock(cameraMutex);
-        if (!camera) {
-            LOGE("startLiveView: camera not initialized!");
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (!s->camera) {
+            LOGE("startLiveView[%d]: camera not initialized!", s->handle);
             return;
         }
     }
 
-    gCallback = env->NewGlobalRef(callback);
-    liveViewRunning.store(true);
-    liveViewThread = std::thread(liveViewLoop);
-    LOGD("startLiveView -> 라이브뷰 스레드 시작 완료");
+    if (s->liveViewCallback) env->DeleteGlobalRef(s->liveViewCallback);
+    s->liveViewCallback = env->NewGlobalRef(callback);
+    startLiveViewThreadLocked(s);
+    LOGD("startLiveView[%d] -> 라이브뷰 스레드 시작 완료", s->handle);
+}
+
+static void stopLiveViewPump(JNIEnv *env, const std::shared_ptr<CameraSession> &s) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    s->restoreLiveView = false;
+    stopLiveViewThreadLocked(s);
+
+    if (s->liveViewCallback) {
+        env->DeleteGlobalRef(s->liveViewCallback);
+        s->liveViewCallback = nullptr;
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_startLiveView(JNIEnv *env, jobject, jobject callback) {
+    LOGD("startLiveView 호출");
+    startLiveViewPump(env, SessionRegistry::instance().get(0), callback);
 }
 
 extern "C" JNIEXPORT void JNICALL
 Java_com_inik_phototest2_CameraNative_stopLiveView(JNIEnv *env, jobject) {
     LOGD("stopLiveView 호출");
-    liveViewRunning.store(false);
+    stopLiveViewPump(env, SessionRegistry::instance().get(0));
+    LOGD("stopLiveView 완료");
+}
 
-    if (liveViewThread.joinable()) {
-        liveViewThread.join();
-    }
+// 라이브뷰 프레임 분석 (LIVEVIEW_ANALYZE_* 비트, 0 이면 끔). 모든 세션에 적용
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setLiveViewAnalysis(JNIEnv *, jobject, jint flags) {
+    setLiveViewAnalysis(flags);
+}
 
-    if (gCallback) {
-        env->DeleteGlobalRef(gCallback);
-        gCallback = nullptr;
-    }
-    LOGD("stopLiveView 완료");
+// 피킹 기준 (Sobel |gx| + |gy|, 0..2040). 낮을수록 더 많은 경계가 표시된다
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setLiveViewPeakingThreshold(JNIEnv *, jobject,
+                                                                  jint threshold) {
+    setLiveViewPeakingThreshold(threshold);
 }
 
 extern "C" JNIEXPORT void JNICALL
 Java_com_inik_phototest2_CameraNative_requestCapture(JNIEnv *env, jobject) {
     LOGD("requestCapture -> captureRequested=true");
-    captureRequested.store(true);
+    primarySession.captureRequested.store(true);
+}
+
+// ----------------------------------------------------------------------------
+// 다중 카메라 세션
+//  - openSession 으로 USB fd 마다 독립 세션(컨텍스트, 명령 큐 스레드, 이벤트 펌프,
+//    라이브뷰)을 만들고 이후 호출은 돌려받은 핸들로 지정한다.
+//  - 핸들 0 은 기존 단일 카메라 API 의 기본 세션.
+// ----------------------------------------------------------------------------
+static std::shared_ptr<CameraSession> sessionFor(jint handle) {
+    std::shared_ptr<CameraSession> s = SessionRegistry::instance().get(handle);
+    if (!s) LOGE("세션 없음: handle=%d", handle);
+    return s;
+}
+
+// 세션 명령 큐에서 촬영 후 앱 저장소로 다운로드 (명령 큐 스레드에서 실행)
+static int sessionCaptureCommand(const std::shared_ptr<CameraSession> &s) {
+    std::lock_guard<std::mutex> lock(s->mutex);
+    if (!s->camera) return GP_ERROR;
+
+    CameraFilePath cfp;
+    int ret = gp_camera_capture(s->camera, GP_CAPTURE_IMAGE, &cfp, s->context);
+    s->config.markStale();
+    s->connection.noteResult(ret);
+    if (ret < GP_OK) return ret;
+
+    ContentDownload dl;
+    ret = downloadContentAddressed(s->camera, s->context, cfp.folder, cfp.name,
+                                   GP_FILE_TYPE_NORMAL, storageDir, dl);
+    if (!dl.writeFailed) s->connection.noteResult(ret);
+    if (ret >= GP_OK) onPhotoStored(dl.path, dl.bytes);
+    LOGD("sessionCapture[%d] -> %s (%d)", s->handle, dl.path.c_str(), ret);
+    return ret;
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_openSession(
+        JNIEnv *env, jobject, jint fd, jstring libDir_,
+        jint vendorId, jint productId, jint usbClass) {
+
+    std::shared_ptr<CameraSession> s = SessionRegistry::instance().create(fd);
+    if (!s) return GP_ERROR_CAMERA_BUSY;
+
+    s->context = gp_context_new();
+    gp_context_set_message_func(s->context, message_callback, nullptr);
+    gp_context_set_error_func(s->context, error_callback, nullptr);
+
+    const char *libDir = env->GetStringUTFChars(libDir_, nullptr);
+    LOGD("openSession[%d] 시작: fd=%d, %04x:%04x", s->handle, fd, vendorId, productId);
+
+    startupTimeline.reset(("session " + std::to_string(s->handle)).c_str());
+    int ret = openSessionFast(*s, fd, libDir, vendorId, productId, usbClass, false);
+    env->ReleaseStringUTFChars(libDir_, libDir);
+    LOGD("%s", startupTimeline.summary().c_str());
+
+    if (ret != GP_OK) {
+        SessionRegistry::instance().remove(s->handle);
+        gp_context_unref(s->context);
+        s->context = nullptr;
+        return ret;
+    }
+
+    AbilitiesCache::instance().preloadAsync();
+    return s->handle;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_closeSession(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = handle == 0 ? SessionRegistry::instance().get(0)
+                                                   : SessionRegistry::instance().remove(handle);
+    if (!s) return;
+    LOGD("closeSession[%d]", handle);
+
+    stopEventPump(s, true);
+    stopLiveViewPump(env, s);
+    stopCameraIndex(*s);
+    stopThumbnailPump(*s);
+    s->commands.stop();
+
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    std::lock_guard<std::mutex> lock(s->mutex);
+    s->suspended.store(false);
+    {
+        std::lock_guard<std::mutex> dl(s->downloadMtx);
+        s->pendingDownloads.clear();
+    }
+    releaseSessionLocked(*s, false);
+    // 기본 세션의 컨텍스트는 기존 API 가 계속 쓰므로 남겨둔다
+    if (handle != 0 && s->context) {
+        gp_context_unref(s->context);
+        s->context = nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// 재연결 감시
+//  - 감시 스레드가 RECONNECT_SUPERVISOR_INTERVAL_MS 마다 세션 연결 상태를 보고
+//    LOST(장치 사라짐/연속 IO 실패)가 된 세션을 suspend 한다.
+//  - suspend: 라이브뷰/이벤트 펌프를 멈추고 카메라를 놓는다. 콜백, 대기 중인
+//    다운로드, config 스냅샷, 스키마 캐시 키는 그대로 남긴다.
+//  - 같은 VID/PID 장치가 다시 붙으면 reconnectSession(새 fd) 이 빠른 초기화로 다시
+//    열고 멈췄던 펌프를 재시작한다. config 는 전체를 다시 읽지 않는다.
+// ----------------------------------------------------------------------------
+#define RECONNECT_SUPERVISOR_INTERVAL_MS 500
+
+static void suspendSession(const std::shared_ptr<CameraSession> &s) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (s->suspended.load() || s->connection.state() == ConnectionState::DISCONNECTED) return;
+
+    s->restoreLiveView = s->liveViewRunning.load();
+    s->restoreEvents = s->eventsRunning.load();
+    stopLiveViewThreadLocked(s);
+    stopEventThreadLocked(s);
+
+    size_t pending;
+    {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (s->camera) {
+            gp_camera_exit(s->camera, s->context);
+            gp_camera_free(s->camera);
+            s->camera = nullptr;
+        }
+        std::lock_guard<std::mutex> dl(s->downloadMtx);
+        pending = s->pendingDownloads.size();
+    }
+    s->suspended.store(true);
+    LOGE("세션[%d] suspend: liveView=%d events=%d 대기 다운로드=%zu", s->handle,
+         s->restoreLiveView, s->restoreEvents, pending);
+}
+
+static int resumeSession(const std::shared_ptr<CameraSession> &s, int fd, const char *libDir,
+                         int vendorId, int productId, int usbClass) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (!s->suspended.load()) return GP_ERROR_BAD_PARAMETERS;
+
+    int ret = openSessionFast(*s, fd, libDir, vendorId, productId, usbClass, true);
+    if (ret != GP_OK) {
+        // 다시 LOST 로 두어 다음 재부착 때 재시도
+        s->connection.noteResult(GP_ERROR_IO_USB_FIND);
+        return ret;
+    }
+
+    s->suspended.store(false);
+    s->reconnects++;
+    if (s->restoreEvents && s->eventCallback) startEventThreadLocked(s);
+    if (s->restoreLiveView && s->liveViewCallback) startLiveViewThreadLocked(s);
+    LOGD("세션[%d] 재연결 #%d: liveView=%d events=%d", s->handle, s->reconnects.load(),
+         s->restoreLiveView, s->restoreEvents);
+    s->restoreLiveView = false;
+    s->restoreEvents = false;
+    return GP_OK;
+}
+
+// 연결했던 장치와 같은지 (모르는 값(0)은 통과)
+static bool sessionMatchesDevice(const CameraSession &s, int vendorId, int productId) {
+    return (s.usbVendor == 0 || s.usbVendor == vendorId) &&
+           (s.usbProduct == 0 || s.usbProduct == productId);
+}
+
+static void reconnectSupervisorLoop() {
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(RECONNECT_SUPERVISOR_INTERVAL_MS));
+        for (const auto &s: SessionRegistry::instance().all()) {
+            if (!s->suspended.load() && s->connection.state() == ConnectionState::LOST) {
+                suspendSession(s);
+            }
+        }
+    }
+}
+
+// 첫 연결 때 한 번 시작해 프로세스 수명 동안 유지 (세션 락을 쥔 채 불려도 됨)
+static void startReconnectSupervisor() {
+    static std::once_flag once;
+    std::call_once(once, [] { std::thread(reconnectSupervisorLoop).detach(); });
+}
+
+// USB 분리 알림: 해당 장치의 세션을 바로 suspend (에러 코드로 감지되기를 기다리지 않음)
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_onUsbDeviceDetached(JNIEnv *env, jobject,
+                                                          jint vendorId, jint productId) {
+    for (const auto &s: SessionRegistry::instance().all()) {
+        if (s->suspended.load() || s->connection.state() == ConnectionState::DISCONNECTED) continue;
+        if (!sessionMatchesDevice(*s, vendorId, productId)) continue;
+
+        LOGD("onUsbDeviceDetached: 세션[%d] %04x:%04x", s->handle, vendorId, productId);
+        s->connection.noteResult(GP_ERROR_IO_USB_FIND);
+        suspendSession(s);
+    }
+}
+
+// 재부착된 장치로 suspend 된 세션 복원. 성공 시 세션 핸들, 대상이 없으면
+// GP_ERROR_MODEL_NOT_FOUND (호출자는 일반 초기화로 진행)
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_reconnectSession(
+        JNIEnv *env, jobject, jint fd, jstring libDir_,
+        jint vendorId, jint productId, jint usbClass) {
+
+    std::shared_ptr<CameraSession> target;
+    for (const auto &s: SessionRegistry::instance().all()) {
+        if (s->suspended.load() && sessionMatchesDevice(*s, vendorId, productId)) {
+            target = s;
+            break;
+        }
+    }
+    if (!target) return GP_ERROR_MODEL_NOT_FOUND;
+
+    const char *libDir = env->GetStringUTFChars(libDir_, nullptr);
+    startupTimeline.reset(("reconnect " + std::to_string(target->handle)).c_str());
+    int ret = resumeSession(target, fd, libDir, vendorId, productId, usbClass);
+    env->ReleaseStringUTFChars(libDir_, libDir);
+    LOGD("%s", startupTimeline.summary().c_str());
+
+    return ret == GP_OK ? target->handle : ret;
+}
+
+// [{"handle":1,"fd":42,"description":"...","connection":{...}}, ...] - 열린 세션만
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_listSessionsJson(JNIEnv *env, jobject) {
+    std::ostringstream oss;
+    oss << "[";
+    bool first = true;
+    for (const auto &s: SessionRegistry::instance().all()) {
+        if (s->connection.state() == ConnectionState::DISCONNECTED) continue;
+        if (!first) oss << ",";
+        oss << "{\"handle\":" << s->handle << ",\"fd\":" << s->fd
+            << ",\"description\":\"" << escapeJsonString(s->connection.description()) << "\""
+            << ",\"pendingCommands\":" << s->commands.pending()
+            << ",\"suspended\":" << (s->suspended.load() ? "true" : "false")
+            << ",\"reconnects\":" << s->reconnects.load()
+            << ",\"connection\":" << s->connection.toJson() << "}";
+        first = false;
+    }
+    oss << "]";
+    return env->NewStringUTF(oss.str().c_str());
+}
+
+// 세션 명령 큐에서 촬영 (다른 세션과 병렬, 같은 세션 안에서는 순차)
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_sessionCapture(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return GP_ERROR_BAD_PARAMETERS;
+
+    std::future<int> f = s->commands.post(CommandQueue::PRIORITY_HIGH,
+                                          [s]() { return sessionCaptureCommand(s); });
+    return f.get();
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_sessionGetSummary(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return env->NewStringUTF("Camera not initialized");
+
+    std::string summary;
+    std::future<int> f = s->commands.post(CommandQueue::PRIORITY_NORMAL, [s, &summary]() {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (!s->camera) return (int) GP_ERROR;
+
+        CameraText txt;
+        int ret = gp_camera_get_summary(s->camera, &txt, s->context);
+        s->connection.noteResult(ret);
+        if (ret >= GP_OK) summary = txt.text;
+        return ret;
+    });
+    int ret = f.get();
+    return env->NewStringUTF(ret >= GP_OK ? summary.c_str() : gp_result_as_string(ret));
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_sessionGetConnectionStateJson(JNIEnv *env, jobject,
+                                                                    jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return env->NewStringUTF("{\"error\":\"No such session\"}");
+    return env->NewStringUTF(s->connection.toJson().c_str());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_sessionListenEvents(JNIEnv *env, jobject, jint handle,
+                                                          jobject callback) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) startEventPump(env, s, callback);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_sessionStopEvents(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) stopEventPump(s, false);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_sessionStartLiveView(JNIEnv *env, jobject, jint handle,
+                                                           jobject callback) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) startLiveViewPump(env, s, callback);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_sessionStopLiveView(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) stopLiveViewPump(env, s);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_sessionRequestCapture(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) s->captureRequested.store(true);
+}
+
+// ----------------------------------------------------------------------------
+// 동기 트리거 ("fire all") - handles 가 비어 있으면 열린 모든 세션
+// 결과 JSON: armed/armUs/dispatchSkewUs/fileAddedSpreadUs + 카메라별 시각(us)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_syncTrigger(JNIEnv *env, jobject, jintArray handles_,
+                                                  jint eventTimeoutMs) {
+    std::vector<std::shared_ptr<CameraSession>> sessions;
+    jsize n = handles_ ? env->GetArrayLength(handles_) : 0;
+    if (n > 0) {
+        std::vector<jint> handles(n);
+        env->GetIntArrayRegion(handles_, 0, n, handles.data());
+        for (jint h: handles) {
+            std::shared_ptr<CameraSession> s = sessionFor(h);
+            if (s) sessions.push_back(s);
+        }
+    } else {
+        for (const auto &s: SessionRegistry::instance().all()) {
+            if (s->connection.state() != ConnectionState::DISCONNECTED) sessions.push_back(s);
+        }
+    }
+
+    SyncTriggerResult result;
+    syncTrigger(sessions, SYNC_TRIGGER_ARM_TIMEOUT_MS,
+                eventTimeoutMs > 0 ? eventTimeoutMs : SYNC_TRIGGER_EVENT_TIMEOUT_MS, result);
+    return env->NewStringUTF(result.toJson().c_str());
+}
+
+// ----------------------------------------------------------------------------
+// 카메라 파일 색인
+//  - 색인 스레드가 walkCameraFiles 를 돌리며 새로 붙은 구간을 onIndexBatch(JSON 배열)
+//    로 흘려보내고, 끝나면 onIndexComplete(파일 수, 소요 ms, 결과 코드).
+//  - 색인 결과는 세션에 남아 getCameraIndexJson 으로 다시 읽을 수 있다.
+// ----------------------------------------------------------------------------
+static void cameraIndexLoop(std::shared_ptr<CameraSession> s, jobject listener) {
+    JNIEnv *env;
+    if (gJvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("cameraIndex: AttachCurrentThread 실패");
+        s->indexing.store(false);
+        return;
+    }
+    jclass cls = env->GetObjectClass(listener);
+    jmethodID onBatch = env->GetMethodID(cls, "onIndexBatch", "(Ljava/lang/String;)V");
+    jmethodID onComplete = env->GetMethodID(cls, "onIndexComplete", "(IJI)V");
+    env->DeleteLocalRef(cls);
+
+    auto start = std::chrono::steady_clock::now();
+    s->fileIndex.clear();
+    int ret = walkCameraFiles(s, s->fileIndex, s->indexCancel, [&](size_t from, size_t to) {
+        jstring js = env->NewStringUTF(s->fileIndex.toJson(from, to - from).c_str());
+        env->CallVoidMethod(listener, onBatch, js);
+        env->DeleteLocalRef(js);
+    });
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+    env->CallVoidMethod(listener, onComplete, (jint) s->fileIndex.size(), (jlong) ms, ret);
+    env->DeleteGlobalRef(listener);
+    s->indexing.store(false);
+    gJvm->DetachCurrentThread();
+}
+
+// ----------------------------------------------------------------------------
+// 새 파일만 가져오기
+//  - 카드를 다시 색인한 뒤 ImportedIndex 에 없는 파일과 크기/시각이 바뀐 파일만
+//    runBulkImport 로 내려받는다 (USB 는 명령 큐 NORMAL, 해시/쓰기는 겹쳐서).
+//  - 받을 때마다 onFileImported(로컬 경로, 폴더, 이름), 끝나면
+//    onSyncComplete(가져옴, 건너뜀, 실패, 결과 코드). 다운로드 저널에도 기록한다.
+// ----------------------------------------------------------------------------
+#define IMPORT_SYNC_FLUSH_EVERY 16
+
+static void importSyncLoop(std::shared_ptr<CameraSession> s, jobject listener) {
+    JNIEnv *env;
+    if (gJvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("importSync: AttachCurrentThread 실패");
+        s->indexing.store(false);
+        return;
+    }
+    jclass cls = env->GetObjectClass(listener);
+    jmethodID onImported = env->GetMethodID(
+            cls, "onFileImported", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
+    jmethodID onStats = env->GetMethodID(cls, "onSyncStats", "(Ljava/lang/String;)V");
+    jmethodID onComplete = env->GetMethodID(cls, "onSyncComplete", "(IIII)V");
+    env->DeleteLocalRef(cls);
+
+    auto start = std::chrono::steady_clock::now();
+    std::string serial;
+    int ret = s->commands.post(CommandQueue::PRIORITY_NORMAL, [&s, &serial]() {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (!s->camera) return (int) GP_ERROR_CANCEL;
+        ensureSerialLocked(*s);
+        serial = s->serial;
+        return (int) GP_OK;
+    }).get();
+
+    // 색인은 매번 새로 (이전 색인 이후 찍은 파일이 빠지지 않도록)
+    if (ret >= GP_OK) {
+        s->fileIndex.clear();
+        ret = walkCameraFiles(s, s->fileIndex, s->indexCancel, nullptr);
+    }
+
+    ImportedIndex &imported = ImportedIndex::instance();
+    DownloadJournal &journal = DownloadJournal::instance();
+    int skipped = 0;
+    std::vector<BulkImportItem> items;
+    std::vector<int64_t> mtimes;        // items 와 같은 순서 (다음 비교 기준으로 기록)
+    if (ret >= GP_OK) {
+        for (const CameraIndex::Entry &e: s->fileIndex.snapshot(0, s->fileIndex.size())) {
+            if (imported.lookup(serial, e.folder.c_str(), e.name.c_str(), e.size, e.mtime) ==
+                ImportedIndex::IMPORTED) {
+                skipped++;
+                continue;
+            }
+            BulkImportItem item;
+            item.folder = e.folder;
+            item.name = e.name;
+            item.localDir = storageDir;
+            item.sizeHint = e.size;
+            items.push_back(item);
+            mtimes.push_back(e.mtime);
+        }
+    }
+
+    // USB 단계는 명령 큐(NORMAL)로 - 촬영은 파일 사이에 끼어든다
+    auto fetch = [&s, &serial, &journal](const BulkImportItem &item, CameraFile *file) {
+        journal.appendPending(serial, item.folder.c_str(), item.name.c_str());
+        return s->commands.post(CommandQueue::PRIORITY_NORMAL, [&s, &item, file]() {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->camera) return (int) GP_ERROR_CANCEL;
+            int r = gp_camera_file_get(s->camera, item.folder.c_str(), item.name.c_str(),
+                                       GP_FILE_TYPE_NORMAL, file, s->context);
+            s->connection.noteResult(r);
+            return r;
+        }).get();
+    };
+    auto shouldAbort = [&s](int r) {
+        // 남은 파일은 저널에 PENDING 으로 남아 재연결/다음 동기화 때 이어받는다
+        return r == GP_ERROR_CANCEL || s->connection.state() == ConnectionState::LOST;
+    };
+
+    int done = 0;
+    auto onDone = [&](const BulkImportItem &item, const BulkImportResult &r) {
+        if (shouldAbort(r.result)) return;
+        if (r.result < GP_OK) {
+            LOGE("importSync[%d]: %s/%s 실패 (%s)", s->handle, item.folder.c_str(),
+                 item.name.c_str(), gp_result_as_string(r.result));
+            journal.appendFailed(serial, item.folder.c_str(), item.name.c_str());
+            return;
+        }
+
+        onPhotoStored(r.localPath, r.bytes);
+
+        // 크기/시각은 색인값 그대로 기록 (다음 비교 기준)
+        imported.markImported(serial, item.folder.c_str(), item.name.c_str(), item.sizeHint,
+                              mtimes[&item - items.data()]);
+        PhotoStore::instance().setOrigin(
+                r.localPath, ImportedIndex::keyOf(serial, item.folder.c_str(), item.name.c_str()));
+        journal.appendDone(serial, item.folder.c_str(), item.name.c_str(),
+                           r.localPath.substr(r.localPath.find_last_of('/') + 1));
+        if (++done % IMPORT_SYNC_FLUSH_EVERY == 0) imported.sync(false);
+
+        jstring jp = env->NewStringUTF(r.localPath.c_str());
+        jstring jf = env->NewStringUTF(item.folder.c_str());
+        jstring jn = env->NewStringUTF(item.name.c_str());
+        env->CallVoidMethod(listener, onImported, jp, jf, jn);
+        env->DeleteLocalRef(jp);
+        env->DeleteLocalRef(jf);
+        env->DeleteLocalRef(jn);
+    };
+
+    BulkImportStats stats;
+    if (ret >= GP_OK && !items.empty()) {
+        uint64_t budget = (uint64_t) s->importBudgetMb.load() * 1024 * 1024;
+        ret = runBulkImport(items, budget, fetch, onDone, shouldAbort, s->indexCancel, stats);
+    }
+    imported.sync(true);
+    journal.flush();
+
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGD("importSync[%d]: 가져옴 %d (중복 %d), 건너뜀 %d, 실패 %d, %lldms, USB %.1fMB/s, 전체 %.1fMB/s (%s)",
+         s->handle, stats.files, stats.duplicates, skipped, stats.failed, ms, stats.usbMBps(),
+         stats.endToEndMBps(), gp_result_as_string(ret));
+
+    jstring js = env->NewStringUTF(stats.toJson().c_str());
+    env->CallVoidMethod(listener, onStats, js);
+    env->DeleteLocalRef(js);
+    env->CallVoidMethod(listener, onComplete, stats.files, skipped, stats.failed, ret);
+    env->DeleteGlobalRef(listener);
+    s->indexing.store(false);
+    gJvm->DetachCurrentThread();
+}
+
+// 색인/가져오기는 세션마다 하나씩만 (이미 진행 중이면 false)
+static bool startIndexThread(JNIEnv *env, const std::shared_ptr<CameraSession> &s,
+                             void (*loop)(std::shared_ptr<CameraSession>, jobject),
+                             jobject listener) {
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (s->indexing.exchange(true)) return false;
+    if (s->indexThread.joinable()) s->indexThread.join();
+    s->indexCancel.store(false);
+    s->indexThread = std::thread(loop, s, env->NewGlobalRef(listener));
+    return true;
+}
+
+// memoryBudgetMb: 받았지만 아직 디스크에 못 쓴 데이터 상한 (0 이하면 기본값)
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_startImportSync(JNIEnv *env, jobject, jint handle,
+                                                      jobject listener, jint memoryBudgetMb) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return JNI_FALSE;
+    s->importBudgetMb.store(memoryBudgetMb > 0 ? memoryBudgetMb : BULK_IMPORT_DEFAULT_BUDGET_MB);
+    return startIndexThread(env, s, importSyncLoop, listener) ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_cancelImportSync(JNIEnv *, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) s->indexCancel.store(true);
+}
+
+// 지금까지 가져온 파일 수 (모든 카메라)
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_inik_phototest2_CameraNative_getImportedCount(JNIEnv *, jobject) {
+    return (jlong) ImportedIndex::instance().count();
+}
+
+// ----------------------------------------------------------------------------
+// 썸네일 갤러리
+//  - startThumbnails 로 세션별 선읽기 스레드를 띄우고, 스크롤할 때마다
+//    requestThumbnails 로 "보이는 것 + 곧 보일 것" 목록을 스크롤 순서대로 넘긴다.
+//  - 전달: onThumbnail(폴더, 이름, 폭, 높이, RGBA ByteBuffer). 버퍼는 콜백 안에서만
+//    유효하므로 Bitmap.copyPixelsFromBuffer 등으로 바로 복사해야 한다.
+// ----------------------------------------------------------------------------
+static void thumbnailLoop(std::shared_ptr<CameraSession> s, jobject callback, int maxEdge) {
+    JNIEnv *env;
+    if (gJvm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("thumbnails: AttachCurrentThread 실패");
+        env = nullptr;
+    }
+    if (env) {
+        jclass cls = env->GetObjectClass(callback);
+        jmethodID onThumb = env->GetMethodID(
+                cls, "onThumbnail",
+                "(Ljava/lang/String;Ljava/lang/String;IILjava/nio/ByteBuffer;)V");
+        jmethodID onFailed = env->GetMethodID(cls, "onThumbnailFailed",
+                                              "(Ljava/lang/String;Ljava/lang/String;I)V");
+        env->DeleteLocalRef(cls);
+
+        std::string serial;
+        s->commands.post(CommandQueue::PRIORITY_NORMAL, [&s, &serial]() {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            if (!s->camera) return (int) GP_ERROR_CANCEL;
+            ensureSerialLocked(*s);
+            serial = s->serial;
+            return (int) GP_OK;
+        }).get();
+
+        s->thumbs.run(*s, serial, maxEdge, [&](const ThumbnailPrefetcher::Request &req,
+                                               const std::shared_ptr<const Thumbnail> &thumb,
+                                               int result) {
+            jstring jf = env->NewStringUTF(req.folder.c_str());
+            jstring jn = env->NewStringUTF(req.name.c_str());
+            if (thumb) {
+                jobject buf = env->NewDirectByteBuffer(
+                        const_cast<uint8_t *>(thumb->rgba.data()), (jlong) thumb->rgba.size());
+                env->CallVoidMethod(callback, onThumb, jf, jn, thumb->width, thumb->height, buf);
+                env->DeleteLocalRef(buf);
+            } else {
+                env->CallVoidMethod(callback, onFailed, jf, jn, result);
+            }
+            env->DeleteLocalRef(jf);
+            env->DeleteLocalRef(jn);
+        });
+        env->DeleteGlobalRef(callback);
+        gJvm->DetachCurrentThread();
+    }
+    s->thumbsRunning.store(false);
+}
+
+// maxEdge: 디코드 후 긴 변의 최소 길이 (DCT 축소 기준, 0 이하면 기본값)
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_startThumbnails(JNIEnv *env, jobject, jint handle,
+                                                      jobject callback, jint maxEdge) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return JNI_FALSE;
+
+    std::lock_guard<std::mutex> life(s->lifecycle);
+    if (s->thumbsRunning.exchange(true)) return JNI_FALSE;
+    if (s->thumbThread.joinable()) s->thumbThread.join();
+    s->thumbs.start();
+    s->thumbThread = std::thread(thumbnailLoop, s, env->NewGlobalRef(callback),
+                                 maxEdge > 0 ? maxEdge : THUMB_DEFAULT_MAX_EDGE);
+    return JNI_TRUE;
+}
+
+// 스크롤 순서대로 정렬된 목록 (앞의 visibleCount 개가 화면에 보이는 항목).
+// 이전 목록에서 빠진 항목의 가져오기는 취소된다.
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_requestThumbnails(JNIEnv *env, jobject, jint handle,
+                                                        jobjectArray folders,
+                                                        jobjectArray names, jint visibleCount) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return;
+
+    std::vector<ThumbnailPrefetcher::Request> ordered;
+    jsize n = std::min(env->GetArrayLength(folders), env->GetArrayLength(names));
+    ordered.reserve(n);
+    for (jsize i = 0; i < n; i++) {
+        auto jf = (jstring) env->GetObjectArrayElement(folders, i);
+        auto jn = (jstring) env->GetObjectArrayElement(names, i);
+        const char *f = env->GetStringUTFChars(jf, nullptr);
+        const char *nm = env->GetStringUTFChars(jn, nullptr);
+        ordered.push_back(ThumbnailPrefetcher::Request{f, nm});
+        env->ReleaseStringUTFChars(jf, f);
+        env->ReleaseStringUTFChars(jn, nm);
+        env->DeleteLocalRef(jf);
+        env->DeleteLocalRef(jn);
+    }
+    s->thumbs.setWanted(ordered, visibleCount);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_stopThumbnails(JNIEnv *, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) stopThumbnailPump(*s);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setThumbnailCacheLimits(JNIEnv *, jobject, jint memoryMb,
+                                                              jint diskMb) {
+    ThumbnailCache::instance().setLimits((size_t) std::max(memoryMb, 1) * 1024 * 1024,
+                                         (size_t) std::max(diskMb, 1) * 1024 * 1024);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getThumbnailCacheStatsJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(ThumbnailCache::instance().statsJson().c_str());
+}
+
+// 내려받은 JPEG 의 썸네일 경로 (없으면 만든다, 실패하면 null)
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_makeThumbnail(JNIEnv *env, jobject, jstring path_,
+                                                    jint maxEdge) {
+    const char *path = env->GetStringUTFChars(path_, nullptr);
+    std::string thumbPath;
+    int ret = makePhotoThumbnail(path, maxEdge, thumbPath);
+    env->ReleaseStringUTFChars(path_, path);
+    return ret >= GP_OK ? env->NewStringUTF(thumbPath.c_str()) : nullptr;
+}
+
+// 공유용 축소본 (<원본>.share.jpg) 을 CPU 풀에서 동시에 만들고 끝날 때까지 기다린다.
+// 입력 순서대로 경로, 실패한 항목은 null. UI 스레드에서 부르지 말 것
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_inik_phototest2_CameraNative_exportShareImages(JNIEnv *env, jobject, jobjectArray paths,
+                                                        jfloat megapixels, jint quality) {
+    std::vector<std::string> outPaths =
+            exportSharePhotos(toStringVector(env, paths), megapixels, quality);
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray out = env->NewObjectArray((jsize) outPaths.size(), stringClass, nullptr);
+    for (size_t i = 0; i < outPaths.size(); i++) {
+        if (outPaths[i].empty()) continue;
+        jstring js = env->NewStringUTF(outPaths[i].c_str());
+        env->SetObjectArrayElement(out, (jsize) i, js);
+        env->DeleteLocalRef(js);
+    }
+    env->DeleteLocalRef(stringClass);
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// EXIF 메타데이터 (열 지향 색인)
+//  - 내려받은 파일은 자동으로 색인 (키: 로컬 파일명)
+//  - 카메라에만 있는 파일은 readCameraExifJson 으로 앞부분만 읽어 색인 (키: 폴더/이름)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getExifJson(JNIEnv *env, jobject, jstring path_) {
+    const char *path = env->GetStringUTFChars(path_, nullptr);
+    ExifInfo info;
+    bool ok = exifParseFile(path, info);
+    env->ReleaseStringUTFChars(path_, path);
+    return env->NewStringUTF(ok ? exifInfoJson(info).c_str() : "{\"ok\":false}");
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_readCameraExifJson(JNIEnv *env, jobject, jint handle,
+                                                         jstring folder_, jstring name_) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return env->NewStringUTF("{\"ok\":false}");
+    const char *f = env->GetStringUTFChars(folder_, nullptr);
+    const char *n = env->GetStringUTFChars(name_, nullptr);
+    std::string folder = f, name = n;
+    env->ReleaseStringUTFChars(folder_, f);
+    env->ReleaseStringUTFChars(name_, n);
+
+    ExifInfo info;
+    int ret = s->commands.post(CommandQueue::PRIORITY_NORMAL, [&s, &folder, &name, &info]() {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (!s->camera) return (int) GP_ERROR_CANCEL;
+        int r = exifReadCamera(s->camera, s->context, folder.c_str(), name.c_str(), info);
+        if (r != GP_ERROR_CORRUPTED_DATA) s->connection.noteResult(r);
+        return r;
+    }).get();
+    if (ret < GP_OK) {
+        LOGE("readCameraExif[%d]: %s/%s (%s)", handle, folder.c_str(), name.c_str(),
+             gp_result_as_string(ret));
+        return env->NewStringUTF("{\"ok\":false}");
+    }
+    ExifIndex::instance().put(folder + "/" + name, info);
+    return env->NewStringUTF(exifInfoJson(info).c_str());
+}
+
+// ----------------------------------------------------------------------------
+// RAW 안의 미리보기 JPEG (부분 읽기, 수 MB 만 전송)
+//  - IFD0 방향이 있으면 무손실로 세워서 돌려준다. RAW 가 아니거나 카메라가 부분
+//    읽기를 못 하면 null (그때는 GP_FILE_TYPE_PREVIEW 썸네일이나 전체 다운로드로)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jbyteArray JNICALL
+Java_com_inik_phototest2_CameraNative_readRawPreview(JNIEnv *env, jobject, jint handle,
+                                                     jstring folder_, jstring name_) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return nullptr;
+    const char *f = env->GetStringUTFChars(folder_, nullptr);
+    const char *n = env->GetStringUTFChars(name_, nullptr);
+    std::string folder = f, name = n;
+    env->ReleaseStringUTFChars(folder_, f);
+    env->ReleaseStringUTFChars(name_, n);
+
+    RawPreview preview;
+    int ret = s->commands.post(CommandQueue::PRIORITY_NORMAL, [&s, &folder, &name, &preview]() {
+        std::lock_guard<std::mutex> lock(s->mutex);
+        if (!s->camera) return (int) GP_ERROR_CANCEL;
+        int r = rawPreviewRead(s->camera, s->context, folder.c_str(), name.c_str(), preview);
+        if (r != GP_ERROR_NOT_SUPPORTED && r != GP_ERROR_CORRUPTED_DATA) s->connection.noteResult(r);
+        return r;
+    }).get();
+    if (ret < GP_OK) {
+        LOGE("readRawPreview[%d]: %s/%s (%s)", handle, folder.c_str(), name.c_str(),
+             gp_result_as_string(ret));
+        return nullptr;
+    }
+
+    // 카메라 락 밖에서 (USB 를 잡지 않음)
+    std::vector<uint8_t> upright;
+    const std::vector<uint8_t> *jpeg = &preview.jpeg;
+    if (preview.orientation >= 2 &&
+        jpegTransformOrientation(preview.jpeg.data(), preview.jpeg.size(), preview.orientation,
+                                 upright)) {
+        jpeg = &upright;
+    }
+    jbyteArray out = env->NewByteArray((jsize) jpeg->size());
+    if (!out) return nullptr;   // OutOfMemoryError 가 걸려 있음
+    env->SetByteArrayRegion(out, 0, (jsize) jpeg->size(),
+                            reinterpret_cast<const jbyte *>(jpeg->data()));
+    return out;
+}
+
+// ranges: 필드마다 [min, max] 쌍 (NaN 은 제한 없음, null 이면 거르지 않음). 행 번호 배열
+extern "C" JNIEXPORT jintArray JNICALL
+Java_com_inik_phototest2_CameraNative_queryExif(JNIEnv *env, jobject, jint sortField,
+                                                jboolean descending, jdoubleArray ranges) {
+    ExifIndex::Query q;
+    q.sortBy = sortField;
+    q.descending = descending == JNI_TRUE;
+    if (ranges) {
+        jsize n = std::min<jsize>(env->GetArrayLength(ranges), ExifIndex::FIELD_COUNT * 2);
+        env->GetDoubleArrayRegion(ranges, 0, n, q.ranges);
+    }
+    std::vector<int> rows = ExifIndex::instance().query(q);
+
+    jintArray out = env->NewIntArray((jsize) rows.size());
+    if (out && !rows.empty()) {
+        env->SetIntArrayRegion(out, 0, (jsize) rows.size(), reinterpret_cast<jint *>(rows.data()));
+    }
+    return out;
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getExifRowsJson(JNIEnv *env, jobject, jintArray rows_) {
+    std::vector<int> rows(env->GetArrayLength(rows_));
+    if (!rows.empty()) {
+        env->GetIntArrayRegion(rows_, 0, (jsize) rows.size(), reinterpret_cast<jint *>(rows.data()));
+    }
+    return env->NewStringUTF(ExifIndex::instance().rowsJson(rows).c_str());
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_getExifIndexSize(JNIEnv *, jobject) {
+    return (jint) ExifIndex::instance().size();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_clearExifIndex(JNIEnv *, jobject) {
+    ExifIndex::instance().clear();
+}
+
+// ----------------------------------------------------------------------------
+// 후처리 CPU 풀 (썸네일/EXIF/해시/재인코드)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setCpuPoolLimit(JNIEnv *, jobject, jint jobType,
+                                                      jint maxConcurrent) {
+    if (jobType < 0 || jobType >= CpuPool::JOB_TYPE_COUNT) return;
+    CpuPool::instance().setLimit((CpuPool::JobType) jobType, maxConcurrent);
+}
+
+// 가져온 세로 JPEG 을 무손실로 세워 저장 (기본 켜짐, 보관용 SHA-256 을 켜면 건너뜀)
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_setOrientationNormalizeEnabled(JNIEnv *, jobject,
+                                                                     jboolean enabled) {
+    setOrientationNormalizeEnabled(enabled == JNI_TRUE);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getCpuPoolStatsJson(JNIEnv *env, jobject) {
+    return env->NewStringUTF(CpuPool::instance().statsJson().c_str());
+}
+
+// 이미 색인 중이면 false
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_startCameraIndex(JNIEnv *env, jobject, jint handle,
+                                                       jobject listener) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return JNI_FALSE;
+    return startIndexThread(env, s, cameraIndexLoop, listener) ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_inik_phototest2_CameraNative_cancelCameraIndex(JNIEnv *, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (s) s->indexCancel.store(true);
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getCameraIndexJson(JNIEnv *env, jobject, jint handle,
+                                                         jint offset, jint count) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s || offset < 0 || count < 0) return env->NewStringUTF("[]");
+    return env->NewStringUTF(s->fileIndex.toJson(offset, count).c_str());
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getCameraIndexStatsJson(JNIEnv *env, jobject, jint handle) {
+    std::shared_ptr<CameraSession> s = sessionFor(handle);
+    if (!s) return env->NewStringUTF("{\"error\":\"No such session\"}");
+    return env->NewStringUTF(s->fileIndex.statsJson().c_str());
 }
 
 // ----------------------------------------------------------------------------
@@ -792,24 +2471,21 @@ Java_com_inik_phototest2_CameraNative_requestCapture(JNIEnv *env, jobject) {
 extern "C"
 JNIEXPORT jstring JNICALL
 Java_com_inik_phototest2_CameraNative_listCameraAbilities(JNIEnv *env, jclass) {
-    std::lock_guard<std::mutex> lock(cameraMutex);
-    if (!camera) return env->NewStringUTF("{\"error\":\"Camera not initialized\"}");
-
-    CameraAbilitiesList *alist = nullptr;
-    gp_abilities_list_new(&alist);
-    gp_abilities_list_load(alist, context);
-
     CameraAbilities realAbilities;
-    gp_camera_get_abilities(camera, &realAbilities);
-    int idx = gp_abilities_list_lookup_model(alist, realAbilities.model);
+    {
+        std::lock_guard<std::mutex> lock(cameraMutex);
+        if (!camera) return env->NewStringUTF("{\"error\":\"Camera not initialized\"}");
+        gp_camera_get_abilities(camera, &realAbilities);
+    }
+
+    // 전역 abilities 캐시에서 해시 조회 (최초 1회만 camlib 로드, 카메라 락 밖에서 기다린다)
+    CameraAbilities cap;
+    bool found = AbilitiesCache::instance().lookupModel(realAbilities.model, cap);
 
     std::ostringstream oss;
-    if (idx < 0) {
+    if (!found) {
         oss << "{\"error\":\"Model not found: " << realAbilities.model << "\"}";
     } else {
-        CameraAbilities cap;
-        gp_abilities_list_get_abilities(alist, idx, &cap);
-
         oss << "{";
         bool first = true;
 
@@ -848,7 +2524,6 @@ Java_com_inik_phototest2_CameraNative_listCameraAbilities(JNIEnv *env, jclass) {
         oss << "}";
     }
 
-    gp_abilities_list_free(alist);
     return env->NewStringUTF(oss.str().c_str());
 }
 
@@ -862,38 +2537,187 @@ Java_com_inik_phototest2_CameraNative_buildWidgetJson(JNIEnv *env, jobject) {
         return env->NewStringUTF("{\"error\":\"Camera not initialized\"}");
     }
 
-    // 최대 5회 재시도
+    // 최대 5회 재시도 (위젯 트리를 새로 읽어 스냅샷/인덱스 갱신)
     const int maxRetries = 5;
     const int delayMs = 500;
 
-    CameraWidget *config = nullptr;
     int ret = -1;
     for (int i = 0; i < maxRetries; i++) {
-        ret = gp_camera_get_config(camera, &config, context);
+        ret = reloadConfigSnapshot(camera, context);
         if (ret == GP_OK) {
             break;
         } else if (ret == GP_ERROR_IO_IN_PROGRESS) {
-            if (config) {
-                gp_widget_free(config);
-                config = nullptr;
-            }
             std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
         } else {
             break;
         }
     }
 
-    if (ret < GP_OK || !config) {
+    if (ret < GP_OK || !configSnapshot.valid()) {
         std::ostringstream oss;
         oss << "{\"error\":\"gp_camera_get_config failed: "
             << gp_result_as_string(ret) << "\"}";
         return env->NewStringUTF(oss.str().c_str());
     }
 
-    std::string json = buildWidgetJson(config);
-    gp_widget_free(config);
+    std::string json = buildWidgetJson(configSnapshot.root());
+    if (ensureSchemaKey(camera, context)) schemaCache.store(json);
+    return env->NewStringUTF(json.c_str());
+}
+
+// ----------------------------------------------------------------------------
+// 디스크에 캐시된 위젯 스키마 (없으면 error) - 카메라 왕복 없이 UI 를 먼저 그림
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getCachedWidgetJson(JNIEnv *env, jobject) {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (!camera) {
+        return env->NewStringUTF("{\"error\":\"Camera not initialized\"}");
+    }
+
+    std::string json;
+    if (!ensureSchemaKey(camera, context) || !schemaCache.load(json)) {
+        return env->NewStringUTF("{\"error\":\"No cached schema\"}");
+    }
+    LOGD("getCachedWidgetJson: 캐시 사용 (%zu bytes)", json.size());
     return env->NewStringUTF(json.c_str());
 }
+
+// ----------------------------------------------------------------------------
+// 위젯 현재값만 읽기 (스키마는 캐시에서, 값은 카메라에서)
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_getWidgetValuesJson(JNIEnv *env, jobject) {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (!camera) {
+        return env->NewStringUTF("{\"error\":\"Camera not initialized\"}");
+    }
+
+    int ret = reloadConfigSnapshot(camera, context);
+    if (ret < GP_OK) {
+        std::ostringstream oss;
+        oss << "{\"error\":\"gp_camera_get_config failed: "
+            << gp_result_as_string(ret) << "\"}";
+        return env->NewStringUTF(oss.str().c_str());
+    }
+
+    // 값 폴링마다 스키마를 직렬화/쓰지 않는다: 이 키로 캐시가 아직 없을 때만
+    // (스키마 자체의 갱신은 buildWidgetJson 이 맡는다)
+    if (ensureSchemaKey(camera, context) && !schemaCache.hasStored()) {
+        schemaCache.store(buildWidgetJson(configSnapshot.root()));
+    }
+
+    std::string json = buildWidgetValuesJson(configSnapshot.index());
+    return env->NewStringUTF(json.c_str());
+}
+
+// ----------------------------------------------------------------------------
+// 설정 프리셋 (위젯 이름 → 값), 적용 시 바뀐 설정만 한 번에 전송
+// ----------------------------------------------------------------------------
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_savePreset(JNIEnv *env, jobject, jstring name_,
+                                                  jobjectArray keys_, jobjectArray values_) {
+    std::vector<std::string> keys = toStringVector(env, keys_);
+    std::vector<std::string> values = toStringVector(env, values_);
+    if (keys.size() != values.size()) return JNI_FALSE;
+
+    PresetEntries entries;
+    for (size_t i = 0; i < keys.size(); i++) entries.emplace_back(keys[i], values[i]);
+
+    const char *name = env->GetStringUTFChars(name_, nullptr);
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    presetStore.put(name, entries);
+    bool ok = presetStore.save();
+    LOGD("savePreset: %s (%zu개)", name, entries.size());
+    env->ReleaseStringUTFChars(name_, name);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+// 현재 카메라 값으로 프리셋 생성 (keys 에 있는 위젯만)
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_capturePreset(JNIEnv *env, jobject, jstring name_,
+                                                     jobjectArray keys_) {
+    std::vector<std::string> keys = toStringVector(env, keys_);
+
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (!camera) return GP_ERROR;
+    int ret = ensureFreshConfigSnapshot(camera, context);
+    if (ret < GP_OK) return ret;
+
+    PresetEntries entries;
+    for (const std::string &k: keys) {
+        const WidgetNode *node = configSnapshot.index().findByName(k.c_str());
+        std::string value;
+        if (node && widgetValueToString(node->widget, value)) entries.emplace_back(k, value);
+    }
+
+    const char *name = env->GetStringUTFChars(name_, nullptr);
+    presetStore.put(name, entries);
+    presetStore.save();
+    LOGD("capturePreset: %s (%zu/%zu개)", name, entries.size(), keys.size());
+    env->ReleaseStringUTFChars(name_, name);
+    return static_cast<jint>(entries.size());
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_inik_phototest2_CameraNative_deletePreset(JNIEnv *env, jobject, jstring name_) {
+    const char *name = env->GetStringUTFChars(name_, nullptr);
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    bool removed = presetStore.remove(name);
+    if (removed) presetStore.save();
+    env->ReleaseStringUTFChars(name_, name);
+    return removed ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_inik_phototest2_CameraNative_listPresetsJson(JNIEnv *env, jobject) {
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    std::ostringstream oss;
+    oss << "{";
+    bool firstPreset = true;
+    for (const auto &p: presetStore.all()) {
+        if (!firstPreset) oss << ",";
+        oss << "\"" << escapeJsonString(p.first) << "\":{";
+        bool first = true;
+        for (const auto &e: p.second) {
+            if (!first) oss << ",";
+            oss << "\"" << escapeJsonString(e.first) << "\":\"" << escapeJsonString(e.second) << "\"";
+            first = false;
+        }
+        oss << "}";
+        firstPreset = false;
+    }
+    oss << "}";
+    return env->NewStringUTF(oss.str().c_str());
+}
+
+// 반환: 실제로 바꾼 설정 수 (0 이면 이미 같은 상태), 음수면 gPhoto2 에러
+extern "C" JNIEXPORT jint JNICALL
+Java_com_inik_phototest2_CameraNative_applyPreset(JNIEnv *env, jobject, jstring name_) {
+    const char *name = env->GetStringUTFChars(name_, nullptr);
+    std::string presetName = name;
+    env->ReleaseStringUTFChars(name_, name);
+
+    std::lock_guard<std::mutex> lock(cameraMutex);
+    if (!camera) return GP_ERROR;
+
+    const PresetEntries *entries = presetStore.get(presetName);
+    if (!entries) {
+        LOGE("applyPreset: 프리셋 없음 -> %s", presetName.c_str());
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+
+    int ret = ensureFreshConfigSnapshot(camera, context);
+    if (ret < GP_OK) return ret;
+
+    PresetApplyResult result;
+    ret = applyPreset(*entries, camera, context, configSnapshot, result);
+    connectionState.noteResult(ret);
+    LOGD("applyPreset: %s -> changed=%d unchanged=%d skipped=%d ret=%d", presetName.c_str(),
+         result.changed, result.unchanged, result.skipped, ret);
+    return ret < GP_OK ? ret : result.changed;
+}
+
 //#include <jni.h>
 //#include <android/log.h>
 //#include <mutex>
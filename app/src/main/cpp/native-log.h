@@ -0,0 +1,15 @@
+// app/src/main/cpp/native-log.h
+
+#ifndef NATIVE_LOG_H
+#define NATIVE_LOG_H
+
+#include <android/log.h>
+
+#ifndef TAG
+#define TAG "CameraNative"
+#endif
+
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
+
+#endif // NATIVE_LOG_H
@@ -0,0 +1,131 @@
+// app/src/main/cpp/photo-export.cpp
+
+#include "photo-export.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <future>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "cpu-pool.h"
+#include "exif-index.h"
+#include "jpeg-util.h"
+#include "native-log.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static long long msSince(Clock::time_point t0) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t0).count();
+}
+
+std::string photoSharePath(const std::string &photoPath) {
+    return photoPath + ".share.jpg";
+}
+
+static bool isJpegName(const std::string &path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = path.substr(dot + 1);
+    for (char &c: ext) c = (char) tolower((unsigned char) c);
+    return ext == "jpg" || ext == "jpeg";
+}
+
+int exportSharePhoto(const std::string &photoPath, double megapixels, int quality,
+                     std::string &outPath) {
+    outPath = photoSharePath(photoPath);
+    if (!isJpegName(photoPath)) return GP_ERROR_NOT_SUPPORTED;
+    if (megapixels <= 0) megapixels = SHARE_EXPORT_DEFAULT_MEGAPIXELS;
+    if (quality <= 0 || quality > 100) quality = SHARE_EXPORT_DEFAULT_QUALITY;
+
+    Clock::time_point t0 = Clock::now();
+    int fd = open(photoPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return GP_ERROR_FILE_NOT_FOUND;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return GP_ERROR_IO_READ;
+    }
+    size_t size = (size_t) st.st_size;
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return GP_ERROR_IO_READ;
+    const uint8_t *data = static_cast<const uint8_t *>(map);
+
+    ExifInfo exif;
+    exifParse(data, std::min(size, (size_t) EXIF_PREFIX_BYTES), exif);
+
+    int w = 0, h = 0, tw = 0, th = 0, denom = 1;
+    JpegImage decoded;
+    bool ok = jpegReadSize(data, size, w, h);
+    if (ok) {
+        fitArea(w, h, (int64_t) (megapixels * 1000000.0), tw, th);
+        denom = jpegPickScaleDenom(w, h, std::max(tw, th));
+        ok = jpegDecodeRgb(data, size, denom, decoded);
+    }
+    munmap(map, size);
+    if (!ok) return GP_ERROR_CORRUPTED_DATA;
+    long long decodeMs = msSince(t0);
+
+    Clock::time_point t1 = Clock::now();
+    JpegImage resized, upright;
+    const JpegImage *img = &decoded;
+    if (decoded.width != tw || decoded.height != th) {
+        resizeCubicRgb(decoded, tw, th, resized);
+        img = &resized;
+    }
+    if (exif.orientation >= 2 && exif.orientation <= 8) {
+        orientRgb(*img, exif.orientation, upright);
+        img = &upright;
+    }
+    long long resizeMs = msSince(t1);
+
+    Clock::time_point t2 = Clock::now();
+    std::vector<uint8_t> jpeg;
+    if (!jpegEncodeRgb(*img, quality, jpeg)) return GP_ERROR_CORRUPTED_DATA;
+    long long encodeMs = msSince(t2);
+
+    const std::string tmp = outPath + ".part";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return GP_ERROR_IO_WRITE;
+    ok = fwrite(jpeg.data(), 1, jpeg.size(), fp) == jpeg.size();
+    ok = fclose(fp) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), outPath.c_str()) != 0) {
+        remove(tmp.c_str());
+        return GP_ERROR_IO_WRITE;
+    }
+
+    LOGD("shareExport: %dx%d -(1/%d)-> %dx%d -> %dx%d q%d %zu bytes, decode %lldms resize %lldms "
+         "encode %lldms total %lldms", w, h, denom, decoded.width, decoded.height, img->width,
+         img->height, quality, jpeg.size(), decodeMs, resizeMs, encodeMs, msSince(t0));
+    return GP_OK;
+}
+
+std::vector<std::string> exportSharePhotos(const std::vector<std::string> &photoPaths,
+                                           double megapixels, int quality) {
+    std::vector<std::string> outPaths(photoPaths.size());
+    std::vector<std::future<int>> pending;
+    pending.reserve(photoPaths.size());
+    for (size_t i = 0; i < photoPaths.size(); i++) {
+        const std::string path = photoPaths[i];
+        std::string *out = &outPaths[i];
+        pending.push_back(CpuPool::instance().post(
+                CpuPool::JOB_ENCODE, [path, out, megapixels, quality]() {
+                    return exportSharePhoto(path, megapixels, quality, *out);
+                }));
+    }
+    for (size_t i = 0; i < pending.size(); i++) {
+        int ret = pending[i].get();
+        if (ret < GP_OK) {
+            LOGE("shareExport: %s 실패 (%d)", photoPaths[i].c_str(), ret);
+            outPaths[i].clear();
+        }
+    }
+    return outPaths;
+}
@@ -0,0 +1,35 @@
+// app/src/main/cpp/photo-export.h
+
+#ifndef PHOTO_EXPORT_H
+#define PHOTO_EXPORT_H
+
+#include <string>
+#include <vector>
+
+#define SHARE_EXPORT_DEFAULT_MEGAPIXELS 2.0
+#define SHARE_EXPORT_DEFAULT_QUALITY 85
+
+// ----------------------------------------------------------------------------
+// 공유용 축소본 (<원본>.share.jpg, 원본 옆)
+//  - 목표 면적(기본 2MP)보다 크거나 같은 가장 작은 2의 거듭제곱 축소로 DCT 단계에서
+//    디코드한 뒤, 분리형 Catmull-Rom 으로 정확한 크기로 맞추고 quality 로 재인코드.
+//  - EXIF orientation 이 남아 있으면(보관 모드 등) 픽셀을 돌려 똑바로 저장한다.
+//    결과에는 EXIF 를 싣지 않는다 (위치 등 메타데이터가 공유되지 않게).
+//  - 매번 새로 만든다 (설정이 바뀔 수 있음). tmp + rename.
+//  - 원본이 JPEG 이 아니면 GP_ERROR_NOT_SUPPORTED.
+//  - 목표(장당 150ms)는 아직 못 맞춘다. share_export_bench (리눅스 1 vCPU Xeon,
+//    6000x4000 q92 10MB 합성 원본) 에서 장당 190-260ms: 디코드 155-180ms, 리샘플
+//    26-47ms, 인코드 7-10ms. 디코드는 엔트로피 복호가 대부분이라 1/8 축소로 읽어도
+//    136ms 가 걸린다 (축소 단계로는 더 줄지 않음).
+// ----------------------------------------------------------------------------
+std::string photoSharePath(const std::string &photoPath);
+
+int exportSharePhoto(const std::string &photoPath, double megapixels, int quality,
+                     std::string &outPath);
+
+// 여러 장을 CPU 풀(JOB_ENCODE)에 나눠 동시에 만들고 끝날 때까지 기다린다.
+// 결과는 입력 순서대로 출력 경로 (실패한 항목은 빈 문자열)
+std::vector<std::string> exportSharePhotos(const std::vector<std::string> &photoPaths,
+                                           double megapixels, int quality);
+
+#endif // PHOTO_EXPORT_H
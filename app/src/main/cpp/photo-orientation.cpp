@@ -0,0 +1,74 @@
+// app/src/main/cpp/photo-orientation.cpp
+
+#include "photo-orientation.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "content-hash.h"
+#include "jpeg-util.h"
+#include "native-log.h"
+
+static std::atomic_bool gNormalize{true};
+
+void setOrientationNormalizeEnabled(bool enabled) {
+    gNormalize.store(enabled);
+}
+
+bool orientationNormalizeEnabled() {
+    return gNormalize.load();
+}
+
+int normalizePhotoOrientation(const std::string &path, int orientation, uint64_t &newSize) {
+    if (orientation < 2 || orientation > 8) return GP_ERROR_NOT_SUPPORTED;
+    if (!orientationNormalizeEnabled() || contentSha256Enabled()) return GP_ERROR_NOT_SUPPORTED;
+    // RAW 등은 손대지 않는다 (JPEG 만)
+    const std::string ext = contentExtension(path);
+    if (ext != "jpg" && ext != "jpeg") return GP_ERROR_NOT_SUPPORTED;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return GP_ERROR_FILE_NOT_FOUND;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return GP_ERROR_IO_READ;
+    }
+    size_t size = (size_t) st.st_size;
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return GP_ERROR_IO_READ;
+
+    std::vector<uint8_t> jpeg;
+    jpeg.reserve(size + size / 16);
+    bool ok = jpegTransformOrientation(static_cast<const uint8_t *>(map), size, orientation, jpeg);
+    munmap(map, size);
+    if (!ok) return GP_ERROR_CORRUPTED_DATA;
+
+    const std::string tmp = path + ".part";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return GP_ERROR_IO_WRITE;
+    ok = fwrite(jpeg.data(), 1, jpeg.size(), fp) == jpeg.size();
+    ok = fflush(fp) == 0 && fsync(fileno(fp)) == 0 && ok;
+    ok = fclose(fp) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        return GP_ERROR_IO_WRITE;
+    }
+    newSize = jpeg.size();
+
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    LOGD("photoOrientation: %s orientation %d -> 1 (%zu -> %zu bytes) %lldus", path.c_str(),
+         orientation, size, jpeg.size(), us);
+    return GP_OK;
+}
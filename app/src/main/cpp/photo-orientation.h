@@ -0,0 +1,24 @@
+// app/src/main/cpp/photo-orientation.h
+
+#ifndef PHOTO_ORIENTATION_H
+#define PHOTO_ORIENTATION_H
+
+#include <cstdint>
+#include <string>
+
+// ----------------------------------------------------------------------------
+// 가져온 JPEG 의 방향 정규화
+//  - EXIF orientation 이 2..8 이면 DCT 계수를 재배치해 (디코드/재인코드 없이, 화질
+//    손실 없이) 똑바로 세운 뒤 orientation 을 1 로 고쳐 같은 경로에 다시 쓴다.
+//    orientation 을 무시하는 뷰어에서도 세로 사진이 제대로 보인다.
+//  - 파일 이름(카메라 원본의 내용 해시)은 그대로라 다시 가져와도 중복으로 잡힌다.
+//  - 보관용 SHA-256 을 켠 경우에는 원본을 비트 그대로 두어야 하므로 건너뛴다.
+//  - orientation 은 호출자가 경로별 잠금 안에서 파일에서 다시 읽은 값.
+// ----------------------------------------------------------------------------
+void setOrientationNormalizeEnabled(bool enabled);
+bool orientationNormalizeEnabled();
+
+// 바꿨으면 GP_OK 와 새 크기, 할 일이 없으면 GP_ERROR_NOT_SUPPORTED
+int normalizePhotoOrientation(const std::string &path, int orientation, uint64_t &newSize);
+
+#endif // PHOTO_ORIENTATION_H
@@ -0,0 +1,312 @@
+// app/src/main/cpp/photo-store.cpp
+
+#include "photo-store.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "imported-index.h"
+#include "native-log.h"
+
+namespace {
+
+// PST2: origin 추가 (PST1 인덱스는 손상으로 보고 디렉터리에서 다시 만든다)
+const char STORE_MAGIC[4] = {'P', 'S', 'T', '2'};
+
+struct Header {
+    char magic[4];
+    uint32_t count;
+};
+
+// 이름은 photo_<16hex>.<확장자> (예전 시각 기반 이름도 들어갈 만큼)
+struct Record {
+    char name[36];
+    uint32_t flags;
+    uint64_t size;
+    int64_t accessMs;
+    uint64_t origin;
+};
+static_assert(sizeof(Record) == 64, "photo store record size");
+
+const uint32_t FLAG_PINNED = 1;
+
+bool endsWith(const std::string &s, const char *suffix) {
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+PhotoStore &PhotoStore::instance() {
+    static PhotoStore store;
+    return store;
+}
+
+std::string PhotoStore::nameOf(const std::string &path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+void PhotoStore::open(const std::string &dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir == dir_) return;
+    if (!dir_.empty() && dirty_ > 0) saveLocked();
+
+    dir_ = dir;
+    lru_.clear();
+    entries_.clear();
+    bytes_ = pinnedBytes_ = 0;
+    dirty_ = 0;
+
+    if (!loadLocked()) {
+        adoptExistingLocked();
+        saveLocked();
+    }
+    LOGD("PhotoStore: %zu 개 (%llu MB, 고정 %llu MB)", entries_.size(),
+         (unsigned long long) (bytes_ >> 20), (unsigned long long) (pinnedBytes_ >> 20));
+}
+
+void PhotoStore::setLimits(uint64_t budgetBytes, bool pinNewFiles) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budgetBytes;
+    pinNew_ = pinNewFiles;
+    trimLocked(false);
+}
+
+void PhotoStore::insertLocked(const std::string &name, uint64_t size, int64_t accessMs,
+                              bool pinned, uint64_t origin) {
+    auto it = entries_.find(name);
+    if (it != entries_.end()) {
+        lru_.erase(it->second.lru);
+        bytes_ -= it->second.size;
+        if (it->second.pinned) pinnedBytes_ -= it->second.size;
+        pinned = pinned || it->second.pinned;
+        if (!origin) origin = it->second.origin;
+        entries_.erase(it);
+    }
+    lru_.push_front(name);
+    entries_[name] = Entry{size, accessMs, pinned, origin, lru_.begin()};
+    bytes_ += size;
+    if (pinned) pinnedBytes_ += size;
+}
+
+void PhotoStore::add(const std::string &path, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_.empty()) return;
+    insertLocked(nameOf(path), size, nowMs(), pinNew_, 0);
+    // 방금 넣은 파일은 지우지 않는다 (고정분만으로 예산을 넘긴 경우)
+    trimLocked(true);
+    changedLocked();
+}
+
+bool PhotoStore::touch(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(nameOf(path));
+    if (it == entries_.end()) return false;
+    it->second.accessMs = nowMs();
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    changedLocked();
+    return true;
+}
+
+bool PhotoStore::setSynced(const std::string &path, bool synced) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(nameOf(path));
+    if (it == entries_.end()) return false;
+    if (it->second.pinned == !synced) return true;
+    it->second.pinned = !synced;
+    if (synced) {
+        pinnedBytes_ -= it->second.size;
+    } else {
+        pinnedBytes_ += it->second.size;
+    }
+    changedLocked();
+    return true;
+}
+
+bool PhotoStore::setOrigin(const std::string &path, uint64_t importedKey) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(nameOf(path));
+    if (it == entries_.end()) return false;
+    if (it->second.origin == importedKey) return true;
+    it->second.origin = importedKey;
+    changedLocked();
+    return true;
+}
+
+int PhotoStore::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int n = trimLocked(false);
+    if (dirty_ > 0) saveLocked();
+    return n;
+}
+
+void PhotoStore::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirty_ > 0) saveLocked();
+}
+
+// LRU 뒤쪽(오래된 것)부터 고정 안 된 파일을 지운다
+int PhotoStore::trimLocked(bool keepNewest) {
+    int removed = 0;
+    auto it = lru_.end();
+    while (bytes_ > budget_ && it != lru_.begin()) {
+        --it;
+        if (keepNewest && it == lru_.begin()) break;
+        Entry &e = entries_[*it];
+        if (e.pinned) continue;
+
+        const std::string path = dir_ + "/" + *it;
+        if (remove(path.c_str()) != 0 && errno != ENOENT) {
+            LOGE("PhotoStore: %s 삭제 실패 (%s)", path.c_str(), strerror(errno));
+            continue;
+        }
+        remove((path + ".sha256").c_str());
+        remove((path + ".thumb.jpg").c_str());
+        remove((path + ".share.jpg").c_str());
+        // 가져오기 기록도 지워 다음 동기화에서 다시 받게
+        if (e.origin) ImportedIndex::instance().forget(e.origin);
+        bytes_ -= e.size;
+        evicted_++;
+        evictedBytes_ += e.size;
+        entries_.erase(*it);
+        it = lru_.erase(it);
+        removed++;
+    }
+    if (removed > 0) {
+        changedLocked();
+        LOGD("PhotoStore: %d 개 삭제, 남은 %llu MB / 예산 %llu MB", removed,
+             (unsigned long long) (bytes_ >> 20), (unsigned long long) (budget_ >> 20));
+    }
+    if (bytes_ > budget_ && pinnedBytes_ > budget_) {
+        LOGE("PhotoStore: 고정된 파일만 %llu MB 로 예산 초과",
+             (unsigned long long) (pinnedBytes_ >> 20));
+    }
+    return removed;
+}
+
+void PhotoStore::changedLocked() {
+    if (++dirty_ >= PHOTO_STORE_SAVE_EVERY) saveLocked();
+}
+
+bool PhotoStore::loadLocked() {
+    FILE *fp = fopen((dir_ + "/stored_photos.bin").c_str(), "rb");
+    if (!fp) return false;
+
+    Header h;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 && memcmp(h.magic, STORE_MAGIC, 4) == 0;
+    std::vector<Record> records;
+    struct stat st;
+    // 잘린 파일의 count 를 그대로 믿고 resize 하지 않는다
+    if (ok && (fstat(fileno(fp), &st) != 0 ||
+               h.count > ((uint64_t) st.st_size - sizeof(Header)) / sizeof(Record))) {
+        ok = false;
+    }
+    if (ok) {
+        records.resize(h.count);
+        ok = h.count == 0 || fread(records.data(), sizeof(Record), h.count, fp) == h.count;
+    }
+    fclose(fp);
+    if (!ok) {
+        LOGE("PhotoStore: 인덱스 손상, 디렉터리에서 다시 만듦");
+        return false;
+    }
+
+    // 파일에는 최근 순으로 적혀 있다
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        it->name[sizeof(it->name) - 1] = '\0';
+        insertLocked(it->name, it->size, it->accessMs, (it->flags & FLAG_PINNED) != 0,
+                     it->origin);
+    }
+    return true;
+}
+
+// 인덱스가 없을 때(첫 실행/업그레이드) 한 번만: 이미 있는 photo_* 를 mtime 순으로
+void PhotoStore::adoptExistingLocked() {
+    struct Found {
+        std::string name;
+        uint64_t size;
+        int64_t mtimeMs;
+    };
+    std::vector<Found> found;
+    DIR *d = opendir(dir_.c_str());
+    if (!d) return;
+    while (dirent *e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name.compare(0, 6, "photo_") != 0 || name.size() >= sizeof(Record::name)) continue;
+        if (endsWith(name, ".sha256") || endsWith(name, ".thumb.jpg") ||
+            endsWith(name, ".share.jpg") || endsWith(name, ".part")) {
+            continue;
+        }
+        struct stat st;
+        if (stat((dir_ + "/" + name).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        found.push_back(Found{name, (uint64_t) st.st_size, (int64_t) st.st_mtime * 1000});
+    }
+    closedir(d);
+
+    std::sort(found.begin(), found.end(),
+              [](const Found &a, const Found &b) { return a.mtimeMs < b.mtimeMs; });
+    for (const Found &f: found) insertLocked(f.name, f.size, f.mtimeMs, pinNew_, 0);
+}
+
+bool PhotoStore::saveLocked() {
+    const std::string path = dir_ + "/stored_photos.bin";
+    const std::string tmp = path + ".tmp";
+
+    std::vector<Record> records;
+    records.reserve(entries_.size());
+    for (const std::string &name: lru_) {
+        const Entry &e = entries_[name];
+        Record r;
+        memset(&r, 0, sizeof(r));
+        strncpy(r.name, name.c_str(), sizeof(r.name) - 1);
+        r.flags = e.pinned ? FLAG_PINNED : 0;
+        r.size = e.size;
+        r.accessMs = e.accessMs;
+        r.origin = e.origin;
+        records.push_back(r);
+    }
+
+    Header h;
+    memcpy(h.magic, STORE_MAGIC, 4);
+    h.count = (uint32_t) records.size();
+
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+              (records.empty() ||
+               fwrite(records.data(), sizeof(Record), records.size(), fp) == records.size());
+    ok = fflush(fp) == 0 && fsync(fileno(fp)) == 0 && ok;
+    ok = fclose(fp) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        LOGE("PhotoStore: 인덱스 저장 실패");
+        remove(tmp.c_str());
+        return false;
+    }
+    dirty_ = 0;
+    return true;
+}
+
+std::string PhotoStore::statsJson() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "{\"files\":" << entries_.size() << ",\"bytes\":" << bytes_
+        << ",\"pinnedBytes\":" << pinnedBytes_ << ",\"budgetBytes\":" << budget_
+        << ",\"pinNewFiles\":" << (pinNew_ ? "true" : "false")
+        << ",\"evicted\":" << evicted_ << ",\"evictedBytes\":" << evictedBytes_ << "}";
+    return oss.str();
+}
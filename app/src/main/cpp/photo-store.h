@@ -0,0 +1,85 @@
+// app/src/main/cpp/photo-store.h
+
+#ifndef PHOTO_STORE_H
+#define PHOTO_STORE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#define PHOTO_STORE_DEFAULT_MB 1024
+#define PHOTO_STORE_SAVE_EVERY 32
+
+// ----------------------------------------------------------------------------
+// 내려받은 사진 저장소 (filesDir/photo_*.*, 인덱스는 filesDir/stored_photos.bin)
+//  - 바이트 예산 안에서 마지막 접근 순 LRU 로 지운다 (백그라운드 전환 때 전부
+//    지우던 방식 대신). 접근은 저장/중복 적중/touch() 로 갱신. 옆에 붙은
+//    .sha256 / .thumb.jpg / .share.jpg 도 함께 지운다.
+//  - 아직 동기화(갤러리 내보내기 등)가 안 된 파일은 고정(pin)해 지우지 않는다.
+//    pinNewFiles 가 켜져 있으면 새 파일은 고정된 채 들어오고 setSynced 로 푼다.
+//  - 카메라에서 가져온 파일은 ImportedIndex 키(origin)를 함께 둔다. 지울 때 그 기록도
+//    지워 다음 "새 파일만 가져오기" 에서 다시 받을 수 있게 한다. 같은 내용을 여러
+//    카메라 파일에서 받았으면 마지막 것만 남는다.
+//  - 인덱스는 64바이트 고정 레코드 배열. 시작 때 디렉터리를 훑지 않고 이것만
+//    읽는다 (인덱스가 없을 때 한 번만 photo_* 를 훑어 기존 파일을 넣는다).
+//    변경 PHOTO_STORE_SAVE_EVERY 번마다 / flush() 때 tmp + rename 으로 통째로 쓴다.
+// ----------------------------------------------------------------------------
+class PhotoStore {
+public:
+    static PhotoStore &instance();
+
+    void open(const std::string &dir);
+    void setLimits(uint64_t budgetBytes, bool pinNewFiles);
+
+    // 새로 저장했거나 이미 있던(중복) 파일 - 최근 접근으로 올리고 예산 초과분을 지운다
+    void add(const std::string &path, uint64_t size);
+    // 사용자가 봤을 때 등. 인덱스에 없는 파일이면 false
+    bool touch(const std::string &path);
+    // synced = false 면 고정 (지우지 않음)
+    bool setSynced(const std::string &path, bool synced);
+    // 카메라 원본의 ImportedIndex::keyOf. 인덱스에 없는 파일이면 false
+    bool setOrigin(const std::string &path, uint64_t importedKey);
+
+    // 예산까지 지우고 인덱스 저장. 지운 파일 수
+    int trim();
+    void flush();
+
+    std::string statsJson();
+
+private:
+    struct Entry {
+        uint64_t size;
+        int64_t accessMs;
+        bool pinned;
+        uint64_t origin;                // ImportedIndex 키 (0 = 없음)
+        std::list<std::string>::iterator lru;
+    };
+
+    PhotoStore() = default;
+
+    static std::string nameOf(const std::string &path);
+    void insertLocked(const std::string &name, uint64_t size, int64_t accessMs, bool pinned,
+                      uint64_t origin);
+    int trimLocked(bool keepNewest);
+    bool loadLocked();
+    void adoptExistingLocked();
+    bool saveLocked();
+    void changedLocked();
+
+    std::mutex mutex_;
+    std::string dir_;
+    uint64_t budget_ = (uint64_t) PHOTO_STORE_DEFAULT_MB * 1024 * 1024;
+    bool pinNew_ = false;
+
+    std::list<std::string> lru_;        // 앞쪽이 최근
+    std::unordered_map<std::string, Entry> entries_;
+    uint64_t bytes_ = 0;
+    uint64_t pinnedBytes_ = 0;
+    int dirty_ = 0;
+
+    unsigned long long evicted_ = 0, evictedBytes_ = 0;
+};
+
+#endif // PHOTO_STORE_H
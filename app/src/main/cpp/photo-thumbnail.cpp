@@ -0,0 +1,113 @@
+// app/src/main/cpp/photo-thumbnail.cpp
+
+#include "photo-thumbnail.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "jpeg-util.h"
+#include "native-log.h"
+#include "raw-preview.h"
+
+std::string photoThumbnailPath(const std::string &photoPath) {
+    return photoPath + ".thumb.jpg";
+}
+
+static std::string lowerExtension(const std::string &path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return "";
+    std::string ext = path.substr(dot + 1);
+    for (char &c: ext) c = (char) tolower((unsigned char) c);
+    return ext;
+}
+
+static bool isRawExtension(const std::string &ext) {
+    static const char *raws[] = {"nef", "nrw", "cr2", "arw", "sr2", "dng", "orf", "rw2", "pef"};
+    for (const char *r: raws) {
+        if (ext == r) return true;
+    }
+    return false;
+}
+
+int makePhotoThumbnail(const std::string &photoPath, int maxEdge, std::string &outPath) {
+    outPath = photoThumbnailPath(photoPath);
+    const std::string ext = lowerExtension(photoPath);
+    const bool raw = isRawExtension(ext);
+    if (!raw && ext != "jpg" && ext != "jpeg") return GP_ERROR_NOT_SUPPORTED;
+    if (maxEdge <= 0) maxEdge = PHOTO_THUMB_DEFAULT_EDGE;
+
+    struct stat src, thumb;
+    if (stat(photoPath.c_str(), &src) != 0) return GP_ERROR_FILE_NOT_FOUND;
+    if (stat(outPath.c_str(), &thumb) == 0 && thumb.st_mtime >= src.st_mtime) return GP_OK;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int fd = open(photoPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return GP_ERROR_IO_READ;
+    size_t size = (size_t) src.st_size;
+    void *map = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) return GP_ERROR_IO_READ;
+    const uint8_t *data = static_cast<const uint8_t *>(map);
+
+    // RAW 는 안에 든 미리보기 JPEG 구간만 디코드 (방향은 IFD0 값으로 나중에 맞춘다)
+    const uint8_t *jpegData = data;
+    size_t jpegSize = size;
+    int32_t orientation = -1;
+    if (raw) {
+        uint64_t offset = 0, length = 0;
+        if (!rawPreviewFind(data, size, offset, length, orientation)) {
+            munmap(map, size);
+            return GP_ERROR_NOT_SUPPORTED;
+        }
+        jpegData = data + offset;
+        jpegSize = (size_t) length;
+    }
+
+    int w = 0, h = 0, tw = 0, th = 0;
+    JpegImage scaled, out;
+    bool ok = jpegReadSize(jpegData, jpegSize, w, h);
+    if (ok) {
+        fitLongEdge(w, h, maxEdge, tw, th);
+        ok = jpegDecodeRgb(jpegData, jpegSize, jpegPickScaleDenom(w, h, std::max(tw, th)), scaled);
+    }
+    munmap(map, size);
+    if (!ok) return GP_ERROR_CORRUPTED_DATA;
+
+    if (scaled.width == tw && scaled.height == th) {
+        out = std::move(scaled);
+    } else {
+        resizeBoxRgb(scaled, tw, th, out);
+    }
+    if (orientation >= 2 && orientation <= 8) {
+        JpegImage upright;
+        orientRgb(out, orientation, upright);
+        out = std::move(upright);
+    }
+
+    std::vector<uint8_t> jpeg;
+    if (!jpegEncodeRgb(out, PHOTO_THUMB_QUALITY, jpeg)) return GP_ERROR_CORRUPTED_DATA;
+
+    const std::string tmp = outPath + ".part";
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return GP_ERROR_IO_WRITE;
+    ok = fwrite(jpeg.data(), 1, jpeg.size(), fp) == jpeg.size();
+    ok = fclose(fp) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), outPath.c_str()) != 0) {
+        remove(tmp.c_str());
+        return GP_ERROR_IO_WRITE;
+    }
+
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    LOGD("photoThumbnail: %dx%d -> %dx%d (%zu bytes) %lldus", w, h, out.width, out.height,
+         jpeg.size(), us);
+    return GP_OK;
+}
@@ -0,0 +1,23 @@
+// app/src/main/cpp/photo-thumbnail.h
+
+#ifndef PHOTO_THUMBNAIL_H
+#define PHOTO_THUMBNAIL_H
+
+#include <string>
+
+#define PHOTO_THUMB_DEFAULT_EDGE 320
+#define PHOTO_THUMB_QUALITY 80
+
+// ----------------------------------------------------------------------------
+// 내려받은 JPEG 의 작은 썸네일 (<원본>.thumb.jpg, 원본 옆)
+//  - 원본은 mmap 해 번들 libjpeg 로 scale_denom(최대 8)만큼 DCT 단계에서 줄여
+//    디코드하고 (전체 IDCT 없음), box 필터로 긴 변 maxEdge 의 정확한 크기로 맞춘다.
+//  - 이미 있고 원본보다 새 것이면 다시 만들지 않는다. tmp + rename 으로 쓴다.
+//  - TIFF 기반 RAW 는 안에 든 가장 큰 미리보기 JPEG 으로 만든다 (IFD0 방향 반영).
+//  - 그 밖의 형식이면 GP_ERROR_NOT_SUPPORTED.
+// ----------------------------------------------------------------------------
+std::string photoThumbnailPath(const std::string &photoPath);
+
+int makePhotoThumbnail(const std::string &photoPath, int maxEdge, std::string &outPath);
+
+#endif // PHOTO_THUMBNAIL_H
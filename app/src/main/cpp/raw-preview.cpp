@@ -0,0 +1,270 @@
+// app/src/main/cpp/raw-preview.cpp
+
+#include "raw-preview.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "native-log.h"
+
+namespace {
+
+// 지정 구간을 dst 로 (모자라면 false)
+typedef std::function<bool(uint64_t offset, size_t length, uint8_t *dst)> RangeFn;
+
+const int MAX_IFDS = 24;
+const uint16_t MAX_IFD_ENTRIES = 512;
+
+enum : uint16_t {
+    TAG_NEW_SUBFILE_TYPE = 0x00FE,
+    TAG_IMAGE_WIDTH = 0x0100,
+    TAG_IMAGE_HEIGHT = 0x0101,
+    TAG_COMPRESSION = 0x0103,
+    TAG_PHOTOMETRIC = 0x0106,
+    TAG_STRIP_OFFSETS = 0x0111,
+    TAG_ORIENTATION = 0x0112,
+    TAG_STRIP_BYTE_COUNTS = 0x0117,
+    TAG_SUB_IFDS = 0x014A,
+    TAG_JPEG_OFFSET = 0x0201,
+    TAG_JPEG_LENGTH = 0x0202,
+    TAG_CR2_SLICE = 0xC640,
+};
+
+const uint32_t PHOTOMETRIC_CFA = 32803;
+const uint32_t PHOTOMETRIC_LINEAR_RAW = 34892;
+
+struct Candidate {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    int32_t width = -1;
+    int32_t height = -1;
+};
+
+class TiffWalker {
+public:
+    explicit TiffWalker(const RangeFn &read) : read_(read) {}
+
+    bool walk() {
+        uint8_t hdr[8];
+        if (!read_(0, sizeof(hdr), hdr)) return false;
+        if (hdr[0] == 'I' && hdr[1] == 'I') {
+            le_ = true;
+        } else if (hdr[0] == 'M' && hdr[1] == 'M') {
+            le_ = false;
+        } else {
+            return false;
+        }
+        // 42 = TIFF (NEF/CR2/ARW/DNG), 0x4F52/0x5352 = ORF, 0x55 = RW2
+        uint16_t magic = get16(hdr + 2);
+        if (magic != 42 && magic != 0x4F52 && magic != 0x5352 && magic != 0x55) return false;
+
+        pending_.push_back(get32(hdr + 4));
+        bool first = true;
+        while (!pending_.empty() && visited_.size() < (size_t) MAX_IFDS) {
+            uint32_t ifd = pending_.front();
+            pending_.erase(pending_.begin());
+            if (ifd == 0 || std::find(visited_.begin(), visited_.end(), ifd) != visited_.end()) {
+                continue;
+            }
+            visited_.push_back(ifd);
+            readIfd(ifd, first);
+            first = false;
+        }
+        return true;
+    }
+
+    const Candidate &best() const { return best_; }
+    int32_t orientation() const { return orientation_; }
+
+private:
+    uint16_t get16(const uint8_t *p) const {
+        return le_ ? (uint16_t) (p[0] | p[1] << 8) : (uint16_t) (p[0] << 8 | p[1]);
+    }
+
+    uint32_t get32(const uint8_t *p) const {
+        return le_ ? (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 |
+                     (uint32_t) p[3] << 24
+                   : (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 |
+                     (uint32_t) p[3];
+    }
+
+    // SHORT/LONG/IFD 하나짜리 값 (항목 안 +8)
+    uint32_t value(const uint8_t *entry) const {
+        return get16(entry + 2) == 3 ? get16(entry + 8) : get32(entry + 8);
+    }
+
+    void readIfd(uint32_t ifd, bool isIfd0) {
+        uint8_t countBuf[2];
+        if (!read_(ifd, 2, countBuf)) return;
+        uint16_t count = get16(countBuf);
+        if (count == 0 || count > MAX_IFD_ENTRIES) return;
+        std::vector<uint8_t> entries((size_t) count * 12 + 4);
+        if (!read_(ifd + 2, entries.size(), entries.data())) return;
+
+        uint32_t subfile = 0, compression = 0, photometric = 0;
+        uint32_t stripOffset = 0, stripLength = 0, jpegOffset = 0, jpegLength = 0;
+        int32_t width = -1, height = -1;
+        bool singleStrip = false, sensorData = false;
+        for (uint16_t i = 0; i < count; i++) {
+            const uint8_t *e = entries.data() + (size_t) i * 12;
+            uint16_t tag = get16(e);
+            uint32_t n = get32(e + 4);
+            switch (tag) {
+                case TAG_NEW_SUBFILE_TYPE: subfile = value(e); break;
+                case TAG_IMAGE_WIDTH: width = (int32_t) value(e); break;
+                case TAG_IMAGE_HEIGHT: height = (int32_t) value(e); break;
+                case TAG_COMPRESSION: compression = value(e); break;
+                case TAG_PHOTOMETRIC: photometric = value(e); break;
+                case TAG_STRIP_OFFSETS:
+                    singleStrip = n == 1;
+                    stripOffset = value(e);
+                    break;
+                case TAG_STRIP_BYTE_COUNTS: stripLength = value(e); break;
+                case TAG_JPEG_OFFSET: jpegOffset = value(e); break;
+                case TAG_JPEG_LENGTH: jpegLength = value(e); break;
+                case TAG_CR2_SLICE: sensorData = true; break;
+                case TAG_ORIENTATION:
+                    if (isIfd0) orientation_ = (int32_t) value(e);
+                    break;
+                case TAG_SUB_IFDS: addSubIfds(e, n); break;
+                default: break;
+            }
+        }
+        pending_.push_back(get32(entries.data() + (size_t) count * 12));
+
+        if (photometric == PHOTOMETRIC_CFA || photometric == PHOTOMETRIC_LINEAR_RAW) sensorData = true;
+        if (jpegOffset > 0 && jpegLength > 0) consider(jpegOffset, jpegLength, -1, -1);
+        // JPEG 압축 단일 strip: CR2 IFD0(압축 6), DNG 축소본(NewSubfileType 1, 압축 7)
+        bool jpegStrip = compression == 6 || (compression == 7 && (subfile & 1) != 0);
+        if (singleStrip && jpegStrip && !sensorData && stripLength > 0) {
+            consider(stripOffset, stripLength, width, height);
+        }
+    }
+
+    void addSubIfds(const uint8_t *e, uint32_t n) {
+        if (n == 1) {
+            pending_.push_back(value(e));
+            return;
+        }
+        n = std::min<uint32_t>(n, MAX_IFDS);
+        std::vector<uint8_t> offs((size_t) n * 4);
+        if (!read_(get32(e + 8), offs.size(), offs.data())) return;
+        for (uint32_t i = 0; i < n; i++) pending_.push_back(get32(offs.data() + i * 4));
+    }
+
+    void consider(uint64_t offset, uint64_t length, int32_t width, int32_t height) {
+        if (length <= best_.length) return;
+        best_.offset = offset;
+        best_.length = length;
+        best_.width = width;
+        best_.height = height;
+    }
+
+    const RangeFn &read_;
+    bool le_ = true;
+    std::vector<uint32_t> pending_;
+    std::vector<uint32_t> visited_;
+    Candidate best_;
+    int32_t orientation_ = -1;
+};
+
+bool isJpegStart(const uint8_t *p) {
+    return p[0] == 0xFF && p[1] == 0xD8;
+}
+
+} // namespace
+
+bool rawPreviewFind(const uint8_t *data, size_t size, uint64_t &offset, uint64_t &length,
+                    int32_t &orientation) {
+    RangeFn read = [data, size](uint64_t off, size_t len, uint8_t *dst) {
+        if (off > size || len > size - off) return false;
+        memcpy(dst, data + off, len);
+        return true;
+    };
+    TiffWalker walker(read);
+    if (!walker.walk()) return false;
+    const Candidate &c = walker.best();
+    if (c.length < RAW_PREVIEW_MIN_BYTES || c.offset > size || c.length > size - c.offset) {
+        return false;
+    }
+    if (!isJpegStart(data + c.offset)) return false;
+    offset = c.offset;
+    length = c.length;
+    orientation = walker.orientation();
+    return true;
+}
+
+int rawPreviewRead(Camera *camera, GPContext *context, const char *folder, const char *name,
+                   RawPreview &out) {
+    auto t0 = std::chrono::steady_clock::now();
+    out = RawPreview();
+
+    // 카메라에서 [offset, offset + length) 를 채울 때까지 (짧게 돌려주는 카메라도 있다)
+    int lastError = GP_OK;
+    auto cameraRead = [&](uint64_t offset, uint8_t *dst, uint64_t length) {
+        uint64_t got = 0;
+        while (got < length) {
+            uint64_t n = length - got;
+            int ret = gp_camera_file_read(camera, folder, name, GP_FILE_TYPE_NORMAL, offset + got,
+                                          reinterpret_cast<char *>(dst + got), &n, context);
+            out.reads++;
+            if (ret < GP_OK) {
+                lastError = ret;
+                return got;
+            }
+            if (n == 0) break;
+            got += n;
+            out.bytesRead += n;
+        }
+        return got;
+    };
+
+    // 앞부분은 한 번만 (파일이 더 작거나 짧게 와도 나머지는 아래에서 필요할 때 읽는다)
+    std::vector<uint8_t> head(RAW_PREVIEW_HEAD_BYTES);
+    uint64_t headSize = head.size();
+    int ret = gp_camera_file_read(camera, folder, name, GP_FILE_TYPE_NORMAL, 0,
+                                  reinterpret_cast<char *>(head.data()), &headSize, context);
+    out.reads++;
+    if (ret < GP_OK) return ret;
+    out.bytesRead += headSize;
+    head.resize((size_t) headSize);
+
+    // 앞부분 안이면 메모리에서, 밖이면 그 구간만 카메라에서
+    RangeFn read = [&](uint64_t off, size_t len, uint8_t *dst) {
+        if (off <= head.size() && len <= head.size() - off) {
+            memcpy(dst, head.data() + off, len);
+            return true;
+        }
+        return cameraRead(off, dst, len) == len;
+    };
+    TiffWalker walker(read);
+    if (!walker.walk()) return GP_ERROR_NOT_SUPPORTED;
+
+    const Candidate &c = walker.best();
+    if (c.length < RAW_PREVIEW_MIN_BYTES) return GP_ERROR_NOT_SUPPORTED;
+    out.jpeg.resize(c.length);
+    if (!read(c.offset, (size_t) c.length, out.jpeg.data())) {
+        out.jpeg.clear();
+        return lastError < GP_OK ? lastError : GP_ERROR_CORRUPTED_DATA;
+    }
+    if (!isJpegStart(out.jpeg.data())) {
+        out.jpeg.clear();
+        return GP_ERROR_CORRUPTED_DATA;
+    }
+    out.offset = c.offset;
+    out.width = c.width;
+    out.height = c.height;
+    out.orientation = walker.orientation();
+
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    LOGD("rawPreview: %s/%s 미리보기 %zu bytes @%llu (읽기 %d 번, %llu bytes) %lldms", folder, name,
+         out.jpeg.size(), (unsigned long long) c.offset, out.reads,
+         (unsigned long long) out.bytesRead, ms);
+    return GP_OK;
+}
@@ -0,0 +1,43 @@
+// app/src/main/cpp/raw-preview.h
+
+#ifndef RAW_PREVIEW_H
+#define RAW_PREVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gphoto2/gphoto2-camera.h>
+
+// IFD 머리들은 대개 파일 앞부분에 모여 있어 한 번에 이만큼 읽는다
+#define RAW_PREVIEW_HEAD_BYTES (64 * 1024)
+// 이보다 작은 JPEG 은 목록 썸네일이라 리뷰용으로 쓰지 않는다
+#define RAW_PREVIEW_MIN_BYTES (32 * 1024)
+
+// ----------------------------------------------------------------------------
+// TIFF 기반 RAW(NEF/CR2/ARW/DNG ...) 안의 큰 미리보기 JPEG
+//  - gp_camera_file_read 로 앞 RAW_PREVIEW_HEAD_BYTES 만 읽어 IFD0 과 그 다음 IFD,
+//    SubIFD 들을 훑고 (앞부분 밖에 있는 IFD 는 그 부분만 따로 읽는다), 가장 큰 JPEG
+//    구간(JPEGInterchangeFormat 또는 JPEG 압축 단일 strip)만 받아 온다.
+//    30~90MB RAW 를 통째로 옮기지 않고 수 MB 만 읽는다.
+//  - CFA/LinearRaw, CR2 raw 조각(0xC640) 처럼 센서 데이터인 IFD 는 후보에서 뺀다.
+//  - 호출자가 카메라 접근을 직렬화한다. 카메라가 부분 읽기를 못 하면 그 에러 그대로.
+// ----------------------------------------------------------------------------
+struct RawPreview {
+    std::vector<uint8_t> jpeg;
+    uint64_t offset = 0;            // RAW 안 위치
+    int32_t width = -1;             // IFD 에 적힌 값 (없으면 -1)
+    int32_t height = -1;
+    int32_t orientation = -1;       // IFD0 의 Orientation (1..8, 없으면 -1)
+    int reads = 0;                  // gp_camera_file_read 횟수
+    uint64_t bytesRead = 0;
+};
+
+int rawPreviewRead(Camera *camera, GPContext *context, const char *folder, const char *name,
+                   RawPreview &out);
+
+// 메모리에 있는(mmap 한) RAW 에서 같은 방식으로 미리보기 구간을 찾는다 (가져온 RAW 의 썸네일)
+bool rawPreviewFind(const uint8_t *data, size_t size, uint64_t &offset, uint64_t &length,
+                    int32_t &orientation);
+
+#endif // RAW_PREVIEW_H
@@ -0,0 +1,115 @@
+// app/src/main/cpp/startup-timeline.cpp
+
+#include "startup-timeline.h"
+
+#include <sstream>
+
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+void StartupTimeline::markProcessLoad() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    processLoad_ = Clock::now();
+}
+
+void StartupTimeline::reset(const char *label) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    label_ = label;
+    start_ = Clock::now();
+    started_ = true;
+    spans_.clear();
+}
+
+bool StartupTimeline::active() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return started_;
+}
+
+long long StartupTimeline::sinceStartUs(Clock::time_point t) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - start_).count();
+}
+
+void StartupTimeline::record(const char *name, Clock::time_point start, Clock::time_point end,
+                             int result) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!started_) return;
+    spans_.push_back(Span{name, sinceStartUs(start),
+                          std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+                          result});
+}
+
+bool StartupTimeline::recordOnce(const char *name, Clock::time_point start, Clock::time_point end,
+                                 int result) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!started_) return false;
+    for (const Span &s: spans_) {
+        if (s.name == name) return false;
+    }
+    spans_.push_back(Span{name, sinceStartUs(start),
+                          std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+                          result});
+    return true;
+}
+
+std::string StartupTimeline::toJson() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::ostringstream oss;
+    oss << "{\"label\":\"" << label_ << "\"";
+    if (started_ && processLoad_.time_since_epoch().count() != 0) {
+        oss << ",\"sinceLoadUs\":"
+            << std::chrono::duration_cast<std::chrono::microseconds>(start_ - processLoad_).count();
+    }
+    long long total = 0;
+    oss << ",\"spans\":[";
+    for (size_t i = 0; i < spans_.size(); i++) {
+        const Span &s = spans_[i];
+        if (i > 0) oss << ",";
+        oss << "{\"name\":\"" << s.name << "\",\"startUs\":" << s.startUs
+            << ",\"durUs\":" << s.durUs << ",\"result\":" << s.result << "}";
+        if (s.startUs + s.durUs > total) total = s.startUs + s.durUs;
+    }
+    oss << "],\"totalUs\":" << total << "}";
+    return oss.str();
+}
+
+// 예: "startup[fast] 812ms: setenv=0 sysdev=2 abilities=35 init#1=640 first_preview=135"
+std::string StartupTimeline::summary() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    std::ostringstream oss;
+    long long total = 0;
+    for (const Span &s: spans_) {
+        if (s.startUs + s.durUs > total) total = s.startUs + s.durUs;
+    }
+    oss << "startup[" << label_ << "] " << total / 1000 << "ms:";
+    for (const Span &s: spans_) {
+        oss << " " << s.name << "=" << s.durUs / 1000;
+        if (s.result < 0) oss << "(" << s.result << ")";
+    }
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// 재시도 정책
+// ----------------------------------------------------------------------------
+int initRetryDelayMs(int error, int attempt) {
+    if (attempt >= INIT_MAX_ATTEMPTS) return -1;
+
+    switch (error) {
+        // 다른 드라이버(MTP 등)가 인터페이스를 막 놓는 중 - 바로 다시 시도
+        case GP_ERROR_IO_USB_CLAIM:
+            return attempt == 1 ? 0 : 50 * attempt;
+
+        // 재시도해도 결과가 같은 에러
+        case GP_ERROR_MODEL_NOT_FOUND:
+        case GP_ERROR_NOT_SUPPORTED:
+        case GP_ERROR_BAD_PARAMETERS:
+        case GP_ERROR_LIBRARY:
+        case GP_ERROR_UNKNOWN_PORT:
+        case GP_ERROR_IO_USB_FIND:
+            return -1;
+
+        // 그 외(IO, 타임아웃, 카메라 busy 등) - 지수 백오프 100, 200, 400, 800ms
+        default:
+            return 100 << (attempt - 1);
+    }
+}
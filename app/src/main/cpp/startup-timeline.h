@@ -0,0 +1,72 @@
+// app/src/main/cpp/startup-timeline.h
+
+#ifndef STARTUP_TIMELINE_H
+#define STARTUP_TIMELINE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// 연결 시간 프로파일러
+//  - initCameraWithFd 시작을 0 으로 두고 단계별 구간(시작/소요/결과)을 기록
+//  - 첫 config / 첫 프리뷰처럼 연결 이후 한 번만 일어나는 단계도 같은 타임라인에 남긴다
+// ----------------------------------------------------------------------------
+class StartupTimeline {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Span {
+        std::string name;
+        long long startUs;  // 타임라인 시작 기준
+        long long durUs;
+        int result;         // gPhoto2 결과 코드 (해당 없으면 GP_OK)
+    };
+
+    // 구간 측정 헬퍼 - 소멸 시 기록
+    class Scope {
+    public:
+        Scope(StartupTimeline &tl, const char *name)
+                : tl_(tl), name_(name), start_(Clock::now()) {}
+        ~Scope() { tl_.record(name_, start_, Clock::now(), result_); }
+        void setResult(int result) { result_ = result; }
+
+    private:
+        StartupTimeline &tl_;
+        const char *name_;
+        Clock::time_point start_;
+        int result_ = 0;
+    };
+
+    void markProcessLoad();     // JNI_OnLoad 시점
+    void reset(const char *label);
+    void record(const char *name, Clock::time_point start, Clock::time_point end, int result);
+    // 같은 이름이 이미 있으면 무시 (첫 config/첫 프리뷰 용)
+    bool recordOnce(const char *name, Clock::time_point start, Clock::time_point end, int result);
+    bool active() const;
+
+    std::string toJson() const;
+    std::string summary() const;
+
+private:
+    long long sinceStartUs(Clock::time_point t) const;
+
+    mutable std::mutex mutex_;
+    std::string label_;
+    Clock::time_point processLoad_;
+    Clock::time_point start_;
+    bool started_ = false;
+    std::vector<Span> spans_;
+};
+
+// ----------------------------------------------------------------------------
+// gp_camera_init 재시도 정책 (에러 코드별)
+//  - 반환: 다음 시도 전 대기 시간(ms), 재시도하지 않을 에러면 -1
+//  - attempt 는 방금 실패한 시도 번호 (1부터)
+// ----------------------------------------------------------------------------
+#define INIT_MAX_ATTEMPTS 5
+
+int initRetryDelayMs(int error, int attempt);
+
+#endif // STARTUP_TIMELINE_H
@@ -0,0 +1,247 @@
+// app/src/main/cpp/sync-trigger.cpp
+
+#include "sync-trigger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#include <gphoto2/gphoto2-abilities-list.h>
+#include <gphoto2/gphoto2-port-result.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "json-util.h"
+#include "native-log.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+long long usSince(Clock::time_point from) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - from).count();
+}
+
+// ----------------------------------------------------------------------------
+// 출발 배리어
+//  - arm 된 스레드는 released_ 가 켜질 때까지 yield 하며 돈다. condition_variable
+//    깨우기는 스레드마다 스케줄링 지연이 달라 수 ms 씩 어긋날 수 있어 쓰지 않는다.
+//  - close() 이후 도착한 스레드는 발사하지 않는다 (arm 시간 초과).
+// ----------------------------------------------------------------------------
+class StartBarrier {
+public:
+    bool arrive(bool ok) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) return false;
+        if (ok) armed_++; else failed_++;
+        return true;
+    }
+
+    void waitArrivals(int n, Clock::time_point deadline) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (armed_ + failed_ >= n) return;
+            }
+            if (Clock::now() >= deadline) return;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    int close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        return armed_;
+    }
+
+    void release(bool go) {
+        go_ = go;
+        releasedAt_ = Clock::now();
+        released_.store(true, std::memory_order_release);
+    }
+
+    bool wait() const {
+        while (!released_.load(std::memory_order_acquire)) std::this_thread::yield();
+        return go_;
+    }
+
+    Clock::time_point releasedAt() const { return releasedAt_; }
+
+private:
+    std::mutex mutex_;
+    int armed_ = 0;
+    int failed_ = 0;
+    bool closed_ = false;
+    bool go_ = false;
+    Clock::time_point releasedAt_;
+    std::atomic_bool released_{false};
+};
+
+// 세션 mutex 를 deadline 까지 try_lock 으로 잡는다 (라이브뷰 프레임 한 장 정도는 기다림)
+bool lockUntil(std::unique_lock<std::mutex> &lock, Clock::time_point deadline) {
+    while (!lock.try_lock()) {
+        if (Clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// arm 상태에서 세션 mutex 를 쥔 채 트리거 후 첫 FILE_ADDED 까지 대기
+void waitFileAddedLocked(CameraSession &s, const StartBarrier &barrier, int eventTimeoutMs,
+                         SyncTriggerCamera &out) {
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(eventTimeoutMs);
+    for (;;) {
+        long long remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - Clock::now()).count();
+        if (remaining <= 0) {
+            out.eventResult = GP_ERROR_TIMEOUT;
+            return;
+        }
+
+        CameraEventType type;
+        void *data = nullptr;
+        int ret = gp_camera_wait_for_event(s.camera, (int) remaining, &type, &data, s.context);
+        s.connection.noteResult(ret);
+        if (ret < GP_OK) {
+            free(data);
+            out.eventResult = ret;
+            return;
+        }
+
+        if (type == GP_EVENT_FILE_ADDED) {
+            out.fileAddedUs = usSince(barrier.releasedAt());
+            CameraFilePath *cfp = static_cast<CameraFilePath *>(data);
+            out.folder = cfp->folder;
+            out.name = cfp->name;
+            // 파일은 이벤트 펌프가 이어서 내려받는다
+            queueDownload(s, *cfp);
+            s.eventCv.notify_all();
+            free(data);
+            out.eventResult = GP_OK;
+            return;
+        }
+        free(data);
+    }
+}
+
+void fireThread(std::shared_ptr<CameraSession> s, StartBarrier &barrier,
+                Clock::time_point armDeadline, int eventTimeoutMs, SyncTriggerCamera &out) {
+    out.handle = s->handle;
+
+    std::unique_lock<std::mutex> lock(s->mutex, std::defer_lock);
+    if (!lockUntil(lock, armDeadline)) {
+        out.result = GP_ERROR_TIMEOUT;
+        barrier.arrive(false);
+        return;
+    }
+
+    CameraAbilities abilities;
+    if (!s->camera) {
+        out.result = GP_ERROR;
+    } else if (gp_camera_get_abilities(s->camera, &abilities) >= GP_OK &&
+               !(abilities.operations & GP_OPERATION_TRIGGER_CAPTURE)) {
+        out.result = GP_ERROR_NOT_SUPPORTED;
+    }
+    if (out.result != GP_OK) {
+        barrier.arrive(false);
+        return;
+    }
+
+    if (!barrier.arrive(true)) {
+        out.result = GP_ERROR_TIMEOUT;
+        return;
+    }
+    if (!barrier.wait()) {
+        out.result = GP_ERROR_CANCEL;
+        return;
+    }
+
+    out.dispatchUs = usSince(barrier.releasedAt());
+    out.result = gp_camera_trigger_capture(s->camera, s->context);
+    s->config.markStale();
+    out.returnUs = usSince(barrier.releasedAt());
+    s->connection.noteResult(out.result);
+
+    if (out.result >= GP_OK) waitFileAddedLocked(*s, barrier, eventTimeoutMs, out);
+}
+
+long long spread(const std::vector<SyncTriggerCamera> &cameras,
+                 long long SyncTriggerCamera::*field) {
+    long long lo = 0, hi = 0;
+    int n = 0;
+    for (const SyncTriggerCamera &c: cameras) {
+        long long v = c.*field;
+        if (v < 0) continue;
+        if (n == 0 || v < lo) lo = v;
+        if (n == 0 || v > hi) hi = v;
+        n++;
+    }
+    return n >= 2 ? hi - lo : -1;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// SyncTriggerResult
+// ----------------------------------------------------------------------------
+long long SyncTriggerResult::dispatchSkewUs() const {
+    return spread(cameras, &SyncTriggerCamera::dispatchUs);
+}
+
+long long SyncTriggerResult::fileAddedSpreadUs() const {
+    return spread(cameras, &SyncTriggerCamera::fileAddedUs);
+}
+
+std::string SyncTriggerResult::toJson() const {
+    std::ostringstream oss;
+    oss << "{\"armed\":" << armed << ",\"armUs\":" << armUs
+        << ",\"dispatchSkewUs\":" << dispatchSkewUs()
+        << ",\"fileAddedSpreadUs\":" << fileAddedSpreadUs() << ",\"cameras\":[";
+    for (size_t i = 0; i < cameras.size(); i++) {
+        const SyncTriggerCamera &c = cameras[i];
+        if (i > 0) oss << ",";
+        oss << "{\"handle\":" << c.handle << ",\"result\":" << c.result
+            << ",\"dispatchUs\":" << c.dispatchUs << ",\"returnUs\":" << c.returnUs
+            << ",\"fileAddedUs\":" << c.fileAddedUs << ",\"eventResult\":" << c.eventResult
+            << ",\"folder\":\"" << escapeJsonString(c.folder) << "\",\"name\":\""
+            << escapeJsonString(c.name) << "\"}";
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// syncTrigger
+// ----------------------------------------------------------------------------
+int syncTrigger(const std::vector<std::shared_ptr<CameraSession>> &sessions,
+                int armTimeoutMs, int eventTimeoutMs, SyncTriggerResult &out) {
+    out = SyncTriggerResult();
+    out.cameras.resize(sessions.size());
+    if (sessions.empty()) return GP_ERROR_BAD_PARAMETERS;
+
+    StartBarrier barrier;
+    Clock::time_point start = Clock::now();
+    Clock::time_point armDeadline = start + std::chrono::milliseconds(armTimeoutMs);
+
+    std::vector<std::thread> threads;
+    threads.reserve(sessions.size());
+    for (size_t i = 0; i < sessions.size(); i++) {
+        threads.emplace_back(fireThread, sessions[i], std::ref(barrier), armDeadline,
+                             eventTimeoutMs, std::ref(out.cameras[i]));
+    }
+
+    barrier.waitArrivals((int) sessions.size(), armDeadline);
+    out.armed = barrier.close();
+    out.armUs = usSince(start);
+    barrier.release(out.armed > 0);
+
+    for (std::thread &t: threads) t.join();
+
+    int ok = 0;
+    for (const SyncTriggerCamera &c: out.cameras) {
+        if (c.result >= GP_OK) ok++;
+    }
+    LOGD("syncTrigger: %d/%zu 발사, dispatch skew=%lldus, FILE_ADDED spread=%lldus",
+         ok, sessions.size(), out.dispatchSkewUs(), out.fileAddedSpreadUs());
+    return ok > 0 ? GP_OK : GP_ERROR;
+}
@@ -0,0 +1,52 @@
+// app/src/main/cpp/sync-trigger.h
+
+#ifndef SYNC_TRIGGER_H
+#define SYNC_TRIGGER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "camera-session.h"
+
+// ----------------------------------------------------------------------------
+// 다중 카메라 동기 트리거 ("fire all")
+//  1) arm: 카메라마다 전용 스레드가 세션 mutex 를 잡고(라이브뷰/명령 큐/이벤트 펌프
+//     정지) trigger 지원 여부를 확인한 뒤 출발선에서 대기
+//  2) release: 모든 스레드가 arm 되면 공유 배리어를 한 번에 열고, 각 스레드가
+//     곧바로 gp_camera_trigger_capture 호출
+//  3) 각 스레드가 첫 GP_EVENT_FILE_ADDED 를 기다려 도착 시각을 기록하고, 파일은
+//     세션의 pendingDownloads 로 넘겨 이벤트 펌프가 내려받게 한다.
+// 모든 시각은 배리어 해제 시점 기준 마이크로초.
+// ----------------------------------------------------------------------------
+struct SyncTriggerCamera {
+    int handle = 0;
+    int result = 0;                 // trigger 결과 (arm 실패면 그 에러)
+    int eventResult = 0;            // FILE_ADDED 대기 결과
+    long long dispatchUs = -1;      // gp_camera_trigger_capture 호출 직전
+    long long returnUs = -1;        // gp_camera_trigger_capture 반환
+    long long fileAddedUs = -1;     // 첫 FILE_ADDED 수신
+    std::string folder;
+    std::string name;
+};
+
+struct SyncTriggerResult {
+    int armed = 0;
+    long long armUs = 0;            // 시작 ~ 모든 카메라 arm 완료
+    std::vector<SyncTriggerCamera> cameras;
+
+    // 성공한 카메라끼리의 (최대 - 최소), 표본이 2개 미만이면 -1
+    long long dispatchSkewUs() const;
+    long long fileAddedSpreadUs() const;
+    std::string toJson() const;
+};
+
+// armTimeoutMs 안에 arm 되지 못한 카메라는 GP_ERROR_TIMEOUT 으로 빠지고 나머지만 발사.
+// 반환: 한 대라도 트리거에 성공하면 GP_OK
+int syncTrigger(const std::vector<std::shared_ptr<CameraSession>> &sessions,
+                int armTimeoutMs, int eventTimeoutMs, SyncTriggerResult &out);
+
+#define SYNC_TRIGGER_ARM_TIMEOUT_MS 3000
+#define SYNC_TRIGGER_EVENT_TIMEOUT_MS 10000
+
+#endif // SYNC_TRIGGER_H
@@ -0,0 +1,360 @@
+// app/src/main/cpp/thumbnail-cache.cpp
+
+#include "thumbnail-cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gphoto2/gphoto2-file.h>
+#include <gphoto2/gphoto2-result.h>
+
+#include "camera-session.h"
+#include "jpeg-util.h"
+#include "native-log.h"
+
+static unsigned long long fnv1a64(const std::string &s) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (unsigned char c: s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ----------------------------------------------------------------------------
+// ThumbnailCache
+// ----------------------------------------------------------------------------
+ThumbnailCache &ThumbnailCache::instance() {
+    static ThumbnailCache cache;
+    return cache;
+}
+
+std::string ThumbnailCache::keyOf(const std::string &serial, const std::string &folder,
+                                  const std::string &name, uint64_t size, int64_t mtime) {
+    char buf[20];
+    snprintf(buf, sizeof(buf), "%016llx",
+             fnv1a64(serial + "\n" + folder + "/" + name + "\n" + std::to_string(size) + "\n" +
+                     std::to_string(mtime)));
+    return buf;
+}
+
+std::string ThumbnailCache::pathOf(const std::string &key) const {
+    return dir_ + "/" + key + ".jpg";
+}
+
+void ThumbnailCache::setDirectory(const std::string &dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir == dir_) return;
+    dir_ = dir;
+    diskLru_.clear();
+    disk_.clear();
+    diskBytes_ = 0;
+    mkdir(dir.c_str(), 0700);
+
+    // 디스크 LRU 복원: mtime 이 최근일수록 앞
+    struct Found {
+        std::string key;
+        size_t size;
+        time_t mtime;
+    };
+    std::vector<Found> found;
+    DIR *d = opendir(dir.c_str());
+    if (!d) return;
+    while (dirent *e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name.size() != 20 || name.compare(16, 4, ".jpg") != 0) continue;
+        struct stat st;
+        if (stat((dir + "/" + name).c_str(), &st) != 0) continue;
+        found.push_back(Found{name.substr(0, 16), (size_t) st.st_size, st.st_mtime});
+    }
+    closedir(d);
+
+    std::sort(found.begin(), found.end(),
+              [](const Found &a, const Found &b) { return a.mtime > b.mtime; });
+    for (const Found &f: found) {
+        diskLru_.push_back(f.key);
+        disk_[f.key] = DiskEntry{f.size, std::prev(diskLru_.end())};
+        diskBytes_ += f.size;
+    }
+    trimDiskLocked();
+    LOGD("ThumbnailCache: 디스크 %zu 개 (%zu KB)", disk_.size(), diskBytes_ / 1024);
+}
+
+void ThumbnailCache::setLimits(size_t memoryBytes, size_t diskBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryLimit_ = memoryBytes;
+    diskLimit_ = diskBytes;
+    trimMemoryLocked();
+    trimDiskLocked();
+}
+
+void ThumbnailCache::trimMemoryLocked() {
+    while (memBytes_ > memoryLimit_ && !memLru_.empty()) {
+        auto it = mem_.find(memLru_.back());
+        memBytes_ -= it->second.thumb->rgba.size();
+        mem_.erase(it);
+        memLru_.pop_back();
+    }
+}
+
+void ThumbnailCache::trimDiskLocked() {
+    while (diskBytes_ > diskLimit_ && !diskLru_.empty()) {
+        const std::string &key = diskLru_.back();
+        auto it = disk_.find(key);
+        diskBytes_ -= it->second.size;
+        unlink(pathOf(key).c_str());
+        disk_.erase(it);
+        diskLru_.pop_back();
+    }
+}
+
+std::shared_ptr<const Thumbnail> ThumbnailCache::getDecoded(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mem_.find(key);
+    if (it == mem_.end()) return nullptr;
+    memLru_.splice(memLru_.begin(), memLru_, it->second.lru);
+    hits_++;
+    return it->second.thumb;
+}
+
+void ThumbnailCache::putDecoded(const std::string &key, std::shared_ptr<const Thumbnail> thumb) {
+    if (!thumb) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mem_.find(key);
+    if (it != mem_.end()) {
+        memBytes_ -= it->second.thumb->rgba.size();
+        memLru_.erase(it->second.lru);
+        mem_.erase(it);
+    }
+    memLru_.push_front(key);
+    memBytes_ += thumb->rgba.size();
+    mem_[key] = MemEntry{std::move(thumb), memLru_.begin()};
+    trimMemoryLocked();
+}
+
+bool ThumbnailCache::hasEncoded(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return disk_.count(key) > 0;
+}
+
+bool ThumbnailCache::getEncoded(const std::string &key, std::vector<uint8_t> &out) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = disk_.find(key);
+        if (it == disk_.end()) {
+            misses_++;
+            return false;
+        }
+        diskLru_.splice(diskLru_.begin(), diskLru_, it->second.lru);
+        diskHits_++;
+        path = pathOf(key);
+    }
+
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t) size : 0);
+    bool ok = size > 0 && fread(out.data(), 1, out.size(), fp) == out.size();
+    fclose(fp);
+    // 다음 실행에서도 최근 사용으로 보이도록
+    if (ok) utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    return ok;
+}
+
+void ThumbnailCache::putEncoded(const std::string &key, const std::vector<uint8_t> &data) {
+    std::string path, tmp;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dir_.empty() || disk_.count(key)) return;
+        path = pathOf(key);
+    }
+    tmp = path + ".tmp";
+
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return;
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    ok = fclose(fp) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (disk_.count(key)) return;
+    diskLru_.push_front(key);
+    disk_[key] = DiskEntry{data.size(), diskLru_.begin()};
+    diskBytes_ += data.size();
+    trimDiskLocked();
+}
+
+std::string ThumbnailCache::statsJson() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << "{\"memoryCount\":" << mem_.size() << ",\"memoryBytes\":" << memBytes_
+        << ",\"diskCount\":" << disk_.size() << ",\"diskBytes\":" << diskBytes_
+        << ",\"memoryHits\":" << hits_ << ",\"diskHits\":" << diskHits_
+        << ",\"misses\":" << misses_ << "}";
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// ThumbnailPrefetcher
+// ----------------------------------------------------------------------------
+void ThumbnailPrefetcher::setWanted(const std::vector<Request> &ordered, int visibleCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+    wanted_.clear();
+    for (size_t i = 0; i < ordered.size(); i++) {
+        if (!wanted_.insert(idOf(ordered[i])).second) continue;
+        queue_.push_back(Item{ordered[i], "", (int) i < visibleCount});
+    }
+    cv_.notify_all();
+}
+
+void ThumbnailPrefetcher::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+}
+
+void ThumbnailPrefetcher::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    queue_.clear();
+    wanted_.clear();
+    cv_.notify_all();
+}
+
+bool ThumbnailPrefetcher::nextItem(Item &out, bool wait) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (wait) cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+    if (!running_ || queue_.empty()) return false;
+    out = queue_.front();
+    queue_.pop_front();
+    return true;
+}
+
+bool ThumbnailPrefetcher::stillWanted(const Request &req) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_ && wanted_.count(idOf(req)) > 0;
+}
+
+std::shared_ptr<const Thumbnail> ThumbnailPrefetcher::decode(const std::vector<uint8_t> &jpeg,
+                                                             int maxEdge) {
+    int w = 0, h = 0;
+    if (!jpegReadSize(jpeg.data(), jpeg.size(), w, h)) return nullptr;
+
+    JpegImage img;
+    if (!jpegDecodeRgb(jpeg.data(), jpeg.size(), jpegPickScaleDenom(w, h, maxEdge), img)) {
+        return nullptr;
+    }
+
+    auto thumb = std::make_shared<Thumbnail>();
+    thumb->width = img.width;
+    thumb->height = img.height;
+    size_t n = (size_t) img.width * img.height;
+    thumb->rgba.resize(n * 4);
+    const uint8_t *src = img.pixels.data();
+    uint8_t *dst = thumb->rgba.data();
+    for (size_t i = 0; i < n; i++, src += 3, dst += 4) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 0xff;
+    }
+    return thumb;
+}
+
+// 가져온 PREVIEW 를 디스크에 두고, 보이는 항목이면 디코드해서 전달
+void ThumbnailPrefetcher::complete(Fetch &f, int maxEdge, const DeliverFn &deliver) {
+    int ret = f.result.get();
+    if (ret == GP_ERROR_CANCEL) return;
+    if (ret < GP_OK || f.data->empty()) {
+        if (f.item.visible && stillWanted(f.item.req)) {
+            deliver(f.item.req, nullptr, ret < GP_OK ? ret : GP_ERROR);
+        }
+        return;
+    }
+
+    ThumbnailCache &cache = ThumbnailCache::instance();
+    cache.putEncoded(f.item.key, *f.data);
+    if (!f.item.visible || !stillWanted(f.item.req)) return;
+
+    std::shared_ptr<const Thumbnail> thumb = decode(*f.data, maxEdge);
+    if (thumb) cache.putDecoded(f.item.key, thumb);
+    deliver(f.item.req, thumb, thumb ? GP_OK : GP_ERROR_CORRUPTED_DATA);
+}
+
+void ThumbnailPrefetcher::run(CameraSession &s, const std::string &serial, int maxEdge,
+                              const DeliverFn &deliver) {
+    ThumbnailCache &cache = ThumbnailCache::instance();
+    std::unique_ptr<Fetch> inflight;
+
+    for (;;) {
+        Item item;
+        // 올려 둔 fetch 가 있으면 기다리지 않고 다음 항목만 본다
+        if (!nextItem(item, !inflight)) {
+            if (!inflight) break;
+            complete(*inflight, maxEdge, deliver);
+            inflight.reset();
+            continue;
+        }
+        // 크기/mtime 은 세션 파일 색인에서 (색인 전이면 0 - 이름만으로 구분)
+        CameraIndex::Entry info{"", "", "", 0, 0};
+        s.fileIndex.find(item.req.folder, item.req.name, info);
+        item.key = ThumbnailCache::keyOf(serial, item.req.folder, item.req.name, info.size,
+                                         info.mtime);
+
+        if (item.visible) {
+            std::shared_ptr<const Thumbnail> thumb = cache.getDecoded(item.key);
+            if (thumb) {
+                deliver(item.req, thumb, GP_OK);
+                continue;
+            }
+            std::vector<uint8_t> jpeg;
+            if (cache.getEncoded(item.key, jpeg)) {
+                thumb = decode(jpeg, maxEdge);
+                if (thumb) {
+                    cache.putDecoded(item.key, thumb);
+                    deliver(item.req, thumb, GP_OK);
+                    continue;
+                }
+            }
+        } else if (cache.hasEncoded(item.key)) {
+            continue;
+        }
+
+        // 카메라에서 PREVIEW 가져오기 - 실행 직전에 아직 필요한지 다시 확인
+        std::unique_ptr<Fetch> next(new Fetch{item, std::make_shared<std::vector<uint8_t>>(), {}});
+        std::shared_ptr<std::vector<uint8_t>> data = next->data;
+        Request req = item.req;
+        next->result = s.commands.post(CommandQueue::PRIORITY_BACKGROUND, [this, &s, req, data]() {
+            if (!stillWanted(req)) return (int) GP_ERROR_CANCEL;
+
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (!s.camera) return (int) GP_ERROR_CANCEL;
+            CameraFile *file;
+            gp_file_new(&file);
+            int r = gp_camera_file_get(s.camera, req.folder.c_str(), req.name.c_str(),
+                                       GP_FILE_TYPE_PREVIEW, file, s.context);
+            s.connection.noteResult(r);
+            const char *bytes = nullptr;
+            unsigned long size = 0;
+            if (r >= GP_OK) r = gp_file_get_data_and_size(file, &bytes, &size);
+            if (r >= GP_OK) data->assign(bytes, bytes + size);
+            gp_file_unref(file);
+            return r;
+        });
+
+        // 다음 것을 올려 둔 뒤 앞의 것을 마무리 (USB 와 디코드가 겹침)
+        if (inflight) complete(*inflight, maxEdge, deliver);
+        inflight = std::move(next);
+    }
+}
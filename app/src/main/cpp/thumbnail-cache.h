@@ -0,0 +1,144 @@
+// app/src/main/cpp/thumbnail-cache.h
+
+#ifndef THUMBNAIL_CACHE_H
+#define THUMBNAIL_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define THUMB_MEMORY_CACHE_MB 32
+#define THUMB_DISK_CACHE_MB 128
+
+// 디코드된 썸네일 (RGBA8888, Android Bitmap ARGB_8888 의 메모리 순서)
+struct Thumbnail {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// ----------------------------------------------------------------------------
+// 2단 썸네일 캐시 (프로세스 전역, 카메라 시리얼을 키에 포함)
+//  - 메모리: 디코드된 RGBA 를 바이트 예산 안에서 LRU 로 유지
+//  - 디스크: 카메라가 준 PREVIEW JPEG 을 filesDir/thumbs/<키>.jpg 로 두고 바이트
+//    예산 안에서 LRU. 적중 시 파일 mtime 을 갱신해 다음 실행에도 순서가 이어진다.
+// ----------------------------------------------------------------------------
+class ThumbnailCache {
+public:
+    static ThumbnailCache &instance();
+
+    // 디렉터리를 읽어 디스크 LRU 를 복원
+    void setDirectory(const std::string &dir);
+    void setLimits(size_t memoryBytes, size_t diskBytes);
+
+    // 크기/mtime 도 넣어 카드 포맷이나 파일 번호 재사용 뒤 같은 이름의 다른 사진과
+    // 섞이지 않게 한다 (모르면 0)
+    static std::string keyOf(const std::string &serial, const std::string &folder,
+                             const std::string &name, uint64_t size, int64_t mtime);
+
+    std::shared_ptr<const Thumbnail> getDecoded(const std::string &key);
+    void putDecoded(const std::string &key, std::shared_ptr<const Thumbnail> thumb);
+
+    bool getEncoded(const std::string &key, std::vector<uint8_t> &out);
+    bool hasEncoded(const std::string &key);
+    void putEncoded(const std::string &key, const std::vector<uint8_t> &data);
+
+    std::string statsJson();
+
+private:
+    ThumbnailCache() = default;
+
+    struct MemEntry {
+        std::shared_ptr<const Thumbnail> thumb;
+        std::list<std::string>::iterator lru;
+    };
+    struct DiskEntry {
+        size_t size;
+        std::list<std::string>::iterator lru;
+    };
+
+    std::string pathOf(const std::string &key) const;
+    void trimMemoryLocked();
+    void trimDiskLocked();
+
+    std::mutex mutex_;
+    size_t memoryLimit_ = (size_t) THUMB_MEMORY_CACHE_MB * 1024 * 1024;
+    size_t diskLimit_ = (size_t) THUMB_DISK_CACHE_MB * 1024 * 1024;
+
+    std::list<std::string> memLru_;     // 앞쪽이 최근
+    std::unordered_map<std::string, MemEntry> mem_;
+    size_t memBytes_ = 0;
+
+    std::string dir_;
+    std::list<std::string> diskLru_;
+    std::unordered_map<std::string, DiskEntry> disk_;
+    size_t diskBytes_ = 0;
+
+    unsigned long long hits_ = 0, diskHits_ = 0, misses_ = 0;
+};
+
+// ----------------------------------------------------------------------------
+// 썸네일 선읽기 (세션마다 하나)
+//  - setWanted 로 스크롤 순서대로 정렬된 목록을 통째로 바꾼다. 앞의 visibleCount 개는
+//    화면에 보이는 항목: 디코드해서 전달. 나머지(곧 보일 항목)는 디스크 캐시까지만.
+//  - 목록에서 빠진 항목은 취소: 아직 안 꺼낸 것은 버리고, 이미 명령 큐에 올라간
+//    것도 실행 직전에 확인해 USB 접근 없이 GP_ERROR_CANCEL 로 끝낸다.
+//  - 카메라 접근은 세션 명령 큐 PRIORITY_BACKGROUND (라이브뷰/촬영이 먼저).
+//    파일 N+1 을 올려 둔 뒤 파일 N 을 디코드해 USB 와 디코드를 겹친다.
+// ----------------------------------------------------------------------------
+struct CameraSession;
+
+class ThumbnailPrefetcher {
+public:
+    struct Request {
+        std::string folder;
+        std::string name;
+    };
+    // thumb 가 null 이면 result 가 실패 코드
+    typedef std::function<void(const Request &req, const std::shared_ptr<const Thumbnail> &thumb,
+                               int result)> DeliverFn;
+
+    void setWanted(const std::vector<Request> &ordered, int visibleCount);
+
+    // start() 후 run() 은 stop() 까지 호출 스레드에서 돈다 (남은 목록은 stop 때 비움)
+    void start();
+    void run(CameraSession &s, const std::string &serial, int maxEdge, const DeliverFn &deliver);
+    void stop();
+
+private:
+    struct Item {
+        Request req;
+        std::string key;        // 캐시 키 (꺼낼 때 시리얼로 계산)
+        bool visible;
+    };
+    struct Fetch {
+        Item item;
+        std::shared_ptr<std::vector<uint8_t>> data;
+        std::future<int> result;
+    };
+
+    static std::string idOf(const Request &req) { return req.folder + "/" + req.name; }
+    bool nextItem(Item &out, bool wait);
+    bool stillWanted(const Request &req);
+    void complete(Fetch &f, int maxEdge, const DeliverFn &deliver);
+    static std::shared_ptr<const Thumbnail> decode(const std::vector<uint8_t> &jpeg, int maxEdge);
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Item> queue_;
+    std::unordered_set<std::string> wanted_;     // idOf(요청)
+    bool running_ = false;
+};
+
+#define THUMB_DEFAULT_MAX_EDGE 320
+
+#endif // THUMBNAIL_CACHE_H
@@ -0,0 +1,209 @@
+// app/src/main/cpp/widget-index.cpp
+
+#include "widget-index.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// FNV-1a (32bit) - 위젯 이름은 짧아서 이 정도로 충분
+static uint32_t hashKey(const char *s) {
+    uint32_t h = 2166136261u;
+    for (; *s; ++s) {
+        h ^= static_cast<uint8_t>(*s);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// ----------------------------------------------------------------------------
+// WidgetIndex
+// ----------------------------------------------------------------------------
+void WidgetIndex::clear() {
+    nodes_.clear();
+    byName_.clear();
+    byLabel_.clear();
+    mask_ = 0;
+}
+
+void WidgetIndex::collect(CameraWidget *widget, int parent, const std::string &parentPath) {
+    const char *nameC = nullptr, *labelC = nullptr;
+    gp_widget_get_name(widget, &nameC);
+    gp_widget_get_label(widget, &labelC);
+
+    WidgetNode node;
+    node.widget = widget;
+    node.name = (nameC ? nameC : "");
+    node.label = (labelC ? labelC : "");
+    node.path = parentPath + "/" + node.name;
+    node.type = GP_WIDGET_WINDOW;
+    gp_widget_get_type(widget, &node.type);
+    node.parent = parent;
+
+    int self = static_cast<int>(nodes_.size());
+    nodes_.push_back(std::move(node));
+    const std::string path = nodes_[self].path;
+
+    int childCount = gp_widget_count_children(widget);
+    for (int i = 0; i < childCount; i++) {
+        CameraWidget *child = nullptr;
+        if (gp_widget_get_child(widget, i, &child) == GP_OK && child) {
+            collect(child, self, path);
+        }
+    }
+}
+
+void WidgetIndex::insert(std::vector<Slot> &table, uint32_t hash, int node) {
+    const uint32_t mask = static_cast<uint32_t>(table.size() - 1);
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        if (table[i].node < 0) {
+            table[i].hash = hash;
+            table[i].node = node;
+            return;
+        }
+    }
+}
+
+void WidgetIndex::build(CameraWidget *root) {
+    clear();
+    if (!root) return;
+
+    collect(root, -1, "");
+
+    // 적재율 50% 이하 유지
+    uint32_t cap = 16;
+    while (cap < nodes_.size() * 2) cap <<= 1;
+    mask_ = cap - 1;
+    byName_.assign(cap, Slot{0, -1});
+    byLabel_.assign(cap, Slot{0, -1});
+
+    // collect 의 전위 순회 순서로 넣고, 이미 같은 키가 있으면 건너뛴다 (먼저 나온 것이 우선).
+    // libgphoto2 의 by_name 탐색 순서와 같다는 보장은 없다 (헤더 참고)
+    for (int i = 0; i < static_cast<int>(nodes_.size()); i++) {
+        const WidgetNode &n = nodes_[i];
+        if (!n.name.empty() && !lookup(byName_, n.name.c_str(), false)) {
+            insert(byName_, hashKey(n.name.c_str()), i);
+        }
+        if (!n.label.empty() && !lookup(byLabel_, n.label.c_str(), true)) {
+            insert(byLabel_, hashKey(n.label.c_str()), i);
+        }
+    }
+}
+
+const WidgetNode *WidgetIndex::lookup(const std::vector<Slot> &table, const char *key,
+                                      bool byLabel) const {
+    if (table.empty() || !key) return nullptr;
+    const uint32_t hash = hashKey(key);
+    for (uint32_t i = hash & mask_;; i = (i + 1) & mask_) {
+        const Slot &s = table[i];
+        if (s.node < 0) return nullptr;
+        if (s.hash != hash) continue;
+        const WidgetNode &n = nodes_[s.node];
+        const std::string &k = byLabel ? n.label : n.name;
+        if (k == key) return &n;
+    }
+}
+
+const WidgetNode *WidgetIndex::findByName(const char *name) const {
+    return lookup(byName_, name, false);
+}
+
+const WidgetNode *WidgetIndex::findByLabel(const char *label) const {
+    return lookup(byLabel_, label, true);
+}
+
+const WidgetNode *WidgetIndex::find(const char *key) const {
+    const WidgetNode *n = findByName(key);
+    return n ? n : findByLabel(key);
+}
+
+// ----------------------------------------------------------------------------
+// ConfigSnapshot
+// ----------------------------------------------------------------------------
+ConfigSnapshot::~ConfigSnapshot() {
+    reset();
+}
+
+void ConfigSnapshot::reset() {
+    index_.clear();
+    stale_ = false;
+    if (root_) {
+        gp_widget_free(root_);
+        root_ = nullptr;
+    }
+}
+
+int ConfigSnapshot::load(Camera *cam, GPContext *ctx) {
+    CameraWidget *config = nullptr;
+    int ret = gp_camera_get_config(cam, &config, ctx);
+    if (ret < GP_OK || !config) {
+        if (config) gp_widget_free(config);
+        return ret < GP_OK ? ret : GP_ERROR;
+    }
+
+    reset();
+    root_ = config;
+    index_.build(root_);
+    return GP_OK;
+}
+
+// ----------------------------------------------------------------------------
+// 위젯 값 <-> 문자열
+// ----------------------------------------------------------------------------
+bool widgetValueToString(CameraWidget *widget, std::string &out) {
+    CameraWidgetType type;
+    if (gp_widget_get_type(widget, &type) < GP_OK) return false;
+
+    switch (type) {
+        case GP_WIDGET_TEXT:
+        case GP_WIDGET_RADIO:
+        case GP_WIDGET_MENU: {
+            const char *v = nullptr;
+            if (gp_widget_get_value(widget, &v) < GP_OK) return false;
+            out = (v ? v : "");
+            return true;
+        }
+        case GP_WIDGET_RANGE: {
+            float v = 0.f;
+            if (gp_widget_get_value(widget, &v) < GP_OK) return false;
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%g", v);
+            out = buf;
+            return true;
+        }
+        case GP_WIDGET_TOGGLE:
+        case GP_WIDGET_DATE: {
+            int v = 0;
+            if (gp_widget_get_value(widget, &v) < GP_OK) return false;
+            out = std::to_string(v);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+int widgetSetValueFromString(CameraWidget *widget, const char *value) {
+    CameraWidgetType type;
+    int ret = gp_widget_get_type(widget, &type);
+    if (ret < GP_OK) return ret;
+    if (!value) return GP_ERROR_BAD_PARAMETERS;
+
+    switch (type) {
+        case GP_WIDGET_TEXT:
+        case GP_WIDGET_RADIO:
+        case GP_WIDGET_MENU:
+            return gp_widget_set_value(widget, value);
+        case GP_WIDGET_RANGE: {
+            float v = strtof(value, nullptr);
+            return gp_widget_set_value(widget, &v);
+        }
+        case GP_WIDGET_TOGGLE:
+        case GP_WIDGET_DATE: {
+            int v = static_cast<int>(strtol(value, nullptr, 10));
+            return gp_widget_set_value(widget, &v);
+        }
+        default:
+            return GP_ERROR_NOT_SUPPORTED;
+    }
+}
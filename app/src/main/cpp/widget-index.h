@@ -0,0 +1,104 @@
+// app/src/main/cpp/widget-index.h
+
+#ifndef WIDGET_INDEX_H
+#define WIDGET_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gphoto2/gphoto2-camera.h>
+#include <gphoto2/gphoto2-context.h>
+#include <gphoto2/gphoto2-widget.h>
+
+// ----------------------------------------------------------------------------
+// 위젯 이름/라벨 → 노드 인덱스
+//  - gp_widget_get_child_by_name/label 은 호출마다 트리 전체를 재귀 탐색하므로
+//    config 스냅샷 하나당 한 번만 트리를 훑어 open-addressing 테이블을 만든다.
+//  - 중복 이름/라벨은 이 인덱스의 규칙으로 해석: 루트부터 자식 순서대로 깊이 우선
+//    (전위 순회) 훑어 먼저 나온 노드. gp_widget_get_child_by_name/label 은 자식 단위로
+//    재귀하며 비교하므로 이름이 겹치면 다른 위젯을 돌려줄 수 있다 (같다고 가정하지 말 것).
+//    겹치는 이름을 구분해야 하면 nodes() 의 path 로 찾는다.
+// ----------------------------------------------------------------------------
+struct WidgetNode {
+    CameraWidget *widget;
+    std::string name;
+    std::string label;
+    std::string path;   // 예: /main/capturesettings/shutterspeed
+    CameraWidgetType type;
+    int parent;         // nodes 내 부모 인덱스 (루트는 -1)
+};
+
+class WidgetIndex {
+public:
+    // root 트리를 인덱싱한다. root 의 소유권은 가져가지 않는다.
+    void build(CameraWidget *root);
+    void clear();
+
+    const WidgetNode *findByName(const char *name) const;
+    const WidgetNode *findByLabel(const char *label) const;
+    // 이름 우선, 없으면 라벨로 검색
+    const WidgetNode *find(const char *key) const;
+
+    const std::vector<WidgetNode> &nodes() const { return nodes_; }
+    size_t size() const { return nodes_.size(); }
+
+private:
+    struct Slot {
+        uint32_t hash;
+        int32_t node;   // -1 이면 빈 슬롯
+    };
+
+    void collect(CameraWidget *widget, int parent, const std::string &parentPath);
+    static void insert(std::vector<Slot> &table, uint32_t hash, int node);
+    const WidgetNode *lookup(const std::vector<Slot> &table, const char *key,
+                             bool byLabel) const;
+
+    std::vector<WidgetNode> nodes_;
+    std::vector<Slot> byName_;
+    std::vector<Slot> byLabel_;
+    uint32_t mask_ = 0;
+};
+
+// ----------------------------------------------------------------------------
+// config 스냅샷: gp_camera_get_config 결과 트리 + 인덱스를 함께 보관
+// ----------------------------------------------------------------------------
+class ConfigSnapshot {
+public:
+    ConfigSnapshot() = default;
+    ~ConfigSnapshot();
+    ConfigSnapshot(const ConfigSnapshot &) = delete;
+    ConfigSnapshot &operator=(const ConfigSnapshot &) = delete;
+
+    // 카메라에서 트리를 새로 읽어 인덱스를 다시 만든다. (호출자가 카메라 락 보유)
+    int load(Camera *cam, GPContext *ctx);
+    void reset();
+
+    // 카메라 쪽 값이 바뀌었을 수 있음 (설정 변경 이벤트, 촬영, 재연결). 트리는 그대로 두고
+    // 현재값이 필요한 곳이 다음에 다시 읽게 한다
+    void markStale() { stale_ = true; }
+
+    bool valid() const { return root_ != nullptr; }
+    bool fresh() const { return root_ != nullptr && !stale_; }
+    CameraWidget *root() const { return root_; }
+    const WidgetIndex &index() const { return index_; }
+
+    CameraWidget *widget(const char *key) const {
+        const WidgetNode *n = index_.find(key);
+        return n ? n->widget : nullptr;
+    }
+
+private:
+    CameraWidget *root_ = nullptr;
+    WidgetIndex index_;
+    bool stale_ = false;
+};
+
+// ----------------------------------------------------------------------------
+// 위젯 값 <-> 문자열 (TEXT/RADIO/MENU 는 그대로, RANGE 는 float, TOGGLE/DATE 는 int)
+//  - WINDOW/SECTION/BUTTON 처럼 값이 없는 위젯은 false / GP_ERROR_NOT_SUPPORTED
+// ----------------------------------------------------------------------------
+bool widgetValueToString(CameraWidget *widget, std::string &out);
+int widgetSetValueFromString(CameraWidget *widget, const char *value);
+
+#endif // WIDGET_INDEX_H
@@ -0,0 +1,8 @@
+package com.inik.phototest2
+
+interface CameraIndexListener {
+    // 새로 색인된 파일들 (JSON 배열: folder, name, size, mtime, type)
+    fun onIndexBatch(filesJson: String)
+    // resultCode < 0 이면 취소/연결 끊김 등으로 중단 (그때까지의 결과는 남음)
+    fun onIndexComplete(totalFiles: Int, elapsedMs: Long, resultCode: Int)
+}
@@ -16,22 +16,145 @@ object CameraNative {
     external fun initCamera(): String
     external fun listenCameraEvents(callback: CameraCaptureListener)
     external fun initCameraWithFd(fd: Int, nativeLibDir: String): Int
+    external fun initCameraWithFdFast(
+        fd: Int, nativeLibDir: String, vendorId: Int, productId: Int, usbClass: Int
+    ): Int
+    external fun getStartupTimelineJson(): String
     external fun capturePhoto(): Int
     external fun capturePhotoAsync(callback: CameraCaptureListener)
     external fun getCameraSummary(): String
     external fun closeCamera()
     external fun detectCamera(): String
     external fun isCameraConnected(): Boolean
+    external fun getConnectionStateJson(): String
 //    external fun listCameraCapabilities(): String
     external fun listCameraAbilities(): String
     external fun requestCapture()
 //    external fun startListenCameraEvents(callback: CameraCaptureListener)
     external fun stopListenCameraEvents()
+    // 중단된 다운로드 저널 상태 JSON (pending/done/failed)
+    external fun getDownloadJournalJson(): String
     external fun cameraAutoDetect():String
     external fun buildWidgetJson():String
+    external fun getCachedWidgetJson(): String
+    external fun getWidgetValuesJson(): String
+    external fun setStorageDir(dir: String)
+    external fun setArchivalHashEnabled(enabled: Boolean)
+
+    // --- 사진 저장소 (filesDir/photo_*, 예산 + LRU) ---
+    // budgetMb <= 0 이면 기본값. pinNewFiles 면 새 파일은 setPhotoSynced(path, true) 전까지 지우지 않음
+    external fun setPhotoStoreLimits(budgetMb: Int, pinNewFiles: Boolean)
+    external fun touchPhoto(path: String): Boolean
+    external fun setPhotoSynced(path: String, synced: Boolean): Boolean
+    external fun trimPhotoStore(): Int
+    external fun getPhotoStoreStatsJson(): String
+
+    // --- 설정 프리셋 ---
+    external fun savePreset(name: String, keys: Array<String>, values: Array<String>): Boolean
+    external fun capturePreset(name: String, keys: Array<String>): Int
+    external fun deletePreset(name: String): Boolean
+    external fun listPresetsJson(): String
+    external fun applyPreset(name: String): Int
 //    external fun capturePhotoDuringLiveView() : Int
 
     // --- 라이브뷰 관련 ---
     external fun startLiveView(callback: LiveViewCallback)
     external fun stopLiveView()
+    // 라이브뷰 프레임 분석 비트 (0 = 끔). 결과는 LiveViewCallback.onLiveViewHistogram / onLiveViewFocus
+    const val LIVEVIEW_HISTOGRAM = 1
+    const val LIVEVIEW_FOCUS = 2
+    external fun setLiveViewAnalysis(flags: Int)
+    // 초점 피킹 기준 (Sobel 크기 0..2040, 기본 160)
+    external fun setLiveViewPeakingThreshold(threshold: Int)
+
+    // --- 다중 카메라 세션 (핸들 0 = 위의 기본 카메라) ---
+    // 성공 시 세션 핸들(>0), 실패 시 gPhoto2 에러 코드(<0)
+    external fun openSession(
+        fd: Int, nativeLibDir: String, vendorId: Int, productId: Int, usbClass: Int
+    ): Int
+    external fun closeSession(handle: Int)
+    external fun listSessionsJson(): String
+    external fun sessionCapture(handle: Int): Int
+    external fun sessionGetSummary(handle: Int): String
+    external fun sessionGetConnectionStateJson(handle: Int): String
+    external fun sessionListenEvents(handle: Int, callback: CameraCaptureListener)
+    external fun sessionStopEvents(handle: Int)
+    external fun sessionStartLiveView(handle: Int, callback: LiveViewCallback)
+    external fun sessionStopLiveView(handle: Int)
+    external fun sessionRequestCapture(handle: Int)
+    // 빈 배열이면 열린 모든 세션을 동시에 트리거, 결과는 skew 측정 JSON
+    external fun syncTrigger(handles: IntArray, eventTimeoutMs: Int): String
+
+    // --- 카메라 파일 색인 (handle 0 = 기본 카메라) ---
+    // 이미 색인 중이면 false. 결과는 listener 로 조금씩 전달되고 세션에 남는다
+    external fun startCameraIndex(handle: Int, listener: CameraIndexListener): Boolean
+    external fun cancelCameraIndex(handle: Int)
+    external fun getCameraIndexJson(handle: Int, offset: Int, count: Int): String
+    external fun getCameraIndexStatsJson(handle: Int): String
+    // 이전에 가져온 적 없는(또는 바뀐) 파일만 내려받기. 이미 색인/가져오기 중이면 false
+    // memoryBudgetMb: USB 로 받았지만 아직 못 쓴 데이터 상한 (0 이면 기본 64MB)
+    external fun startImportSync(
+        handle: Int, listener: ImportSyncListener, memoryBudgetMb: Int
+    ): Boolean
+    external fun cancelImportSync(handle: Int)
+    external fun getImportedCount(): Long
+
+    // --- 썸네일 갤러리 (GP_FILE_TYPE_PREVIEW, 메모리/디스크 LRU) ---
+    // maxEdge: 디코드 후 긴 변 최소 길이 (0 이면 기본 320)
+    external fun startThumbnails(handle: Int, callback: ThumbnailCallback, maxEdge: Int): Boolean
+    // 스크롤 순서대로, 앞의 visibleCount 개가 화면에 보이는 항목. 목록에서 빠지면 취소
+    external fun requestThumbnails(
+        handle: Int, folders: Array<String>, names: Array<String>, visibleCount: Int
+    )
+    external fun stopThumbnails(handle: Int)
+    external fun setThumbnailCacheLimits(memoryMb: Int, diskMb: Int)
+    external fun getThumbnailCacheStatsJson(): String
+    // 내려받은 JPEG 옆의 <파일>.thumb.jpg (maxEdge <= 0 이면 320). 실패하면 null
+    external fun makeThumbnail(path: String, maxEdge: Int): String?
+    // 공유용 축소본 <파일>.share.jpg (megapixels <= 0 이면 2MP, quality <= 0 이면 85).
+    // 여러 장을 동시에 처리하고 끝날 때까지 막힌다. 입력 순서대로, 실패는 null
+    external fun exportShareImages(
+        paths: Array<String>, megapixels: Float, quality: Int
+    ): Array<String?>
+
+    // --- EXIF 메타데이터 색인 ---
+    // 필드 번호 (queryExif 의 sortField, ranges 순서)
+    const val EXIF_CAPTURE_TIME = 0
+    const val EXIF_EXPOSURE = 1
+    const val EXIF_FNUMBER = 2
+    const val EXIF_ISO = 3
+    const val EXIF_FOCAL = 4
+    const val EXIF_ORIENTATION = 5
+    const val EXIF_SHUTTER_COUNT = 6
+
+    external fun getExifJson(path: String): String
+    external fun readCameraExifJson(handle: Int, folder: String, name: String): String
+    // RAW(NEF/CR2/ARW/DNG ...) 안의 큰 미리보기 JPEG 만 부분 읽기로 (방향 반영). 못 하면 null
+    external fun readRawPreview(handle: Int, folder: String, name: String): ByteArray?
+    // ranges: 필드마다 [min, max] (Double.NaN 은 제한 없음). 반환은 행 번호
+    external fun queryExif(sortField: Int, descending: Boolean, ranges: DoubleArray?): IntArray
+    external fun getExifRowsJson(rows: IntArray): String
+    external fun getExifIndexSize(): Int
+    external fun clearExifIndex()
+
+    // --- 후처리 CPU 풀 ---
+    // 작업 종류 (setCpuPoolLimit 의 jobType)
+    const val CPU_JOB_THUMBNAIL = 0
+    const val CPU_JOB_EXIF = 1
+    const val CPU_JOB_HASH = 2
+    const val CPU_JOB_ENCODE = 3
+
+    // 종류별 동시 실행 상한 (기본: 썸네일/재인코드 = big 코어 - 1, 나머지 = big 코어 수)
+    external fun setCpuPoolLimit(jobType: Int, maxConcurrent: Int)
+    external fun getCpuPoolStatsJson(): String
+    // 가져온 세로 JPEG 을 EXIF orientation 대로 무손실 회전해 저장 (기본 켜짐)
+    external fun setOrientationNormalizeEnabled(enabled: Boolean)
+
+    // --- 재연결 ---
+    // 분리된 장치의 세션을 멈추고(콜백/대기 다운로드/설정 캐시 유지) 재부착을 기다림
+    external fun onUsbDeviceDetached(vendorId: Int, productId: Int)
+    // 성공 시 복원된 세션 핸들, 복원할 세션이 없으면 음수
+    external fun reconnectSession(
+        fd: Int, nativeLibDir: String, vendorId: Int, productId: Int, usbClass: Int
+    ): Int
 }
\ No newline at end of file
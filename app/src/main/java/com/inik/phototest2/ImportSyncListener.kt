@@ -0,0 +1,9 @@
+package com.inik.phototest2
+
+interface ImportSyncListener {
+    fun onFileImported(filePath: String, cameraFolder: String, cameraName: String)
+    // resultCode < 0 이면 취소/연결 끊김으로 중단 (남은 파일은 다음 동기화 때)
+    // 처리율: usbMBps(USB 만) vs endToEndMBps(쓰기까지 포함), stallUs 등
+    fun onSyncStats(statsJson: String) {}
+    fun onSyncComplete(imported: Int, skipped: Int, failed: Int, resultCode: Int)
+}
@@ -5,4 +5,18 @@ import java.nio.ByteBuffer
 interface LiveViewCallback {
      fun onLiveViewFrame(jpgBuffer: ByteBuffer)
      fun onLivePhotoCaptured(filePath: String)
+
+     // setLiveViewAnalysis(LIVEVIEW_HISTOGRAM) 일 때 프레임마다 (라이브뷰 스레드)
+     // histogram: R, G, B, 휘도 순 256 칸씩 (1024)
+     // clipMask: 32x24 격자, 행 우선. 비트 1 = 하이라이트, 2 = 섀도 클리핑
+     fun onLiveViewHistogram(histogram: IntArray, clipMask: ByteArray) {}
+
+     // setLiveViewAnalysis(LIVEVIEW_FOCUS) 일 때 프레임마다 (라이브뷰 스레드)
+     // peakMask: width x height 바이트 (0 또는 255), 이 호출 안에서만 유효 -> 필요하면 복사
+     // sharpness: 프레임 전체 선명도 (Sobel 크기 RMS, 같은 장면에서 클수록 초점이 맞음)
+     // regionSharpness: 8x6 격자, 행 우선
+     fun onLiveViewFocus(
+          peakMask: ByteBuffer, width: Int, height: Int,
+          sharpness: Float, regionSharpness: FloatArray
+     ) {}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ import android.content.Intent
 import android.graphics.Bitmap
 import android.graphics.BitmapFactory
 import android.graphics.ImageDecoder
+import android.hardware.usb.UsbConstants
 import android.hardware.usb.UsbDevice
 import android.hardware.usb.UsbManager
 import android.os.Build
@@ -194,7 +195,15 @@ class MainActivity : AppCompatActivity(), CameraCaptureListener, LiveViewCallbac
             Log.d(TAG, "USB 파일 디스크립터 얻음: $fd")
 
             // 초기화는 백그라운드에서 수행
-            val result = CameraNative.initCameraWithFd(fd, applicationInfo.nativeLibraryDir)
+            // PTP 여부는 장치 클래스가 아니라 인터페이스 클래스에 있는 경우가 대부분
+            val usbClass = (0 until device.interfaceCount)
+                .map { device.getInterface(it).interfaceClass }
+                .firstOrNull { it == UsbConstants.USB_CLASS_STILL_IMAGE }
+                ?: device.deviceClass
+            val result = CameraNative.initCameraWithFdFast(
+                fd, applicationInfo.nativeLibraryDir,
+                device.vendorId, device.productId, usbClass
+            )
 
             // 무거운 작업들을 백그라운드에서 처리
             val info: String? = if (result >= 0) {
@@ -208,6 +217,7 @@ class MainActivity : AppCompatActivity(), CameraCaptureListener, LiveViewCallbac
                 null
             }
             val detectInfo: String = CameraNative.cameraAutoDetect()
+            Log.d(TAG, "연결 타임라인: ${CameraNative.getStartupTimelineJson()}")
 
             startListenPhoto()
 
@@ -418,8 +428,10 @@ class MainActivity : AppCompatActivity(), CameraCaptureListener, LiveViewCallbac
             Thread.sleep(500)
         }
 
-        // 3) buildWidgetJsonWithRetry() 호출
-        val json = CameraNative.buildWidgetJson()
+        // 3) 기종별 캐시된 스키마가 있으면 바로 사용, 없으면 buildWidgetJsonWithRetry() 호출
+        val cached = CameraNative.getCachedWidgetJson()
+        val fromCache = !cached.contains("\"error\"")
+        val json = if (fromCache) cached else CameraNative.buildWidgetJson()
         if (json.contains("\"error\"")) {
             Log.e("MainActivity", "Error in JSON: $json")
             return
@@ -435,6 +447,10 @@ class MainActivity : AppCompatActivity(), CameraCaptureListener, LiveViewCallbac
 
         // 4) UI에 표시 or RecyclerView로 펼치기
         showWidgetInUI(rootWidget)
+
+        // 5) 현재값은 스키마를 먼저 보여준 뒤 따로 가져온다
+        val values = CameraNative.getWidgetValuesJson()
+        Log.d("MainActivity", "Widget values (cache=$fromCache):\n$values")
     }
 
     // 예: 화면에 간단히 로그로 찍어보기 (재귀)
@@ -8,7 +8,6 @@ import android.content.Intent
 import android.content.IntentFilter
 import android.hardware.usb.UsbManager
 import android.util.Log
-import java.io.File
 
 class MyApp : Application(), Application.ActivityLifecycleCallbacks {
 
@@ -16,6 +15,8 @@ class MyApp : Application(), Application.ActivityLifecycleCallbacks {
         const val ACTION_USB_PERMISSION = "com.inik.phototest2.USB_PERMISSION"
         lateinit var permissionIntent: PendingIntent
         private const val TAG = "MyApp"
+        // 내려받은 사진이 filesDir 에서 차지할 수 있는 최대 크기
+        private const val PHOTO_STORE_BUDGET_MB = 1024
     }
 
     // 현재 실행 중인 액티비티 수를 추적
@@ -44,27 +45,15 @@ class MyApp : Application(), Application.ActivityLifecycleCallbacks {
 //
 //        Log.d("MyApp", "MyApp 초기화 완료 — USB 리시버 등록")
 
+        // 네이티브 캐시/인덱스 파일 위치
+        CameraNative.setStorageDir(filesDir.absolutePath)
+        // 예산을 넘으면 오래된 사진부터 지운다 (가져오기 기록도 지워 다음 동기화에서 다시 받음)
+        CameraNative.setPhotoStoreLimits(PHOTO_STORE_BUDGET_MB, false)
+
         // Activity lifecycle 콜백 등록 (앱 상태 모니터링)
         registerActivityLifecycleCallbacks(this)
     }
 
-    /**
-     * 모든 사진 파일 삭제 메서드
-     */
-    private fun deleteAllPhotoFiles() {
-        val filesDir: File = applicationContext.filesDir
-        val photoFiles = filesDir.listFiles { file ->
-            file.name.startsWith("photo_") && file.name.endsWith(".jpg")
-        }
-        photoFiles?.forEach { file ->
-            if (file.delete()) {
-                Log.d(TAG, "Deleted photo file: ${file.absolutePath}")
-            } else {
-                Log.e(TAG, "Failed to delete photo file: ${file.absolutePath}")
-            }
-        }
-    }
-
     // --- ActivityLifecycleCallbacks 구현 ---
     override fun onActivityCreated(activity: Activity, savedInstanceState: android.os.Bundle?) {}
 
@@ -82,9 +71,9 @@ class MyApp : Application(), Application.ActivityLifecycleCallbacks {
     override fun onActivityStopped(activity: Activity) {
         isActivityChangingConfigurations = activity.isChangingConfigurations
         if (--activityReferences == 0 && !isActivityChangingConfigurations) {
-            // 앱이 백그라운드로 전환됨 → 사진 파일 삭제 수행
-            Log.d(TAG, "앱이 백그라운드로 전환됨, 모든 사진 파일 삭제")
-            deleteAllPhotoFiles()
+            // 앱이 백그라운드로 전환됨 → 예산을 넘은 오래된 사진만 정리 (잠깐 전환은 다시 받지 않게)
+            val removed = CameraNative.trimPhotoStore()
+            Log.d(TAG, "앱이 백그라운드로 전환됨, 사진 저장소 정리: ${removed}개 삭제")
         }
     }
 
@@ -0,0 +1,9 @@
+package com.inik.phototest2
+
+import java.nio.ByteBuffer
+
+interface ThumbnailCallback {
+    // rgba 는 콜백 안에서만 유효 - Bitmap.copyPixelsFromBuffer 등으로 바로 복사할 것
+    fun onThumbnail(folder: String, name: String, width: Int, height: Int, rgba: ByteBuffer)
+    fun onThumbnailFailed(folder: String, name: String, errorCode: Int)
+}
@@ -4,10 +4,14 @@ import android.app.PendingIntent
 import android.content.BroadcastReceiver
 import android.content.Context
 import android.content.Intent
+import android.hardware.usb.UsbConstants
 import android.hardware.usb.UsbDevice
+import android.hardware.usb.UsbDeviceConnection
 import android.hardware.usb.UsbManager
 import android.util.Log
 import android.widget.Toast
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.Executors
 
 class UsbPermissionReceiver : BroadcastReceiver() {
     companion object {
@@ -15,6 +19,13 @@ class UsbPermissionReceiver : BroadcastReceiver() {
         private var lastEventTime = 0L
         private const val DEBOUNCE_MS = 500L
         private var lastDeviceName: String? = null
+
+        // 재연결로 복원된 세션이 쓰는 USB 연결 (세션이 살아 있는 동안 fd 유지)
+        private val reconnectedConnections = ConcurrentHashMap<String, UsbDeviceConnection>()
+
+        // 분리/재부착 처리는 스레드 join 과 USB 타임아웃으로 몇 초씩 걸릴 수 있어 메인 스레드
+        // 밖에서, 도착 순서대로 하나씩 (분리 처리가 끝나기 전에 재연결이 먼저 돌지 않게)
+        private val usbWork = Executors.newSingleThreadExecutor()
     }
 
     override fun onReceive(context: Context, intent: Intent) {
@@ -44,6 +55,7 @@ class UsbPermissionReceiver : BroadcastReceiver() {
             UsbManager.ACTION_USB_DEVICE_ATTACHED -> {
                 if (usbManager.hasPermission(device)) {
                     Log.d(TAG, "UM_USB 장치 이미 권한 있음: ${device.deviceName}")
+                    reconnect(context, usbManager, device)
 //                    handleAttach(device, usbManager, context)
 //                    showUsbPermissionDialog(context)
                     //todo main이동
@@ -55,8 +67,7 @@ class UsbPermissionReceiver : BroadcastReceiver() {
 
             UsbManager.ACTION_USB_DEVICE_DETACHED -> {
                 Log.d(TAG, "UM_USB 장치 분리됨: ${device.deviceName}")
-                CameraNative.stopListenCameraEvents()
-                CameraNative.closeCamera()
+                detach(device)
             }
 
             MyApp.ACTION_USB_PERMISSION -> {
@@ -74,6 +85,46 @@ class UsbPermissionReceiver : BroadcastReceiver() {
         }
     }
 
+    // 세션을 닫지 않고 멈춰 두었다가 재부착 시 그대로 복원
+    private fun detach(device: UsbDevice) {
+        val pending = goAsync()
+        usbWork.execute {
+            try {
+                CameraNative.onUsbDeviceDetached(device.vendorId, device.productId)
+                reconnectedConnections.remove(device.deviceName)?.close()
+            } finally {
+                pending.finish()
+            }
+        }
+    }
+
+    // 끊겼던 세션이 있으면 새 fd 로 복원 (초기화가 길 수 있어 백그라운드에서)
+    private fun reconnect(context: Context, usbManager: UsbManager, device: UsbDevice) {
+        val pending = goAsync()
+        usbWork.execute {
+            try {
+                val connection = usbManager.openDevice(device) ?: return@execute
+                val usbClass = (0 until device.interfaceCount)
+                    .map { device.getInterface(it).interfaceClass }
+                    .firstOrNull { it == UsbConstants.USB_CLASS_STILL_IMAGE }
+                    ?: device.deviceClass
+                val handle = CameraNative.reconnectSession(
+                    connection.fileDescriptor, context.applicationInfo.nativeLibraryDir,
+                    device.vendorId, device.productId, usbClass
+                )
+                if (handle >= 0) {
+                    Log.d(TAG, "세션 $handle 재연결 완료: ${device.deviceName}")
+                    reconnectedConnections[device.deviceName] = connection
+                } else {
+                    Log.d(TAG, "재연결할 세션 없음 ($handle): ${device.deviceName}")
+                    connection.close()
+                }
+            } finally {
+                pending.finish()
+            }
+        }
+    }
+
     private fun requestUsbPermission(context: Context, usbManager: UsbManager, device: UsbDevice) {
         val intent = Intent(MyApp.ACTION_USB_PERMISSION).apply {
             setPackage(context.packageName)
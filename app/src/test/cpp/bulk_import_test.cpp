@@ -0,0 +1,247 @@
+// app/src/test/cpp/bulk_import_test.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <gphoto2/gphoto2.h>
+
+#include "bulk-import.h"
+#include "content-hash.h"
+#include "imported-index.h"
+
+// ----------------------------------------------------------------------------
+// 대량 가져오기 호스트 테스트 (libgphoto2 의 directory camlib + disk iolib, 호스트에
+// 없으면 같은 동작의 stubs/gphoto2-directory.cpp)
+//  - 임시 디렉터리를 카드로 보고 "Directory Browse" 카메라를 disk:<경로> 로 연다
+//  - 앱의 importSync 처럼 fetch 는 gp_camera_file_get, 완료 때 markImported
+//  - 확인: 저장 파일 내용/이름이 원본 해시와 같은지, 같은 내용은 duplicate 하나로,
+//    ImportedIndex 가 전부 IMPORTED, 버퍼 최대치가 예산(또는 가장 큰 파일 하나)을
+//    넘지 않는지 (back-pressure)
+// ----------------------------------------------------------------------------
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        failures++; \
+    } \
+} while (0)
+
+static const uint64_t BUDGET_BYTES = 4 * 1024 * 1024;
+static const char SERIAL[] = "host-test";
+
+static bool writeFile(const std::string &path, const std::string &data) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    return fclose(fp) == 0 && ok;
+}
+
+static bool readFile(const std::string &path, std::string &out) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    out.clear();
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return true;
+}
+
+static std::string randomBytes(size_t size, uint32_t seed) {
+    std::string s(size, '\0');
+    for (char &c: s) {
+        seed = seed * 1664525u + 1013904223u;
+        c = (char) (seed >> 24);
+    }
+    return s;
+}
+
+static std::string fastHexOf(const std::string &data) {
+    ContentHasher hasher(false);
+    hasher.update(data.data(), data.size());
+    return hasher.finish().fastHex();
+}
+
+static int openDirectoryCamera(const std::string &dir, GPContext *context, Camera **out) {
+    Camera *camera = nullptr;
+    int ret = gp_camera_new(&camera);
+    if (ret < GP_OK) return ret;
+
+    CameraAbilitiesList *abilities = nullptr;
+    gp_abilities_list_new(&abilities);
+    ret = gp_abilities_list_load(abilities, context);
+    int model = ret >= GP_OK ? gp_abilities_list_lookup_model(abilities, "Directory Browse") : ret;
+    if (model >= GP_OK) {
+        CameraAbilities a;
+        gp_abilities_list_get_abilities(abilities, model, &a);
+        ret = gp_camera_set_abilities(camera, a);
+    } else {
+        ret = model;
+    }
+    gp_abilities_list_free(abilities);
+
+    // disk iolib 의 "^disk:" 일반 항목이 임의 경로를 받아준다
+    GPPortInfoList *ports = nullptr;
+    if (ret >= GP_OK) {
+        gp_port_info_list_new(&ports);
+        ret = gp_port_info_list_load(ports);
+    }
+    if (ret >= GP_OK) {
+        const std::string path = "disk:" + dir;
+        int p = gp_port_info_list_lookup_path(ports, path.c_str());
+        GPPortInfo info;
+        ret = p >= GP_OK ? gp_port_info_list_get_info(ports, p, &info) : p;
+        if (ret >= GP_OK) ret = gp_camera_set_port_info(camera, info);
+    }
+    if (ports) gp_port_info_list_free(ports);
+
+    if (ret >= GP_OK) ret = gp_camera_init(camera, context);
+    if (ret < GP_OK) {
+        gp_camera_free(camera);
+        return ret;
+    }
+    *out = camera;
+    return GP_OK;
+}
+
+int main() {
+    char pattern[] = "/tmp/bulk_import_test.XXXXXX";
+    if (!mkdtemp(pattern)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string root = pattern;
+    const std::string card = root + "/card";
+    const std::string out = root + "/out";
+    mkdir(card.c_str(), 0700);
+    mkdir(out.c_str(), 0700);
+
+    // 예산(4MB) 안에 여러 장이 들어가는 크기 + 예산보다 큰 한 장 + 같은 내용 두 장
+    std::map<std::string, std::string> files;
+    for (int i = 0; i < 12; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "IMG_%04d.JPG", i);
+        files[name] = randomBytes((size_t) (700 + 173 * i) * 1024, (uint32_t) i + 1);
+    }
+    files["IMG_0100.JPG"] = randomBytes(6 * 1024 * 1024, 100);
+    files["IMG_0101.JPG"] = files["IMG_0003.JPG"];
+    uint64_t largest = 0;
+    for (const auto &f: files) {
+        if (!writeFile(card + "/" + f.first, f.second)) {
+            fprintf(stderr, "카드 파일을 쓰지 못함: %s\n", f.first.c_str());
+            return 1;
+        }
+        largest = std::max<uint64_t>(largest, f.second.size());
+    }
+
+    GPContext *context = gp_context_new();
+    Camera *camera = nullptr;
+    int ret = openDirectoryCamera(card, context, &camera);
+    if (ret < GP_OK) {
+        fprintf(stderr, "directory 카메라를 열지 못함: %s\n", gp_result_as_string(ret));
+        return 1;
+    }
+
+    ImportedIndex &imported = ImportedIndex::instance();
+    EXPECT(imported.open(root + "/imported_index.bin"), "ImportedIndex open failed");
+
+    std::vector<BulkImportItem> items;
+    CameraList *list = nullptr;
+    gp_list_new(&list);
+    ret = gp_camera_folder_list_files(camera, "/", list, context);
+    EXPECT(ret >= GP_OK, "folder_list_files: %s", gp_result_as_string(ret));
+    for (int i = 0; ret >= GP_OK && i < gp_list_count(list); i++) {
+        const char *name = nullptr;
+        gp_list_get_name(list, i, &name);
+        BulkImportItem item;
+        item.folder = "/";
+        item.name = name;
+        item.localDir = out;
+        CameraFileInfo info;
+        if (gp_camera_file_get_info(camera, "/", name, &info, context) >= GP_OK &&
+            (info.file.fields & GP_FILE_INFO_SIZE)) {
+            item.sizeHint = info.file.size;
+        }
+        items.push_back(item);
+    }
+    gp_list_free(list);
+    EXPECT(items.size() == files.size(), "listed %zu files, expected %zu", items.size(),
+           files.size());
+
+    auto fetch = [camera, context](const BulkImportItem &item, CameraFile *file) {
+        return gp_camera_file_get(camera, item.folder.c_str(), item.name.c_str(),
+                                  GP_FILE_TYPE_NORMAL, file, context);
+    };
+    std::map<std::string, std::string> stored;    // 카메라 이름 -> 저장 경로
+    auto onDone = [&](const BulkImportItem &item, const BulkImportResult &r) {
+        EXPECT(r.result >= GP_OK, "%s: %s", item.name.c_str(), gp_result_as_string(r.result));
+        if (r.result < GP_OK) return;
+        const std::string &source = files[item.name];
+        const std::string hex = fastHexOf(source);
+        EXPECT(r.digest.fastHex() == hex, "%s: digest %s != %s", item.name.c_str(),
+               r.digest.fastHex().c_str(), hex.c_str());
+        EXPECT(r.localPath == out + "/photo_" + hex + ".jpg", "%s: stored as %s",
+               item.name.c_str(), r.localPath.c_str());
+        EXPECT(r.bytes == source.size(), "%s: %llu bytes != %zu", item.name.c_str(),
+               (unsigned long long) r.bytes, source.size());
+        std::string data;
+        EXPECT(readFile(r.localPath, data) && data == source, "%s: stored content differs",
+               item.name.c_str());
+        imported.markImported(SERIAL, item.folder.c_str(), item.name.c_str(), item.sizeHint, 0);
+        stored[item.name] = r.localPath;
+    };
+    auto shouldAbort = [](int r) { return r == GP_ERROR_CANCEL; };
+
+    std::atomic_bool cancel{false};
+    BulkImportStats stats;
+    ret = runBulkImport(items, BUDGET_BYTES, fetch, onDone, shouldAbort, cancel, stats);
+    printf("bulk_import_test: %s\n", stats.toJson().c_str());
+
+    EXPECT(ret >= GP_OK, "runBulkImport: %s", gp_result_as_string(ret));
+    EXPECT(stats.files == (int) files.size() && stats.failed == 0, "files %d failed %d",
+           stats.files, stats.failed);
+    EXPECT(stats.duplicates == 1, "duplicates %d != 1", stats.duplicates);
+    EXPECT(stored["IMG_0003.JPG"] == stored["IMG_0101.JPG"], "same content stored twice");
+    EXPECT(stats.peakBufferedBytes <= std::max(BUDGET_BYTES, largest),
+           "peak buffered %llu over budget %llu (largest %llu)",
+           (unsigned long long) stats.peakBufferedBytes, (unsigned long long) BUDGET_BYTES,
+           (unsigned long long) largest);
+
+    for (const BulkImportItem &item: items) {
+        ImportedIndex::Status status = imported.lookup(SERIAL, "/", item.name.c_str(),
+                                                       item.sizeHint, 0);
+        EXPECT(status == ImportedIndex::IMPORTED, "%s: index status %d", item.name.c_str(),
+               (int) status);
+        status = imported.lookup(SERIAL, "/", item.name.c_str(), item.sizeHint + 1, 0);
+        EXPECT(status == ImportedIndex::CHANGED, "%s: resized file status %d",
+               item.name.c_str(), (int) status);
+    }
+    EXPECT(imported.count() == files.size(), "index count %llu",
+           (unsigned long long) imported.count());
+    imported.close();
+
+    gp_camera_exit(camera, context);
+    gp_camera_free(camera);
+    gp_context_unref(context);
+
+    const std::string cleanup = "rm -rf '" + root + "'";
+    if (system(cleanup.c_str()) != 0) fprintf(stderr, "%s 를 지우지 못함\n", root.c_str());
+
+    if (failures > 0) {
+        fprintf(stderr, "bulk_import_test: %d 실패\n", failures);
+        return 1;
+    }
+    printf("bulk_import_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,200 @@
+// app/src/test/cpp/liveview_analysis_test.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "jpeg-util.h"
+#include "liveview-analysis.h"
+
+// ----------------------------------------------------------------------------
+// 라이브뷰 분석 커널 호스트 테스트
+//  - liveViewAnalyzeRow / liveViewSobelRow 의 SIMD 경로(x86 SSSE3/SSE2, arm64 NEON)가
+//    여기 적은 스칼라 기준과 비트 단위로 같은지 (폭은 벡터 폭의 앞뒤 꼬리까지)
+//  - analyzeBoth (한 번 디코드) 가 따로 부른 결과와 맞는지
+// ----------------------------------------------------------------------------
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        failures++; \
+    } \
+} while (0)
+
+static void referenceAnalyzeRow(const uint8_t *rgb, size_t n, uint8_t *luma, uint8_t *flags) {
+    for (size_t i = 0; i < n; i++) {
+        int r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+        int y = (77 * r + 150 * g + 29 * b + 128) >> 8;
+        luma[i] = (uint8_t) y;
+        flags[i] = (uint8_t) ((std::max(r, std::max(g, b)) >= LIVEVIEW_CLIP_HIGH
+                               ? LIVEVIEW_CLIP_HIGHLIGHT : 0) |
+                              (y <= LIVEVIEW_CLIP_LOW ? LIVEVIEW_CLIP_SHADOW : 0));
+    }
+}
+
+static int referenceSobelRow(const uint8_t *a, const uint8_t *b, const uint8_t *c, int width,
+                             int threshold, int16_t *magnitude, uint8_t *mask) {
+    const int thr = std::min(std::max(threshold, 1), 2041);
+    int peaks = 0;
+    for (int x = 0; x < width; x++) {
+        int m = 0;
+        if (x > 0 && x + 1 < width) {
+            int gx = (a[x + 1] + 2 * b[x + 1] + c[x + 1]) - (a[x - 1] + 2 * b[x - 1] + c[x - 1]);
+            int gy = (c[x - 1] + 2 * c[x] + c[x + 1]) - (a[x - 1] + 2 * a[x] + a[x + 1]);
+            m = std::abs(gx) + std::abs(gy);
+        }
+        magnitude[x] = (int16_t) m;
+        mask[x] = x > 0 && x + 1 < width && m >= thr ? 255 : 0;
+        peaks += mask[x] != 0;
+    }
+    return peaks;
+}
+
+// 0: 난수, 1: 포화 (0/255 만), 2: 클리핑 경계 근처
+static void fill(std::vector<uint8_t> &v, int pattern) {
+    for (uint8_t &x: v) {
+        switch (pattern) {
+            case 0: x = (uint8_t) (rand() & 255); break;
+            case 1: x = (rand() & 1) ? 255 : 0; break;
+            default: {
+                static const uint8_t edge[] = {0, 4, 5, 6, 249, 250, 251, 255};
+                x = edge[rand() & 7];
+            }
+        }
+    }
+}
+
+static void testAnalyzeRow() {
+    std::vector<size_t> widths;
+    for (size_t n = 0; n <= 80; n++) widths.push_back(n);
+    widths.push_back(640);
+    widths.push_back(1001);
+
+    for (size_t n: widths) {
+        for (int pattern = 0; pattern < 3; pattern++) {
+            // 끝을 넘어 읽거나 쓰지 않는지 보려고 정확한 크기로 잡는다
+            std::vector<uint8_t> rgb(n * 3);
+            fill(rgb, pattern);
+            std::vector<uint8_t> luma(n), flags(n), refLuma(n), refFlags(n);
+            liveViewAnalyzeRow(rgb.data(), n, luma.data(), flags.data());
+            referenceAnalyzeRow(rgb.data(), n, refLuma.data(), refFlags.data());
+            for (size_t i = 0; i < n; i++) {
+                EXPECT(luma[i] == refLuma[i], "analyzeRow n=%zu i=%zu luma %d != %d", n, i,
+                       luma[i], refLuma[i]);
+                EXPECT(flags[i] == refFlags[i], "analyzeRow n=%zu i=%zu flags %d != %d", n, i,
+                       flags[i], refFlags[i]);
+            }
+        }
+    }
+}
+
+static void testSobelRow() {
+    const int thresholds[] = {-5, 0, 1, 160, 1020, 2040, 2041, 5000};
+    std::vector<int> widths;
+    for (int w = 0; w <= 80; w++) widths.push_back(w);
+    widths.push_back(1280);
+    widths.push_back(1921);
+
+    for (int w: widths) {
+        for (int pattern = 0; pattern < 3; pattern++) {
+            std::vector<uint8_t> rows((size_t) w * 3);
+            fill(rows, pattern);
+            const uint8_t *a = rows.data(), *b = a + w, *c = b + w;
+            for (int thr: thresholds) {
+                std::vector<int16_t> mag(w), refMag(w);
+                std::vector<uint8_t> mask(w), refMask(w);
+                int peaks = liveViewSobelRow(a, b, c, w, thr, mag.data(), mask.data());
+                int refPeaks = referenceSobelRow(a, b, c, w, thr, refMag.data(), refMask.data());
+                EXPECT(peaks == refPeaks, "sobelRow w=%d thr=%d peaks %d != %d", w, thr, peaks,
+                       refPeaks);
+                for (int x = 0; x < w; x++) {
+                    EXPECT(mag[x] == refMag[x], "sobelRow w=%d thr=%d x=%d magnitude %d != %d", w,
+                           thr, x, mag[x], refMag[x]);
+                    EXPECT(mask[x] == refMask[x], "sobelRow w=%d thr=%d x=%d mask %d != %d", w,
+                           thr, x, mask[x], refMask[x]);
+                }
+            }
+        }
+    }
+}
+
+// 경계가 많은 합성 프레임 (체커 + 그라디언트, 한쪽은 하이라이트 클리핑)
+static bool makeFrame(int width, int height, std::vector<uint8_t> &jpeg) {
+    JpegImage img;
+    img.width = width;
+    img.height = height;
+    img.pixels.resize((size_t) width * height * 3);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t *px = img.pixels.data() + ((size_t) y * width + x) * 3;
+            bool check = ((x / 40) + (y / 40)) & 1;
+            px[0] = x > width * 3 / 4 ? 255 : (uint8_t) (check ? 220 : 30);
+            px[1] = (uint8_t) (x * 255 / width);
+            px[2] = (uint8_t) (y * 255 / height);
+        }
+    }
+    return jpegEncodeRgb(img, 90, jpeg);
+}
+
+static void testAnalyzeBoth() {
+    std::vector<uint8_t> jpeg;
+    EXPECT(makeFrame(1600, 1200, jpeg), "jpegEncodeRgb failed");
+    if (jpeg.empty()) return;
+
+    const int threshold = LIVEVIEW_PEAKING_DEFAULT_THRESHOLD;
+    LiveViewAnalyzer separate, shared;
+    LiveViewHistogram hist{}, sharedHist{};
+    LiveViewFocus focus{}, sharedFocus{};
+    EXPECT(separate.analyze(jpeg.data(), jpeg.size(), hist), "analyze failed");
+    EXPECT(separate.analyzeFocus(jpeg.data(), jpeg.size(), threshold, focus),
+           "analyzeFocus failed");
+    EXPECT(shared.analyzeBoth(jpeg.data(), jpeg.size(), threshold, sharedHist, sharedFocus),
+           "analyzeBoth failed");
+
+    // 한 번 디코드: 히스토그램도 초점 해상도로
+    EXPECT(sharedFocus.width == focus.width && sharedFocus.height == focus.height,
+           "focus size %dx%d != %dx%d", sharedFocus.width, sharedFocus.height, focus.width,
+           focus.height);
+    EXPECT(sharedHist.width == sharedFocus.width && sharedHist.height == sharedFocus.height,
+           "histogram %dx%d != focus %dx%d", sharedHist.width, sharedHist.height,
+           sharedFocus.width, sharedFocus.height);
+    for (int c = 0; c < 4; c++) {
+        uint32_t total = 0;
+        for (int v = 0; v < LIVEVIEW_HIST_BINS; v++) total += sharedHist.bins[c * LIVEVIEW_HIST_BINS + v];
+        EXPECT(total == sharedHist.pixels, "channel %d total %u != %u", c, total, sharedHist.pixels);
+    }
+
+    // 클리핑 비율은 해상도와 무관하게 비슷해야 한다
+    double ratio = (double) hist.highlightPixels / hist.pixels;
+    double sharedRatio = (double) sharedHist.highlightPixels / sharedHist.pixels;
+    EXPECT(std::fabs(ratio - sharedRatio) < 0.01, "highlight ratio %.4f vs %.4f", ratio,
+           sharedRatio);
+
+    // RGB 에서 구한 휘도와 JPEG Y 는 반올림만 다르다
+    EXPECT(std::fabs(sharedFocus.sharpness - focus.sharpness) <= 0.05f * focus.sharpness,
+           "sharpness %.2f vs %.2f", sharedFocus.sharpness, focus.sharpness);
+
+    uint32_t marked = 0;
+    for (uint8_t m: shared.peakMask()) marked += m == 255;
+    EXPECT(marked == sharedFocus.peakPixels, "mask %u != peakPixels %u", marked,
+           sharedFocus.peakPixels);
+}
+
+int main() {
+    srand(1);
+    testAnalyzeRow();
+    testSobelRow();
+    testAnalyzeBoth();
+    if (failures > 0) {
+        fprintf(stderr, "liveview_analysis_test: %d 실패\n", failures);
+        return 1;
+    }
+    printf("liveview_analysis_test: OK\n");
+    return 0;
+}
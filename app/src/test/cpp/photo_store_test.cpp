@@ -0,0 +1,137 @@
+// app/src/test/cpp/photo_store_test.cpp
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "imported-index.h"
+#include "photo-store.h"
+
+// ----------------------------------------------------------------------------
+// PhotoStore 축출과 ImportedIndex 기록 지우기 호스트 테스트
+//  - forget 의 backward shift 뒤에도 남은 키를 모두 찾는지 (충돌 묶음 포함)
+//  - 예산을 넘겨 지운 사진은 ImportedIndex 에서도 빠져 NEW 로 보이는지
+//    (인덱스를 다시 읽은 뒤에도 origin 이 남는지)
+// ----------------------------------------------------------------------------
+
+static int failures = 0;
+
+#define EXPECT(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        failures++; \
+    } \
+} while (0)
+
+static const char SERIAL[] = "host-test";
+static const uint64_t PHOTO_BYTES = 1000;
+
+static std::string cameraName(int i) {
+    char name[32];
+    snprintf(name, sizeof(name), "IMG_%04d.JPG", i);
+    return name;
+}
+
+static bool exists(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+static void testForget(ImportedIndex &index) {
+    const int n = 2000;     // 4096 슬롯의 절반 가까이: 탐사 묶음이 생긴다
+    for (int i = 0; i < n; i++) {
+        index.markImported(SERIAL, "/forget", cameraName(i).c_str(), 1, 0);
+    }
+    for (int i = 0; i < n; i += 2) {
+        EXPECT(index.forget(ImportedIndex::keyOf(SERIAL, "/forget", cameraName(i).c_str())),
+               "forget %d", i);
+    }
+    EXPECT(!index.forget(ImportedIndex::keyOf(SERIAL, "/forget", cameraName(0).c_str())),
+           "forget twice");
+    for (int i = 0; i < n; i++) {
+        ImportedIndex::Status status = index.lookup(SERIAL, "/forget", cameraName(i).c_str(), 1, 0);
+        ImportedIndex::Status expected = i % 2 ? ImportedIndex::IMPORTED : ImportedIndex::NEW;
+        EXPECT(status == expected, "%d: status %d != %d", i, (int) status, (int) expected);
+    }
+    EXPECT(index.count() == (uint64_t) n / 2, "count %llu", (unsigned long long) index.count());
+}
+
+// 카메라 파일 i 를 가져온 것처럼: 저장 + 저장소 등록 + 가져오기 기록 + origin
+static void importPhoto(ImportedIndex &index, const std::string &dir, int i) {
+    const std::string name = cameraName(i);
+    char local[64];
+    snprintf(local, sizeof(local), "/photo_%016x.jpg", i + 1);
+    const std::string path = dir + local;
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp) {
+        std::string data(PHOTO_BYTES, (char) i);
+        fwrite(data.data(), 1, data.size(), fp);
+        fclose(fp);
+    }
+    PhotoStore &store = PhotoStore::instance();
+    store.add(path, PHOTO_BYTES);
+    index.markImported(SERIAL, "/DCIM", name.c_str(), PHOTO_BYTES, 0);
+    EXPECT(store.setOrigin(path, ImportedIndex::keyOf(SERIAL, "/DCIM", name.c_str())),
+           "setOrigin %d", i);
+}
+
+static void testEviction(ImportedIndex &index, const std::string &dir, const std::string &other) {
+    PhotoStore &store = PhotoStore::instance();
+    store.open(dir);
+    store.setLimits(3 * PHOTO_BYTES, false);
+    EXPECT(store.statsJson().find("\"pinNewFiles\":false") != std::string::npos,
+           "new files pinned: %s", store.statsJson().c_str());
+
+    for (int i = 0; i < 3; i++) importPhoto(index, dir, i);
+    // 인덱스를 다시 읽어도 origin 이 남아야 한다
+    store.flush();
+    store.open(other);
+    store.open(dir);
+
+    importPhoto(index, dir, 3);
+    importPhoto(index, dir, 4);
+
+    for (int i = 0; i < 5; i++) {
+        char local[64];
+        snprintf(local, sizeof(local), "/photo_%016x.jpg", i + 1);
+        bool evicted = i < 2;
+        EXPECT(exists(dir + local) != evicted, "%d: file %s", i, evicted ? "kept" : "removed");
+        ImportedIndex::Status status = index.lookup(SERIAL, "/DCIM", cameraName(i).c_str(),
+                                                    PHOTO_BYTES, 0);
+        ImportedIndex::Status expected = evicted ? ImportedIndex::NEW : ImportedIndex::IMPORTED;
+        EXPECT(status == expected, "%d: index status %d != %d", i, (int) status, (int) expected);
+    }
+}
+
+int main() {
+    char pattern[] = "/tmp/photo_store_test.XXXXXX";
+    if (!mkdtemp(pattern)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string root = pattern;
+    const std::string dir = root + "/files";
+    const std::string other = root + "/other";
+    mkdir(dir.c_str(), 0700);
+    mkdir(other.c_str(), 0700);
+
+    ImportedIndex &index = ImportedIndex::instance();
+    EXPECT(index.open(root + "/imported_index.bin"), "ImportedIndex open failed");
+    testForget(index);
+    testEviction(index, dir, other);
+    index.close();
+
+    const std::string cleanup = "rm -rf '" + root + "'";
+    if (system(cleanup.c_str()) != 0) fprintf(stderr, "%s 를 지우지 못함\n", root.c_str());
+
+    if (failures > 0) {
+        fprintf(stderr, "photo_store_test: %d 실패\n", failures);
+        return 1;
+    }
+    printf("photo_store_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+// app/src/test/cpp/share_export_bench.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <gphoto2/gphoto2-result.h>
+
+#include "jpeg-util.h"
+#include "photo-export.h"
+
+// ----------------------------------------------------------------------------
+// 공유용 축소본 벤치마크
+//   share_export_bench [반복 수] [원본.jpg]
+//  - 원본을 안 주면 6000x4000 (24MP) 합성 JPEG 을 임시 디렉터리에 만들어 쓴다
+//  - exportSharePhoto 한 장씩 반복한 시간 (최소/중앙/최대). 단계별 시간
+//    (decode/resize/encode) 은 shareExport 로그로 stderr 에 나온다
+//  - 끝에 exportSharePhotos 로 4 장 묶음 (CPU 풀)
+//  - 중앙값이 목표(150ms)를 넘는지 함께 찍는다
+// ----------------------------------------------------------------------------
+
+// photo-export.h 의 장당 목표 (넘어도 실패로 치지 않고 그대로 보고만 한다)
+#define SHARE_EXPORT_TARGET_MS 150.0
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+// 카메라 원본처럼 잡음과 경계가 섞인 프레임 (평평하면 디코드가 비현실적으로 빠르다)
+static bool writeSyntheticPhoto(const std::string &path, int width, int height) {
+    JpegImage img;
+    img.width = width;
+    img.height = height;
+    img.pixels.resize((size_t) width * height * 3);
+    uint32_t seed = 12345;
+    for (int y = 0; y < height; y++) {
+        uint8_t *row = img.pixels.data() + (size_t) y * width * 3;
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            int noise = (int) (seed >> 27) - 16;
+            bool check = ((x / 97) + (y / 61)) & 1;
+            row[x * 3] = (uint8_t) std::min(255, std::max(0, x * 255 / width + noise));
+            row[x * 3 + 1] = (uint8_t) std::min(255, std::max(0, (check ? 180 : 70) + noise));
+            row[x * 3 + 2] = (uint8_t) std::min(255, std::max(0, y * 255 / height + noise));
+        }
+    }
+    std::vector<uint8_t> jpeg;
+    if (!jpegEncodeRgb(img, 92, jpeg)) return false;
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(jpeg.data(), 1, jpeg.size(), fp) == jpeg.size();
+    return fclose(fp) == 0 && ok;
+}
+
+int main(int argc, char **argv) {
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 5;
+    std::string photo;
+    std::string tmpDir;
+    if (argc > 2) {
+        photo = argv[2];
+    } else {
+        char pattern[] = "/tmp/share_export_bench.XXXXXX";
+        if (!mkdtemp(pattern)) {
+            perror("mkdtemp");
+            return 1;
+        }
+        tmpDir = pattern;
+        photo = tmpDir + "/photo_bench.jpg";
+        if (!writeSyntheticPhoto(photo, 6000, 4000)) {
+            fprintf(stderr, "합성 원본을 만들지 못함\n");
+            return 1;
+        }
+    }
+
+    std::vector<double> times;
+    std::string outPath;
+    for (int i = 0; i < iterations; i++) {
+        Clock::time_point t = Clock::now();
+        int ret = exportSharePhoto(photo, SHARE_EXPORT_DEFAULT_MEGAPIXELS,
+                                   SHARE_EXPORT_DEFAULT_QUALITY, outPath);
+        times.push_back(msSince(t));
+        if (ret < GP_OK) {
+            fprintf(stderr, "exportSharePhoto: %d\n", ret);
+            return 1;
+        }
+    }
+    std::sort(times.begin(), times.end());
+    printf("exportSharePhoto x%d: min %.1f ms, median %.1f ms, max %.1f ms\n", iterations,
+           times.front(), times[times.size() / 2], times.back());
+    printf("목표 %.0f ms: %s\n", SHARE_EXPORT_TARGET_MS,
+           times[times.size() / 2] <= SHARE_EXPORT_TARGET_MS ? "충족" : "초과 (중앙값 기준)");
+
+    std::vector<std::string> batch(4, photo);
+    Clock::time_point t = Clock::now();
+    std::vector<std::string> outs = exportSharePhotos(batch, SHARE_EXPORT_DEFAULT_MEGAPIXELS,
+                                                      SHARE_EXPORT_DEFAULT_QUALITY);
+    const double batchMs = msSince(t);
+    bool ok = std::none_of(outs.begin(), outs.end(),
+                           [](const std::string &p) { return p.empty(); });
+    printf("exportSharePhotos x4: %.1f ms%s\n", batchMs, ok ? "" : " (실패 있음)");
+
+    if (!tmpDir.empty()) {
+        remove(photoSharePath(photo).c_str());
+        remove(photo.c_str());
+        rmdir(tmpDir.c_str());
+    }
+    return ok ? 0 : 1;
+}
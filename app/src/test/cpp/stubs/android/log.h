@@ -0,0 +1,29 @@
+// app/src/test/cpp/stubs/android/log.h
+
+#ifndef TEST_ANDROID_LOG_H
+#define TEST_ANDROID_LOG_H
+
+#include <cstdarg>
+#include <cstdio>
+
+// ----------------------------------------------------------------------------
+// 호스트 테스트용 android/log.h: 로그를 stderr 로
+// ----------------------------------------------------------------------------
+enum {
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_INFO = 4,
+    ANDROID_LOG_WARN = 5,
+    ANDROID_LOG_ERROR = 6,
+};
+
+static inline int __android_log_print(int, const char *tag, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s: ", tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return 0;
+}
+
+#endif // TEST_ANDROID_LOG_H
@@ -0,0 +1,11 @@
+// app/src/test/cpp/stubs/exif-parse-none.cpp
+
+#include "exif-index.h"
+
+// ----------------------------------------------------------------------------
+// 호스트에 libexif 가 없을 때 photo-export 를 링크하기 위한 대체.
+// EXIF 가 없는 파일과 같게 동작 (orientation 을 돌리지 않음)
+// ----------------------------------------------------------------------------
+bool exifParse(const uint8_t *, size_t, ExifInfo &) {
+    return false;
+}
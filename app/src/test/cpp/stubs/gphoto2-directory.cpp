@@ -0,0 +1,322 @@
+// app/src/test/cpp/stubs/gphoto2-directory.cpp
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include <gphoto2/gphoto2.h>
+
+// ----------------------------------------------------------------------------
+// 호스트에 libgphoto2 가 없을 때 bulk_import_test 를 링크하기 위한 대체.
+// 테스트가 쓰는 만큼만: "Directory Browse" 카메라 하나를 disk:<경로> 로 열어
+//  - 폴더 목록 = 그 디렉터리의 일반 파일 (이름순), 크기 정보 = stat
+//  - gp_camera_file_get 은 파일 전체를 메모리 CameraFile 에 담거나,
+//    handler 로 만든 CameraFile 이면 write 콜백으로 잘라서 넘긴다
+// 실제 directory camlib + disk iolib 과 같은 결과 코드를 돌려준다
+// ----------------------------------------------------------------------------
+
+#define DIRECTORY_MODEL "Directory Browse"
+#define DIRECTORY_PORT_PREFIX "disk:"
+#define DIRECTORY_READ_CHUNK (64 * 1024)
+
+struct _CameraPrivateCore {
+    std::string portPath;   // GPPortInfo 에서 받은 경로 (init 전)
+    std::string dir;        // init 뒤의 카드 디렉터리
+    bool hasModel = false;
+};
+
+struct _GPPortInfo {
+    std::string path;
+};
+
+struct _GPPortInfoList {
+    std::vector<_GPPortInfo> infos;
+};
+
+struct _CameraAbilitiesList {
+    bool loaded = false;
+};
+
+struct _CameraList {
+    std::vector<std::string> names;
+};
+
+struct _CameraFile {
+    std::string data;
+    CameraFileHandler *handler = nullptr;
+    void *priv = nullptr;
+    int refs = 1;
+};
+
+struct _GPContext {
+    int refs = 1;
+};
+
+namespace {
+
+bool dirPath(Camera *camera, const char *folder, std::string &out) {
+    if (!camera || !camera->pc || camera->pc->dir.empty() || !folder || folder[0] != '/') {
+        return false;
+    }
+    out = camera->pc->dir + (strcmp(folder, "/") == 0 ? "" : folder);
+    return true;
+}
+
+} // namespace
+
+extern "C" {
+
+// --- 카메라 -------------------------------------------------------------------
+int gp_camera_new(Camera **camera) {
+    if (!camera) return GP_ERROR_BAD_PARAMETERS;
+    *camera = new Camera();
+    (*camera)->pc = new _CameraPrivateCore();
+    return GP_OK;
+}
+
+int gp_camera_free(Camera *camera) {
+    if (!camera) return GP_ERROR_BAD_PARAMETERS;
+    delete camera->pc;
+    delete camera;
+    return GP_OK;
+}
+
+int gp_camera_set_abilities(Camera *camera, CameraAbilities abilities) {
+    if (!camera) return GP_ERROR_BAD_PARAMETERS;
+    camera->pc->hasModel = strcmp(abilities.model, DIRECTORY_MODEL) == 0;
+    return camera->pc->hasModel ? GP_OK : GP_ERROR_MODEL_NOT_FOUND;
+}
+
+int gp_camera_set_port_info(Camera *camera, GPPortInfo info) {
+    if (!camera || !info) return GP_ERROR_BAD_PARAMETERS;
+    camera->pc->portPath = info->path;
+    return GP_OK;
+}
+
+int gp_camera_init(Camera *camera, GPContext *) {
+    if (!camera) return GP_ERROR_BAD_PARAMETERS;
+    if (!camera->pc->hasModel) return GP_ERROR_MODEL_NOT_FOUND;
+    const std::string &path = camera->pc->portPath;
+    const size_t prefix = strlen(DIRECTORY_PORT_PREFIX);
+    if (path.compare(0, prefix, DIRECTORY_PORT_PREFIX) != 0) return GP_ERROR_UNKNOWN_PORT;
+    struct stat st;
+    const std::string dir = path.substr(prefix);
+    if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return GP_ERROR_DIRECTORY_NOT_FOUND;
+    camera->pc->dir = dir;
+    return GP_OK;
+}
+
+int gp_camera_exit(Camera *camera, GPContext *) {
+    if (!camera) return GP_ERROR_BAD_PARAMETERS;
+    camera->pc->dir.clear();
+    return GP_OK;
+}
+
+int gp_camera_folder_list_files(Camera *camera, const char *folder, CameraList *list,
+                                GPContext *) {
+    std::string dir;
+    if (!list || !dirPath(camera, folder, dir)) return GP_ERROR_BAD_PARAMETERS;
+    DIR *d = opendir(dir.c_str());
+    if (!d) return GP_ERROR_DIRECTORY_NOT_FOUND;
+    list->names.clear();
+    while (dirent *e = readdir(d)) {
+        struct stat st;
+        if (e->d_name[0] == '.') continue;
+        if (stat((dir + "/" + e->d_name).c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            list->names.push_back(e->d_name);
+        }
+    }
+    closedir(d);
+    std::sort(list->names.begin(), list->names.end());
+    return GP_OK;
+}
+
+int gp_camera_file_get_info(Camera *camera, const char *folder, const char *file,
+                            CameraFileInfo *info, GPContext *) {
+    std::string dir;
+    if (!file || !info || !dirPath(camera, folder, dir)) return GP_ERROR_BAD_PARAMETERS;
+    struct stat st;
+    if (stat((dir + "/" + file).c_str(), &st) != 0) return GP_ERROR_FILE_NOT_FOUND;
+    memset(info, 0, sizeof(*info));
+    info->file.fields = (CameraFileInfoFields) (GP_FILE_INFO_SIZE | GP_FILE_INFO_MTIME);
+    info->file.size = (uint64_t) st.st_size;
+    info->file.mtime = st.st_mtime;
+    return GP_OK;
+}
+
+int gp_camera_file_get(Camera *camera, const char *folder, const char *file, CameraFileType type,
+                       CameraFile *camera_file, GPContext *) {
+    std::string dir;
+    if (!file || !camera_file || !dirPath(camera, folder, dir)) return GP_ERROR_BAD_PARAMETERS;
+    if (type != GP_FILE_TYPE_NORMAL) return GP_ERROR_NOT_SUPPORTED;
+    FILE *fp = fopen((dir + "/" + file).c_str(), "rb");
+    if (!fp) return GP_ERROR_FILE_NOT_FOUND;
+
+    int ret = GP_OK;
+    camera_file->data.clear();
+    unsigned char buf[DIRECTORY_READ_CHUNK];
+    size_t n;
+    while (ret >= GP_OK && (n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        if (camera_file->handler) {
+            uint64_t len = n;
+            ret = camera_file->handler->write(camera_file->priv, buf, &len);
+        } else {
+            camera_file->data.append((const char *) buf, n);
+        }
+    }
+    if (ret >= GP_OK && ferror(fp)) ret = GP_ERROR_IO_READ;
+    fclose(fp);
+    return ret;
+}
+
+// --- abilities / 포트 ---------------------------------------------------------
+int gp_abilities_list_new(CameraAbilitiesList **list) {
+    if (!list) return GP_ERROR_BAD_PARAMETERS;
+    *list = new CameraAbilitiesList();
+    return GP_OK;
+}
+
+int gp_abilities_list_free(CameraAbilitiesList *list) {
+    delete list;
+    return GP_OK;
+}
+
+int gp_abilities_list_load(CameraAbilitiesList *list, GPContext *) {
+    if (!list) return GP_ERROR_BAD_PARAMETERS;
+    list->loaded = true;
+    return GP_OK;
+}
+
+int gp_abilities_list_lookup_model(CameraAbilitiesList *list, const char *model) {
+    if (!list || !model) return GP_ERROR_BAD_PARAMETERS;
+    return list->loaded && strcmp(model, DIRECTORY_MODEL) == 0 ? 0 : GP_ERROR_MODEL_NOT_FOUND;
+}
+
+int gp_abilities_list_get_abilities(CameraAbilitiesList *list, int index,
+                                    CameraAbilities *abilities) {
+    if (!list || !abilities || !list->loaded || index != 0) return GP_ERROR_BAD_PARAMETERS;
+    memset(abilities, 0, sizeof(*abilities));
+    snprintf(abilities->model, sizeof(abilities->model), "%s", DIRECTORY_MODEL);
+    snprintf(abilities->id, sizeof(abilities->id), "directory");
+    abilities->port = GP_PORT_DISK;
+    abilities->file_operations = GP_FILE_OPERATION_NONE;
+    return GP_OK;
+}
+
+int gp_port_info_list_new(GPPortInfoList **list) {
+    if (!list) return GP_ERROR_BAD_PARAMETERS;
+    *list = new GPPortInfoList();
+    return GP_OK;
+}
+
+int gp_port_info_list_free(GPPortInfoList *list) {
+    delete list;
+    return GP_OK;
+}
+
+int gp_port_info_list_load(GPPortInfoList *list) {
+    return list ? GP_OK : GP_ERROR_BAD_PARAMETERS;
+}
+
+// disk iolib 의 "^disk:" 일반 항목처럼 경로마다 항목을 하나 만들어 준다
+int gp_port_info_list_lookup_path(GPPortInfoList *list, const char *path) {
+    if (!list || !path) return GP_ERROR_BAD_PARAMETERS;
+    if (strncmp(path, DIRECTORY_PORT_PREFIX, strlen(DIRECTORY_PORT_PREFIX)) != 0) {
+        return GP_ERROR_UNKNOWN_PORT;
+    }
+    _GPPortInfo info;
+    info.path = path;
+    list->infos.push_back(info);
+    return (int) list->infos.size() - 1;
+}
+
+int gp_port_info_list_get_info(GPPortInfoList *list, int n, GPPortInfo *info) {
+    if (!list || !info || n < 0 || n >= (int) list->infos.size()) return GP_ERROR_BAD_PARAMETERS;
+    *info = &list->infos[n];
+    return GP_OK;
+}
+
+// --- 목록 / 파일 / 컨텍스트 --------------------------------------------------
+int gp_list_new(CameraList **list) {
+    if (!list) return GP_ERROR_BAD_PARAMETERS;
+    *list = new CameraList();
+    return GP_OK;
+}
+
+int gp_list_free(CameraList *list) {
+    delete list;
+    return GP_OK;
+}
+
+int gp_list_count(CameraList *list) {
+    return list ? (int) list->names.size() : GP_ERROR_BAD_PARAMETERS;
+}
+
+int gp_list_get_name(CameraList *list, int index, const char **name) {
+    if (!list || !name || index < 0 || index >= (int) list->names.size()) {
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+    *name = list->names[index].c_str();
+    return GP_OK;
+}
+
+int gp_file_new(CameraFile **file) {
+    if (!file) return GP_ERROR_BAD_PARAMETERS;
+    *file = new CameraFile();
+    return GP_OK;
+}
+
+int gp_file_new_from_handler(CameraFile **file, CameraFileHandler *handler, void *priv) {
+    if (!file || !handler || !handler->write) return GP_ERROR_BAD_PARAMETERS;
+    *file = new CameraFile();
+    (*file)->handler = handler;
+    (*file)->priv = priv;
+    return GP_OK;
+}
+
+int gp_file_unref(CameraFile *file) {
+    if (!file) return GP_ERROR_BAD_PARAMETERS;
+    if (--file->refs == 0) delete file;
+    return GP_OK;
+}
+
+int gp_file_free(CameraFile *file) {
+    delete file;
+    return GP_OK;
+}
+
+int gp_file_get_data_and_size(CameraFile *file, const char **data, unsigned long int *size) {
+    if (!file || file->handler) return GP_ERROR_BAD_PARAMETERS;
+    if (data) *data = file->data.data();
+    if (size) *size = file->data.size();
+    return GP_OK;
+}
+
+GPContext *gp_context_new(void) {
+    return new GPContext();
+}
+
+void gp_context_unref(GPContext *context) {
+    if (context && --context->refs == 0) delete context;
+}
+
+const char *gp_result_as_string(int result) {
+    switch (result) {
+        case GP_OK: return "No error";
+        case GP_ERROR_BAD_PARAMETERS: return "Bad parameters";
+        case GP_ERROR_NOT_SUPPORTED: return "Unsupported operation";
+        case GP_ERROR_IO_READ: return "I/O problem";
+        case GP_ERROR_UNKNOWN_PORT: return "Unknown port";
+        case GP_ERROR_CANCEL: return "Cancelled operation";
+        case GP_ERROR_MODEL_NOT_FOUND: return "Unknown model";
+        case GP_ERROR_DIRECTORY_NOT_FOUND: return "Directory not found";
+        case GP_ERROR_FILE_NOT_FOUND: return "File not found";
+        default: return "Unknown error";
+    }
+}
+
+} // extern "C"